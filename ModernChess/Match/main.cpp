@@ -0,0 +1,279 @@
+#include "ModernChess/Bench.h"
+#include "ModernChess/Evaluation.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/Match.h"
+#include "ModernChess/NeuralNetwork.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace ModernChess;
+
+namespace
+{
+    constexpr std::string_view BuiltInEvalFile = "<built-in>";
+
+    /**
+     * @return time control of the format "<base time in seconds>[+<increment in seconds>]", e.g. "10+0.1"
+     */
+    TimeControl parseTimeControl(std::string_view value)
+    {
+        const size_t plusPosition = value.find('+');
+        const auto toMilliseconds = [](std::string_view seconds) {
+            return std::chrono::milliseconds(std::llround(std::stod(std::string(seconds)) * 1000));
+        };
+
+        TimeControl timeControl;
+        timeControl.baseTime = toMilliseconds(value.substr(0, plusPosition));
+
+        if (plusPosition != std::string_view::npos)
+        {
+            timeControl.increment = toMilliseconds(value.substr(plusPosition + 1));
+        }
+
+        return timeControl;
+    }
+
+    /**
+     * @brief Applies an option like "name=patch", "hash=16", "nodes=20000", "tc=10+0.1", "nnue=<built-in>",
+     *        "nnue=network.nn" or "NullMovePruningDepthReduction=3"
+     * @throws std::invalid_argument
+     */
+    void applyEngineOption(EngineConfiguration &engine, std::string_view option)
+    {
+        const size_t equalPosition = option.find('=');
+
+        if (equalPosition == std::string_view::npos)
+        {
+            throw std::invalid_argument("Engine option without value: " + std::string(option));
+        }
+
+        const std::string_view key = option.substr(0, equalPosition);
+        const std::string value(option.substr(equalPosition + 1));
+
+        if (key == "name")
+        {
+            engine.name = value;
+        }
+        else if (key == "hash")
+        {
+            engine.hashSizeInMB = std::max<size_t>(std::stoul(value), 1);
+        }
+        else if (key == "nodes")
+        {
+            engine.nodesPerMove = std::stoull(value);
+        }
+        else if (key == "tc")
+        {
+            engine.timeControl = parseTimeControl(value);
+        }
+        else if (key == "nnue")
+        {
+            engine.neuralNetwork = (value == BuiltInEvalFile) ? NeuralNetwork::defaultNetwork() : NeuralNetwork::load(value);
+        }
+        else if (const auto parameter = std::find_if(TunableSearchParameters.begin(), TunableSearchParameters.end(),
+                                                     [key](const TunableSearchParameter &parameter) { return parameter.name == key; });
+                 parameter != TunableSearchParameters.end())
+        {
+            engine.searchParameters.*parameter->value = std::clamp(std::stoi(value), parameter->minimum, parameter->maximum);
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown engine option: " + std::string(key));
+        }
+    }
+
+    /**
+     * @brief Plays two configurations against each other, e.g.
+     *        ./match --engine name=patch NullMovePruningDepthReduction=3 --engine name=base
+     *                --games 2000 --concurrency 8 --nodes 20000 --sprt elo0=0 elo1=5
+     * @return exit code
+     */
+    int runMatch(int argc, char *argv[])
+    {
+        Match::Settings settings;
+        settings.concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+        EngineConfiguration defaultEngine;
+        std::vector<std::vector<std::string_view>> engineOptions;
+        std::string openingsPath;
+
+        for (int argIndex = 1; argIndex < argc; ++argIndex)
+        {
+            const std::string_view argument = argv[argIndex];
+
+            if (argument == "--engine")
+            {
+                engineOptions.emplace_back();
+
+                while (argIndex + 1 < argc and not std::string_view(argv[argIndex + 1]).starts_with("--"))
+                {
+                    engineOptions.back().emplace_back(argv[++argIndex]);
+                }
+            }
+            else if (argument == "--no-adjudication")
+            {
+                settings.adjudication = std::nullopt;
+            }
+            else if (argument == "--sprt")
+            {
+                settings.sprt = Sprt{};
+
+                while (argIndex + 1 < argc and not std::string_view(argv[argIndex + 1]).starts_with("--"))
+                {
+                    const std::string_view option = argv[++argIndex];
+                    const size_t equalPosition = option.find('=');
+                    const std::string_view key = option.substr(0, equalPosition);
+                    const double value = std::stod(std::string(option.substr(equalPosition + 1)));
+
+                    if (key == "elo0") { settings.sprt->elo0 = value; }
+                    else if (key == "elo1") { settings.sprt->elo1 = value; }
+                    else if (key == "alpha") { settings.sprt->alpha = value; }
+                    else if (key == "beta") { settings.sprt->beta = value; }
+                    else
+                    {
+                        std::cout << "Unknown SPRT option " << option << std::endl;
+                        return 2;
+                    }
+                }
+            }
+            else if (argIndex + 1 >= argc)
+            {
+                std::cout << "Missing value of option " << argument << std::endl;
+                return 2;
+            }
+            else if (argument == "--games")
+            {
+                settings.numberOfGames = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else if (argument == "--concurrency")
+            {
+                settings.concurrency = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else if (argument == "--max-plies")
+            {
+                settings.maximumNumberOfPlies = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else if (argument == "--nodes")
+            {
+                defaultEngine.nodesPerMove = std::stoull(argv[++argIndex]);
+            }
+            else if (argument == "--tc")
+            {
+                defaultEngine.timeControl = parseTimeControl(argv[++argIndex]);
+                // A time control without --nodes is not limited by nodes
+                if (std::none_of(argv + 1, argv + argc, [](const char *arg) { return std::string_view(arg) == "--nodes"; }))
+                {
+                    defaultEngine.nodesPerMove = Evaluation::NoNodeLimit;
+                }
+            }
+            else if (argument == "--openings")
+            {
+                openingsPath = argv[++argIndex];
+            }
+            else
+            {
+                std::cout << "Unknown option " << argument << std::endl;
+                return 2;
+            }
+        }
+
+        if (engineOptions.size() != 2)
+        {
+            std::cout << "Pass exactly two engines with --engine" << std::endl;
+            return 2;
+        }
+
+        std::vector<EngineConfiguration> engines(2, defaultEngine);
+        engines[1].name = defaultEngine.name + " 2";
+
+        for (size_t engineIndex = 0; engineIndex < engines.size(); ++engineIndex)
+        {
+            for (const std::string_view option : engineOptions[engineIndex])
+            {
+                applyEngineOption(engines[engineIndex], option);
+            }
+        }
+
+        std::vector<GameState> openings;
+
+        if (openingsPath.empty())
+        {
+            for (const char *fen : Bench::Positions)
+            {
+                openings.push_back(FenParsing::FenParser(fen).parse());
+            }
+        }
+        else
+        {
+            std::ifstream openingsFile(openingsPath);
+
+            if (not openingsFile)
+            {
+                std::cout << "Could not open " << openingsPath << std::endl;
+                return 2;
+            }
+
+            openings = SelfPlay::readOpenings(openingsFile);
+        }
+
+        const std::string title = engines[0].name + " vs " + engines[1].name;
+        Match match(settings, engines[0], engines[1], std::move(openings));
+
+        const MatchResult matchResult = match.run([&](const SelfPlayGame &game, uint32_t gameIndex, const MatchResult &result) {
+            const bool firstPlaysWhite = gameIndex % 2 == 0;
+            const std::string_view gameResult = (game.result == GameResult::Draw) ? "1/2-1/2" :
+                                                (game.result == GameResult::WhiteWins) ? "1-0" : "0-1";
+
+            std::cout << "Game " << gameIndex + 1 << ": "
+                      << (firstPlaysWhite ? engines[0].name : engines[1].name) << " vs "
+                      << (firstPlaysWhite ? engines[1].name : engines[0].name) << " " << gameResult
+                      << " (" << game.termination << ", " << game.moves.size() << " plies)  "
+                      << title << " " << result << std::endl;
+        });
+
+        std::cout << "\n" << title << " after " << matchResult.numberOfGames() << " games: " << matchResult << std::endl;
+
+        if (settings.sprt)
+        {
+            std::cout << "SPRT elo0=" << settings.sprt->elo0 << " elo1=" << settings.sprt->elo1
+                      << ": LLR " << matchResult.logLikelihoodRatio(settings.sprt->elo0, settings.sprt->elo1)
+                      << " [" << settings.sprt->lowerBound() << ", " << settings.sprt->upperBound() << "] "
+                      << settings.sprt->status(matchResult) << std::endl;
+        }
+
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        std::cout << "Plays two configurations of the engine against each other in this process." << std::endl;
+        std::cout << "Engine options: name=<name> hash=<MB> nodes=<nodes per move> tc=<seconds>[+<increment>] "
+                     "nnue=<built-in>|<file> and the search parameters, e.g. NullMovePruningDepthReduction=3" << std::endl;
+        std::cout << "Global --nodes and --tc apply to both engines. By default, the engines search 10000 nodes per move "
+                     "and play the bench positions as openings. Example:" << std::endl;
+        std::cout << "./match --engine name=patch NullMovePruningDepthReduction=3 --engine name=base [--games 100] "
+                     "[--concurrency 8] [--nodes 10000] [--tc 10+0.1] [--openings openings.epd] [--max-plies 400] "
+                     "[--no-adjudication] [--sprt elo0=0 elo1=5 alpha=0.05 beta=0.05]" << std::endl;
+        return 0;
+    }
+
+    try
+    {
+        return runMatch(argc, argv);
+    }
+    catch (const std::exception &ex)
+    {
+        std::cout << ex.what() << std::endl;
+        return 2;
+    }
+}
\ No newline at end of file
@@ -1,12 +1,381 @@
 #include "ModernChess/UCICommunication.h"
+#include "ModernChess/BatchAnalysis.h"
+#include "ModernChess/Bench.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/SpsaTuner.h"
+#ifdef MODERN_CHESS_ENGINE_SERVER
+#include "ModernChess/EngineServer.h"
+#include "ModernChess/LocalSocket.h"
+#endif
 
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
 
 using namespace ModernChess;
 
-int main()
+namespace
 {
-    UCICommunication uciCommunication(std::cin, std::cout, std::cerr);
+    /**
+     * @brief Analyzes all positions of a FEN or EPD file or of stdin, e.g.
+     *        ./modern-chess analyze --threads 64 --depth 12 --movetime 1000 positions.epd > results.txt
+     *        The results are written to stdout, the summary to stderr.
+     * @return exit code: 0, if all positions could be analyzed
+     */
+    int runBatchAnalysis(int argc, char *argv[])
+    {
+        BatchAnalysisLimits limits;
+        uint32_t numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        size_t hashSizeInMB = TranspositionTable::DefaultSizeInMB;
+        bool keepInputOrder = true;
+        std::string inputPath;
+
+        for (int argIndex = 2; argIndex < argc; ++argIndex)
+        {
+            const std::string_view argument = argv[argIndex];
+
+            if (argument == "--unordered")
+            {
+                keepInputOrder = false;
+            }
+            else if (not argument.starts_with("--"))
+            {
+                inputPath = argument;
+            }
+            else if (argIndex + 1 >= argc)
+            {
+                std::cerr << "Missing value of option " << argument << std::endl;
+                return 2;
+            }
+            else if (argument == "--depth")
+            {
+                limits.depth = uint8_t(std::clamp(std::stoi(argv[++argIndex]), 1, int(MaxHalfMoves / 2)));
+            }
+            else if (argument == "--nodes")
+            {
+                limits.nodes = std::stoull(argv[++argIndex]);
+            }
+            else if (argument == "--movetime")
+            {
+                limits.time = std::chrono::milliseconds(std::stoll(argv[++argIndex]));
+            }
+            else if (argument == "--threads")
+            {
+                numberOfThreads = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else if (argument == "--hash")
+            {
+                hashSizeInMB = std::stoul(argv[++argIndex]);
+            }
+            else
+            {
+                std::cerr << "Unknown option " << argument << std::endl;
+                return 2;
+            }
+        }
+
+        BatchAnalysis batchAnalysis(numberOfThreads, hashSizeInMB);
+        batchAnalysis.setLimits(limits);
+        batchAnalysis.setKeepInputOrder(keepInputOrder);
+
+        BatchAnalysisSummary summary;
+
+        if (inputPath.empty() or inputPath == "-")
+        {
+            summary = batchAnalysis.run(std::cin, std::cout);
+        }
+        else
+        {
+            std::ifstream inputFile(inputPath);
+
+            if (not inputFile)
+            {
+                std::cerr << "Could not open " << inputPath << std::endl;
+                return 2;
+            }
+
+            summary = batchAnalysis.run(inputFile, std::cout);
+        }
+
+        std::cerr << "\n" << summary << std::flush;
+
+        return (summary.numberOfErrors == 0) ? 0 : 1;
+    }
+
+    /**
+     * @brief Tunes the search parameters by self-play and prints the converged values, e.g.
+     *        ./modern-chess spsa --iterations 2000 --games 16 --nodes 5000 --threads 64 --openings openings.epd
+     *        The openings are FENs or EPDs, by default the bench positions.
+     * @return exit code
+     */
+    int runSpsa(int argc, char *argv[])
+    {
+        SpsaTuner::Settings settings;
+        settings.numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        std::string openingsPath;
+
+        for (int argIndex = 2; argIndex < argc; ++argIndex)
+        {
+            const std::string_view argument = argv[argIndex];
+
+            if (argIndex + 1 >= argc)
+            {
+                std::cerr << "Missing value of option " << argument << std::endl;
+                return 2;
+            }
+            else if (argument == "--iterations")
+            {
+                settings.numberOfIterations = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else if (argument == "--games")
+            {
+                settings.numberOfGamePairsPerIteration = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else if (argument == "--nodes")
+            {
+                settings.nodesPerMove = std::stoull(argv[++argIndex]);
+            }
+            else if (argument == "--learning-rate")
+            {
+                settings.learningRate = std::stod(argv[++argIndex]);
+            }
+            else if (argument == "--seed")
+            {
+                settings.seed = std::stoull(argv[++argIndex]);
+            }
+            else if (argument == "--threads")
+            {
+                settings.numberOfThreads = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else if (argument == "--openings")
+            {
+                openingsPath = argv[++argIndex];
+            }
+            else
+            {
+                std::cerr << "Unknown option " << argument << std::endl;
+                return 2;
+            }
+        }
+
+        std::vector<GameState> openings;
+
+        if (openingsPath.empty())
+        {
+            for (const char *fen : Bench::Positions)
+            {
+                openings.push_back(FenParsing::FenParser(fen).parse());
+            }
+        }
+        else
+        {
+            std::ifstream openingsFile(openingsPath);
+
+            if (not openingsFile)
+            {
+                std::cerr << "Could not open " << openingsPath << std::endl;
+                return 2;
+            }
+
+            openings = SelfPlay::readOpenings(openingsFile);
+        }
+
+        SpsaTuner spsaTuner(settings, std::move(openings));
+        const SearchParameters searchParameters = spsaTuner.tune(SearchParameters{}, std::cerr);
+
+        for (const TunableSearchParameter &parameter : TunableSearchParameters)
+        {
+            std::cout << parameter.name << " = " << searchParameters.*parameter.value << "\n";
+        }
+
+        std::cout << std::flush;
+
+        return 0;
+    }
+
+#ifdef MODERN_CHESS_ENGINE_SERVER
+    /**
+     * @brief Serves UCI sessions on a local socket until the process is terminated, e.g.
+     *        ./modern-chess server --socket /tmp/modern-chess.sock --hash-budget 1024 --max-sessions 32
+     *        ./modern-chess server --port 5000
+     */
+    int runServer(int argc, char *argv[])
+    {
+        std::string address = "/tmp/modern-chess.sock";
+        size_t hashBudgetInMB = EngineServer::DefaultHashBudgetInMB;
+        uint32_t maxNumberOfSessions = EngineServer::DefaultMaxNumberOfSessions;
+
+        for (int argIndex = 2; argIndex < argc; ++argIndex)
+        {
+            const std::string_view argument = argv[argIndex];
+
+            if (argIndex + 1 >= argc)
+            {
+                std::cerr << "Missing value of option " << argument << std::endl;
+                return 2;
+            }
+            else if (argument == "--socket")
+            {
+                address = argv[++argIndex];
+            }
+            else if (argument == "--port")
+            {
+                address = std::string("localhost:") + argv[++argIndex];
+            }
+            else if (argument == "--hash-budget")
+            {
+                hashBudgetInMB = std::stoul(argv[++argIndex]);
+            }
+            else if (argument == "--max-sessions")
+            {
+                maxNumberOfSessions = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else
+            {
+                std::cerr << "Unknown option " << argument << std::endl;
+                return 2;
+            }
+        }
+
+        EngineServer engineServer(address, hashBudgetInMB, maxNumberOfSessions);
+
+        try
+        {
+            engineServer.start();
+        }
+        catch (const std::runtime_error &error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+
+        std::cerr << "Listening on " << address << " with up to " << maxNumberOfSessions << " sessions and "
+                  << engineServer.hashSizePerSessionInMB() << " MB hash per session" << std::endl;
+
+        engineServer.waitUntilStopped();
+
+        return 0;
+    }
+
+    /**
+     * @brief Connects stdin and stdout to a server, e.g. for GUIs that can only start an executable:
+     *        ./modern-chess connect /tmp/modern-chess.sock
+     */
+    int runClient(std::string_view address)
+    {
+        try
+        {
+            const int socket = LocalSocket::connectTo(address);
+            LocalSocket::relayStandardStreams(socket);
+            LocalSocket::closeSocket(socket);
+        }
+        catch (const std::runtime_error &error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    // "modern-chess bench [depth] [statistics.json]" searches the built-in bench positions and exits
+    if (argc > 1 && std::string_view(argv[1]) == "bench")
+    {
+        int depth = Bench::DefaultDepth;
+
+        if (argc > 2)
+        {
+            const std::string depthArgument(argv[2]);
+            size_t parsedCharacters{};
+
+            try
+            {
+                depth = std::stoi(depthArgument, &parsedCharacters);
+            }
+            catch (const std::exception &)
+            {
+                parsedCharacters = 0;
+            }
+
+            if (parsedCharacters != depthArgument.size() or depth < 1 or depth > int(MaxHalfMoves / 2))
+            {
+                std::cerr << "Invalid depth " << depthArgument << ": expected a number from 1 to " << MaxHalfMoves / 2 << std::endl;
+                return 2;
+            }
+        }
+
+        const BenchResult benchResult = Bench::run(std::cout, uint8_t(depth));
+
+        if (argc > 3)
+        {
+            std::ofstream statisticsFile(argv[3]);
+            benchResult.statistics.writeJson(statisticsFile);
+        }
+
+        return 0;
+    }
+
+    // "modern-chess analyze [options] [file]" analyzes positions without the UCI protocol
+    if (argc > 1 && std::string_view(argv[1]) == "analyze")
+    {
+        try
+        {
+            return runBatchAnalysis(argc, argv);
+        }
+        catch (const std::exception &exception)
+        {
+            std::cerr << exception.what() << std::endl;
+            return 2;
+        }
+    }
+
+    // "modern-chess spsa [options]" tunes the search parameters by self-play
+    if (argc > 1 && std::string_view(argv[1]) == "spsa")
+    {
+        try
+        {
+            return runSpsa(argc, argv);
+        }
+        catch (const std::exception &exception)
+        {
+            std::cerr << exception.what() << std::endl;
+            return 2;
+        }
+    }
+
+#ifdef MODERN_CHESS_ENGINE_SERVER
+    // "modern-chess server [options]" serves several UCI sessions in one process
+    if (argc > 1 && std::string_view(argv[1]) == "server")
+    {
+        try
+        {
+            return runServer(argc, argv);
+        }
+        catch (const std::exception &exception)
+        {
+            std::cerr << exception.what() << std::endl;
+            return 2;
+        }
+    }
+
+    // "modern-chess connect <socket path|port>" speaks UCI with a server
+    if (argc > 2 && std::string_view(argv[1]) == "connect")
+    {
+        return runClient(argv[2]);
+    }
+#endif
+
+    SearchContext searchContext;
+    UCICommunication uciCommunication(std::cin, std::cout, std::cerr, searchContext);
+    uciCommunication.setQuitAtEndOfInput(true);
 
     uciCommunication.startCommunication();
 
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Move.h"
+#include "TranspositionTable.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ModernChess {
+
+    /**
+     * @brief Limits of the search of every position. The search stops as soon as one limit has been reached.
+     */
+    struct BatchAnalysisLimits {
+        uint8_t depth = 10;
+        uint64_t nodes = std::numeric_limits<uint64_t>::max(); ///< no node limit by default
+        std::chrono::milliseconds time{0}; ///< 0: no time limit
+    };
+
+    struct BatchAnalysisPosition {
+        size_t index{}; ///< order of the position in the input, starting with 0
+        std::string id; ///< EPD operation "id" or the line number, if there is no id
+        std::string fen;
+
+        /**
+         * @brief Accepts FENs and EPDs. The half move clock and the move number may be missing.
+         *        EPD operations like "bm" are ignored, except the "id".
+         * @throws std::runtime_error if the line does not contain a position
+         */
+        static BatchAnalysisPosition fromLine(std::string_view line, size_t index, size_t lineNumber);
+    };
+
+    struct BatchAnalysisResult {
+        size_t index{};
+        std::string id;
+        Move bestMove{}; ///< null move, if there is no legal move
+        int32_t score{};
+        uint32_t depth{}; ///< last completed iteration
+        uint64_t numberOfNodes{};
+        std::chrono::milliseconds elapsedTime{};
+        std::vector<Move> pv;
+        std::string error; ///< not empty, if the position could not be analyzed
+    };
+
+    struct BatchAnalysisSummary {
+        size_t numberOfPositions{};
+        size_t numberOfErrors{};
+        uint64_t numberOfNodes{};
+        std::chrono::milliseconds elapsedTime{};
+        double positionsPerSecond{};
+        uint64_t nodesPerSecond{};
+    };
+
+    /**
+     * @brief Analyzes the positions of a FEN or EPD stream with a pool of worker threads, e.g. to annotate game
+     *        databases. Every worker searches with its own Evaluation and its own transposition table. The table is
+     *        cleared for every position, so the results do not depend on the number of threads.
+     */
+    class BatchAnalysis {
+    public:
+        explicit BatchAnalysis(uint32_t numberOfThreads, size_t hashSizeInMB = TranspositionTable::DefaultSizeInMB);
+
+        void setLimits(const BatchAnalysisLimits &limits);
+
+        /**
+         * @param keepInputOrder true: results are written in the order of the input (default).
+         *                       false: results are written as soon as they are available and have to be matched by their id.
+         */
+        void setKeepInputOrder(bool keepInputOrder);
+
+        /**
+         * @brief Writes one result line per position. Positions are read while the workers search,
+         *        so the input does not have to fit into memory. Empty lines and lines beginning with '#' are skipped.
+         */
+        BatchAnalysisSummary run(std::istream &inputStream, std::ostream &outputStream) const;
+
+        /**
+         * @return "id <id> bestmove <move> score cp <score> depth <depth> nodes <nodes> time <ms> pv <moves>" or
+         *         "id <id> error <message>"
+         */
+        static std::string formatResult(const BatchAnalysisResult &result);
+
+    private:
+        uint32_t m_numberOfThreads = 1;
+        size_t m_hashSizeInMB = TranspositionTable::DefaultSizeInMB;
+        BatchAnalysisLimits m_limits{};
+        bool m_keepInputOrder = true;
+    };
+}
+
+std::ostream &operator<<(std::ostream &os, const ModernChess::BatchAnalysisSummary &summary);
\ No newline at end of file
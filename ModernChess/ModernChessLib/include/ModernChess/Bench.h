@@ -0,0 +1,31 @@
+#pragma once
+
+#include "SearchStatistics.h"
+
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <ostream>
+
+namespace ModernChess {
+
+    struct BenchResult {
+        uint64_t numberOfNodes{}; ///< Signature of the search: changes, if the searched tree changes
+        std::chrono::milliseconds elapsedTime{};
+        uint64_t nodesPerSecond{};
+        SearchStatistics statistics{}; ///< sum of the statistics of all positions
+    };
+
+    /**
+     * @brief Searches built-in positions with a fixed depth and a cleared transposition table.
+     *        The total number of nodes is deterministic. A speed optimization, which changes it, also changes the search.
+     */
+    class Bench {
+    public:
+        static constexpr uint8_t DefaultDepth = 7;
+
+        static BenchResult run(std::ostream &outputStream, uint8_t depth = DefaultDepth);
+
+        static const std::array<const char*, 40> Positions;
+    };
+}
\ No newline at end of file
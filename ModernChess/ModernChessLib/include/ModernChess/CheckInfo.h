@@ -0,0 +1,65 @@
+#pragma once
+
+#include "BitBoardConstants.h"
+#include "Board.h"
+#include "Move.h"
+
+#include <array>
+
+namespace ModernChess
+{
+    /**
+     * @brief Check related information of a position, which is computed once per node and reused for every move
+     *        of this node.
+     * @see https://www.chessprogramming.org/Check
+     * @see https://www.chessprogramming.org/Pin
+     */
+    class CheckInfo
+    {
+    public:
+        explicit CheckInfo(const Board &board);
+
+        [[nodiscard]] bool kingIsInCheck() const
+        {
+            return checkers != BoardState::empty;
+        }
+
+        /**
+         * @brief Predicts if the (pseudo legal) move gives check to the opponent's king without executing it.
+         */
+        [[nodiscard]] bool givesCheck(Move move) const;
+
+        /**
+         * @brief Returns true, if the pseudo legal move can't expose the own king into a check.
+         *        Hence, the king safety check after executing the move can be skipped.
+         */
+        [[nodiscard]] bool moveIsKnownToBeLegal(Move move) const;
+
+        // Opponent's figures, which give check to the king of the side to move
+        BitBoardState checkers = BoardState::empty;
+
+        // Figures of the side to move, which are pinned to their own king
+        BitBoardState pinned = BoardState::empty;
+
+        // Figures of the side to move, which give a discovered check if they move off the line to the opponent's king
+        BitBoardState discoveredCheckCandidates = BoardState::empty;
+
+        // [figure type of side to move] squares from which the figure gives check to the opponent's king
+        std::array<BitBoardState, 6> checkSquares{};
+
+    private:
+        [[nodiscard]] BitBoardState blockersForKing(Square kingsSquare,
+                                                    BitBoardState blockerCandidates,
+                                                    BitBoardState rookSliders,
+                                                    BitBoardState bishopSliders) const;
+
+        [[nodiscard]] bool slidersAttackOpponentsKing(BitBoardState occupancy,
+                                                      BitBoardState rookSliders,
+                                                      BitBoardState bishopSliders) const;
+
+        const Board &m_board;
+        Color m_opponent;
+        Square m_opponentsKingSquare;
+        Figure m_figureOffset; ///< Either white pawn or black pawn, depending on the side to move
+    };
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cinttypes>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ModernChess {
+
+    /**
+     * @brief Serves many UCI sessions in one process, e.g. for running a tournament with many parallel games
+     *        on one machine. Every connection to the local socket is a UCI session with its own engine.
+     *        The attack tables and the Zobrist keys exist only once, but every session has its own
+     *        transposition table, which is a slice of the hash budget of the server.
+     *        A session ends with "quit" or when the client closes the connection.
+     * @see LocalSocket for the supported addresses
+     */
+    class EngineServer
+    {
+    public:
+        static constexpr size_t DefaultHashBudgetInMB = 256;
+        static constexpr uint32_t DefaultMaxNumberOfSessions = 16;
+
+        explicit EngineServer(std::string address,
+                              size_t hashBudgetInMB = DefaultHashBudgetInMB,
+                              uint32_t maxNumberOfSessions = DefaultMaxNumberOfSessions);
+
+        /**
+         * @brief Stops the server, see stop()
+         */
+        ~EngineServer();
+
+        EngineServer(const EngineServer &) = delete;
+        EngineServer &operator=(const EngineServer &) = delete;
+
+        /**
+         * @brief Listens on the address and accepts the connections in a separate thread.
+         * @throws std::runtime_error if the address cannot be used
+         */
+        void start();
+
+        /**
+         * @brief Closes all connections and waits until all sessions have ended.
+         */
+        void stop();
+
+        /**
+         * @brief Blocks until the server has been stopped.
+         */
+        void waitUntilStopped();
+
+        [[nodiscard]] size_t hashSizePerSessionInMB() const;
+
+        [[nodiscard]] size_t numberOfSessions() const;
+
+    private:
+        struct Session {
+            int socket{};
+            std::thread thread;
+            std::atomic<bool> finished{false};
+        };
+
+        std::string m_address;
+        size_t m_hashSizePerSessionInMB;
+        uint32_t m_maxNumberOfSessions;
+        int m_listeningSocket = -1;
+        std::atomic<bool> m_stopped{false};
+        std::thread m_acceptThread;
+        mutable std::mutex m_mutex;
+        std::list<std::unique_ptr<Session>> m_sessions;
+
+        void acceptConnections();
+        void runSession(Session &session) const;
+
+        // The caller has to hold the lock
+        void removeFinishedSessions();
+    };
+}
\ No newline at end of file
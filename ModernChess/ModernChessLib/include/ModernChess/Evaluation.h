@@ -1,13 +1,22 @@
 #pragma once
 
+#include "EvaluationParameters.h"
 #include "GameState.h"
+#include "HistoryTables.h"
+#include "MoveExecution.h"
 #include "PrincipalVariationTable.h"
+#include "SearchContext.h"
+#include "SearchParameters.h"
+#include "SearchProgress.h"
+#include "SearchStatistics.h"
 
 #include <array>
 #include <algorithm>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <span>
+#include <vector>
 
 namespace ModernChess
 {
@@ -16,61 +25,175 @@ namespace ModernChess
         EvaluationResult() = default;
 
         explicit EvaluationResult(int32_t score,
-                                  uint32_t numberOfNodes,
+                                  uint64_t numberOfNodes,
+                                  uint64_t numberOfQuiescenceNodes,
                                   int32_t depth,
                                   std::shared_ptr<PrincipalVariationTable> pvTable) :
                 score(score),
                 numberOfNodes(numberOfNodes),
+                numberOfQuiescenceNodes(numberOfQuiescenceNodes),
                 depth(depth),
                 pvTable(std::move(pvTable)){}
 
         [[nodiscard]] Move bestMove() const { return *pvTable->begin(); }
         int32_t score{};
-        uint32_t numberOfNodes{};
+        uint64_t numberOfNodes{}; ///< nodes of the main search and the quiescence search
+        uint64_t numberOfQuiescenceNodes{}; ///< nodes of the quiescence search only
         uint32_t depth{};
+        uint32_t multiPv = 1; ///< rank of this PV line in Multi-PV mode, starting with 1 for the best line
         std::shared_ptr<PrincipalVariationTable> pvTable{};
     };
 
+    struct IterativeDeepeningResult
+    {
+        [[nodiscard]] Move bestMove() const { return pv.empty() ? Move{} : pv.front(); }
+        int32_t score{};
+        uint32_t depth{}; ///< last completed iteration
+        std::vector<Move> pv{}; ///< of the last completed iteration, empty if there is no legal move
+        uint64_t numberOfNodes{}; ///< all searched nodes including the ones of an interrupted iteration
+        bool completed{}; ///< false, if the search has been stopped before the maximum depth
+    };
+
+    struct IterativeDeepeningOptions
+    {
+        uint32_t numberOfPVs = 1; ///< Multi-PV mode, if greater than 1
+        std::function<bool()> stopBeforeNextIteration{}; ///< e.g. if the next iteration would exceed the time limit
+        std::function<void(const std::vector<EvaluationResult> &)> onIterationFinished{}; ///< lines of every used iteration
+    };
+
     class Evaluation
     {
     public:
-        explicit Evaluation(GameState gameState) :
-                Evaluation(gameState, []{ return false; })
+        /**
+         * @param searchContext The transposition table of the context is used and kept, its history tables
+         *                      are reset. The positions are evaluated by the neural network of the context,
+         *                      if it has one. The context has to outlive the evaluation.
+         */
+        explicit Evaluation(SearchContext &searchContext, GameState gameState) :
+                Evaluation(searchContext, gameState, []{ return false; })
         {}
 
-        explicit Evaluation(GameState gameState, std::function<bool()> stopSearching) :
+        explicit Evaluation(SearchContext &searchContext, GameState gameState, std::function<bool()> stopSearching) :
                 m_gameState{gameState},
                 m_halfMoveClockRootSearch{m_gameState.halfMoveClock},
                 pvTable{std::make_shared<PrincipalVariationTable>(m_halfMoveClockRootSearch)},
-                m_stopSearching{std::move(stopSearching)}
-        {}
+                m_historyTables{searchContext.historyTables()},
+                m_stopSearching{std::move(stopSearching)},
+                m_transpositionTable{searchContext.transpositionTable()},
+                m_neuralNetwork{searchContext.neuralNetwork()},
+                m_searchParameters{searchContext.searchParameters()}
+        {
+            m_historyTables.clear();
+            m_transpositionTable.newSearch();
+
+            // MoveExecution updates the accumulators only, if the network is used
+            m_gameState.accumulator = nullptr;
+
+            if (m_neuralNetwork != nullptr)
+            {
+                m_accumulators = std::make_unique<std::array<Accumulator, MaxHalfMoves + 1>>();
+                m_gameState.accumulator = m_accumulators->data();
+                m_neuralNetwork->refresh(*m_gameState.accumulator, m_gameState.board);
+            }
+        }
 
         [[nodiscard]] EvaluationResult getBestMove(uint8_t depth);
 
+        /**
+         * @brief Iterative deepening from depth 1 up to maxDepth. An iteration, which has been stopped by the node
+         *        limit or the stop function, is not reliable, so its result is only used, if there is no other one.
+         * @return the best line of the last used iteration
+         */
+        [[nodiscard]] IterativeDeepeningResult searchIteratively(uint8_t maxDepth, const IterativeDeepeningOptions &options = {});
+
+        /**
+         * @brief Multi-PV search: The root is searched numberOfPVs times. Each pass excludes the best moves of the
+         *        previous passes. The transposition table is shared between the passes.
+         * @return up to numberOfPVs results ordered from the best to the worst line, but at least one.
+         *         Fewer, if there are not enough legal moves or if the search has been stopped.
+         */
+        [[nodiscard]] std::vector<EvaluationResult> getBestMoves(uint8_t depth, uint32_t numberOfPVs);
+
+        /**
+         * @brief The search is stopped as soon as the given number of nodes has been searched. The nodes of
+         *        all searches of this instance are counted, so iterative deepening shares the limit.
+         *        In contrast to a time limit, the searched tree does not depend on the speed of the machine.
+         */
+        void setNodeLimit(uint64_t numberOfNodes)
+        {
+            m_nodeLimit = numberOfNodes;
+        }
+
+        [[nodiscard]] bool nodeLimitReached() const
+        {
+            return m_numberOfNodes + m_numberOfQuiescenceNodes >= m_nodeLimit;
+        }
+
+        static constexpr uint64_t NoNodeLimit = std::numeric_limits<uint64_t>::max();
+
+        /**
+         * @brief The search publishes its progress for other threads
+         */
+        void setSearchProgress(std::shared_ptr<SearchProgress> searchProgress)
+        {
+            m_searchProgress = std::move(searchProgress);
+        }
+
+        /**
+         * @brief Cooperative multitasking: The search calls the function with the number of searched nodes
+         *        after every given number of nodes, e.g. in order to suspend itself, see SearchScheduler.
+         */
+        void setYieldFunction(std::function<void(uint64_t)> yield, uint64_t numberOfNodesBetweenYields)
+        {
+            m_yield = std::move(yield);
+            m_numberOfNodesBetweenYields = std::max<uint64_t>(numberOfNodesBetweenYields, 1);
+        }
+
+        /**
+         * @return statistics of all searches of this instance. Empty, if they have been compiled out.
+         */
+        [[nodiscard]] SearchStatistics statistics() const;
+
     protected:
         // Use half of max number in order to avoid overflows
         static constexpr int32_t Infinity = std::numeric_limits<int32_t>::max() / 2;
         static constexpr int32_t CheckMateScore = -Infinity + 1;
         static constexpr int32_t StaleMateScore = 0;
-        static constexpr int32_t BestKillerMoveScore = 90'000;
-        static constexpr int32_t SecondBestKillerMoveScore = 80'000;
-        static constexpr int32_t CaptureScoreOffset = 100'000;
         static constexpr int32_t PvScore = 200'000;
         static constexpr size_t MaxNumberOfKillerMoves = 2;
-        static constexpr int32_t NumberOfMovesForFullDepthSearch = 3;
         static constexpr uint32_t NumberOfFiguresForEndGameDefinition = 6;
-        static constexpr uint8_t MinimumDepthForFullDepthSearch = 2;
-        static constexpr uint8_t NullMovePruningDepthReduction = 2;
-
-        uint32_t m_numberOfNodes{};
+        static constexpr size_t MaxNumberOfQuietMovesForHistoryUpdate = 64;
+        // A capture must be able to raise the score up to alpha by this margin, otherwise it is pruned
+        static constexpr int32_t DeltaPruningMargin = 200;
+        // Sampling the occupancy of the transposition table is too expensive for every node
+        static constexpr uint64_t HashfullSamplingInterval = 1 << 16;
+
+        uint64_t m_numberOfNodes{};
+        uint64_t m_numberOfQuiescenceNodes{};
         GameState m_gameState;
         int32_t m_halfMoveClockRootSearch{};
         std::shared_ptr<PrincipalVariationTable> pvTable{};
         // killer moves [id][ply]
         std::array<std::array<Move, MaxNumberOfKillerMoves>, MaxHalfMoves> m_killerMoves{};
-        // history moves [figure][square]
-        std::array<std::array<int32_t, NumberOfFigureTypes>, NumberOfSquares> m_historyMoves{};
+        // history moves, counter moves and continuation history of the search context
+        HistoryTables &m_historyTables;
+        // move which has led to the position at [ply]. A NULL move, if there is none (root or null move pruning).
+        std::array<Move, MaxHalfMoves + 1> m_moveStack{};
         std::function<bool()> m_stopSearching{};
+        uint64_t m_nodeLimit = NoNodeLimit;
+        SearchStatistics m_statistics{};
+        std::shared_ptr<SearchProgress> m_searchProgress{};
+        std::function<void(uint64_t)> m_yield{};
+        uint64_t m_numberOfNodesBetweenYields{};
+        TranspositionTable &m_transpositionTable;
+        // nullptr for the handcrafted evaluation
+        const NeuralNetwork *m_neuralNetwork{};
+        // accumulators of the neural network [ply]
+        std::unique_ptr<std::array<Accumulator, MaxHalfMoves + 1>> m_accumulators{};
+        // copied from the search context, so the search does not follow a pointer
+        const SearchParameters m_searchParameters;
+        // root moves, which are skipped, because they have been found in previous Multi-PV passes
+        std::vector<Move> m_excludedRootMoves{};
 
         // follow PV & score PV move
         bool m_followPv{};
@@ -78,10 +201,10 @@ namespace ModernChess
 
         bool m_allowNullMove = true;
 
-        [[nodiscard]] bool kingIsInCheck() const;
-        [[nodiscard]] bool kingIsInCheck(Color sideToMove) const;
-
-        [[nodiscard]] std::vector<Move> generateSortedMoves();
+        /**
+         * @param moveType MoveType::CapturesOnly removes all quiet moves before sorting
+         */
+        [[nodiscard]] std::vector<Move> generateSortedMoves(MoveType moveType = MoveType::AllMoves);
 
         // negamax alpha beta search
         [[nodiscard]] int32_t negamax(int32_t alpha, int32_t beta, uint8_t depth);
@@ -90,10 +213,80 @@ namespace ModernChess
 
         [[nodiscard]] int32_t evaluatePosition() const;
 
+        /**
+         * @brief Has to be called before a move is executed: The accumulator of the current ply is copied to
+         *        the next ply, which is updated by the move. Restoring the game state returns to the current ply.
+         */
+        void prepareAccumulatorForNextPly()
+        {
+            if (m_gameState.accumulator != nullptr)
+            {
+                Accumulator *nextAccumulator = m_gameState.accumulator + 1;
+                *nextAccumulator = *m_gameState.accumulator;
+                m_gameState.accumulator = nextAccumulator;
+            }
+        }
+
         [[nodiscard]] int32_t scoreMove(Move move);
 
+        /**
+         * @return figure captured by the given capture move. A pawn, if it is an en passant capture.
+         */
+        [[nodiscard]] Figure capturedFigure(Move move) const;
+
+        /**
+         * @return move which has been played the given number of plies before the current position or
+         *         a NULL move, if there is none
+         */
+        [[nodiscard]] Move previousMove(int32_t pliesBack) const;
+
+        [[nodiscard]] int32_t scoreQuietMove(Move move) const;
+
+        /**
+         * @brief Rewards the quiet move which caused a beta cutoff and penalizes the quiet moves searched before it
+         */
+        void updateQuietMoveHistories(Move bestMove, std::span<const Move> failedQuietMoves, uint8_t depth);
+
         [[nodiscard]] bool isEndGame() const;
 
+        /**
+         * @brief Probes the transposition table and counts probes, hits and cutoffs
+         */
+        [[nodiscard]] int32_t probeTranspositionTable(int32_t alpha, int32_t beta, uint8_t depth);
+
+        /**
+         * @return true, if the search has been stopped from outside or if the node limit has been reached
+         */
+        [[nodiscard]] bool searchHasToBeStopped() const
+        {
+            return nodeLimitReached() or m_stopSearching();
+        }
+
+        // Called for every node: publishes the progress and gives a scheduler the chance to suspend the search
+        void publishNumberOfNodes()
+        {
+            if (m_searchProgress)
+            {
+                const uint64_t numberOfNodes = m_numberOfNodes + m_numberOfQuiescenceNodes;
+                m_searchProgress->numberOfNodes.store(numberOfNodes, std::memory_order_relaxed);
+
+                if (numberOfNodes % HashfullSamplingInterval == 0)
+                {
+                    m_searchProgress->hashfull.store(m_transpositionTable.hashfull(), std::memory_order_relaxed);
+                }
+            }
+
+            if (m_yield)
+            {
+                const uint64_t numberOfNodes = m_numberOfNodes + m_numberOfQuiescenceNodes;
+
+                if (numberOfNodes % m_numberOfNodesBetweenYields == 0)
+                {
+                    m_yield(numberOfNodes);
+                }
+            }
+        }
+
         /*
          * @see https://www.chessprogramming.org/MVV-LVA
          *
@@ -109,115 +302,15 @@ namespace ModernChess
          */
 
         // most valuable victim & less valuable attacker [attacker][victim]
-        static constexpr std::array<std::array<int32_t, NumberOfFigureTypes>, NumberOfFigureTypes> mvvLva {
-            {
-                {105, 205, 305, 405, 505, 605,  105, 205, 305, 405, 505, 605},
-                {104, 204, 304, 404, 504, 604,  104, 204, 304, 404, 504, 604},
-                {103, 203, 303, 403, 503, 603,  103, 203, 303, 403, 503, 603},
-                {102, 202, 302, 402, 502, 602,  102, 202, 302, 402, 502, 602},
-                {101, 201, 301, 401, 501, 601,  101, 201, 301, 401, 501, 601},
-                {100, 200, 300, 400, 500, 600,  100, 200, 300, 400, 500, 600},
-
-                {105, 205, 305, 405, 505, 605,  105, 205, 305, 405, 505, 605},
-                {104, 204, 304, 404, 504, 604,  104, 204, 304, 404, 504, 604},
-                {103, 203, 303, 403, 503, 603,  103, 203, 303, 403, 503, 603},
-                {102, 202, 302, 402, 502, 602,  102, 202, 302, 402, 502, 602},
-                {101, 201, 301, 401, 501, 601,  101, 201, 301, 401, 501, 601},
-                {100, 200, 300, 400, 500, 600,  100, 200, 300, 400, 500, 600}
-            }
-        };
-
-        /*
-         *   Material Score
-         *
-         *   ♙ =   100   = ♙
-         *   ♘ =   300   = ♙ * 3
-         *   ♗ =   350   = ♙ * 3 + ♙ * 0.5
-         *   ♖ =   500   = ♙ * 5
-         *   ♕ =   1000  = ♙ * 10
-         *   ♔ =   10000 = ♙ * 100
-         */
-
-        static constexpr std::array<int32_t, NumberOfFigureTypes> materialScore {
-            100,      // white pawn score
-            300,      // white knight score
-            350,      // white bishop score
-            500,      // white rook score
-            1000,      // white queen score
-            10000,      // white king score
-            -100,      // black pawn score
-            -300,      // black knight score
-            -350,      // black bishop score
-            -500,      // black rook score
-            -1000,      // black queen score
-            -10000,      // black king score
-        };
-
-        // pawn positional score
-        static constexpr std::array<int32_t, NumberOfSquares> pawnScore =
-        {
-            0,   0,   0,   0,   0,   0,   0,   0,
-            0,   0,   0, -10, -10,   0,   0,   0,
-            0,   0,   0,   5,   5,   0,   0,   0,
-            5,   5,  10,  20,  20,   5,   5,   5,
-            10,  10,  10,  20,  20,  10,  10,  10,
-            20,  20,  20,  30,  30,  30,  20,  20,
-            30,  30,  30,  40,  40,  30,  30,  30,
-            90,  90,  90,  90,  90,  90,  90,  90,
-        };
-
-        // knight positional score
-        static constexpr std::array<int32_t, NumberOfSquares> knightScore =
-        {
-            -5, -10,   0,   0,   0,   0, -10,  -5,
-            -5,   0,   0,   0,   0,   0,   0,  -5,
-            -5,   5,  20,  10,  10,  20,   5,  -5,
-            -5,  10,  20,  30,  30,  20,  10,  -5,
-            -5,  10,  20,  30,  30,  20,  10,  -5,
-            -5,   5,  20,  20,  20,  20,   5,  -5,
-            -5,   0,   0,  10,  10,   0,   0,  -5,
-            -5,   0,   0,   0,   0,   0,   0,  -5,
-        };
-
-        // bishop positional score
-        static constexpr std::array<int32_t, NumberOfSquares> bishopScore =
-        {
-            0,   0, -10,   0,   0, -10,   0,   0,
-            0,  30,   0,   0,   0,   0,  30,   0,
-            0,  10,   0,   0,   0,   0,  10,   0,
-            0,   0,  10,  20,  20,  10,   0,   0,
-            0,   0,  10,  20,  20,  10,   0,   0,
-            0,   0,   0,  10,  10,   0,   0,   0,
-            0,   0,   0,   0,   0,   0,   0,   0,
-            0,   0,   0,   0,   0,   0,   0,   0,
-
-        };
-
-        // rook positional score
-        static constexpr std::array<int32_t, NumberOfSquares> rookScore =
-        {
-             0,   0,   0,  20,  20,   0,   0,   0,
-             0,   0,  10,  20,  20,  10,   0,   0,
-             0,   0,  10,  20,  20,  10,   0,   0,
-             0,   0,  10,  20,  20,  10,   0,   0,
-             0,   0,  10,  20,  20,  10,   0,   0,
-             0,   0,  10,  20,  20,  10,   0,   0,
-            50,  50,  50,  50,  50,  50,  50,  50,
-            50,  50,  50,  50,  50,  50,  50,  50,
-        };
-
-        // king positional score
-        static constexpr std::array<int32_t, NumberOfSquares> kingScore =
-        {
-            0,   0,   5,   0, -15,   0,  10,   0,
-            0,   5,   5,  -5,  -5,   0,   5,   0,
-            0,   0,   5,  10,  10,   5,   0,   0,
-            0,   5,  10,  20,  20,  10,   5,   0,
-            0,   5,  10,  20,  20,  10,   5,   0,
-            0,   5,   5,  10,  10,   5,   5,   0,
-            0,   0,   5,   5,   5,   5,   0,   0,
-            0,   0,   0,   0,   0,   0,   0,   0,
-        };
+        static constexpr auto mvvLva = EvaluationParameters::mvvLva;
+
+        // The material and positional scores are generated by texel-tuning
+        static constexpr auto materialScore = EvaluationParameters::materialScore;
+        static constexpr auto pawnScore = EvaluationParameters::pawnScore;
+        static constexpr auto knightScore = EvaluationParameters::knightScore;
+        static constexpr auto bishopScore = EvaluationParameters::bishopScore;
+        static constexpr auto rookScore = EvaluationParameters::rookScore;
+        static constexpr auto kingScore = EvaluationParameters::kingScore;
 
         // mirror positional score tables for opposite side
         static constexpr std::array<Square, NumberOfSquares> mirrorScore =
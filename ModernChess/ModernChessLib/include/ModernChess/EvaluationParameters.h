@@ -0,0 +1,109 @@
+#pragma once
+
+#include "GlobalConstants.h"
+
+#include <array>
+#include <cinttypes>
+
+/*
+ * Parameters of the handcrafted evaluation, see Evaluation::evaluatePosition().
+ * The positional scores are seen from white and indexed by square, i.e. a1 comes first.
+ * This file is generated by texel-tuning, see TexelTuner.
+ */
+namespace ModernChess::EvaluationParameters
+{
+    // The material of the kings is not tuned, because both sides always have one
+    constexpr std::array<int32_t, NumberOfFigureTypes> materialScore {
+        100, // white pawn
+        300, // white knight
+        350, // white bishop
+        500, // white rook
+        1000, // white queen
+        10000, // white king
+        -100, // black pawn
+        -300, // black knight
+        -350, // black bishop
+        -500, // black rook
+        -1000, // black queen
+        -10000, // black king
+    };
+
+    // pawn positional score
+    constexpr std::array<int32_t, NumberOfSquares> pawnScore {
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0, -10, -10,   0,   0,   0,
+          0,   0,   0,   5,   5,   0,   0,   0,
+          5,   5,  10,  20,  20,   5,   5,   5,
+         10,  10,  10,  20,  20,  10,  10,  10,
+         20,  20,  20,  30,  30,  30,  20,  20,
+         30,  30,  30,  40,  40,  30,  30,  30,
+         90,  90,  90,  90,  90,  90,  90,  90,
+    };
+
+    // knight positional score
+    constexpr std::array<int32_t, NumberOfSquares> knightScore {
+         -5, -10,   0,   0,   0,   0, -10,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   5,  20,  10,  10,  20,   5,  -5,
+         -5,  10,  20,  30,  30,  20,  10,  -5,
+         -5,  10,  20,  30,  30,  20,  10,  -5,
+         -5,   5,  20,  20,  20,  20,   5,  -5,
+         -5,   0,   0,  10,  10,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+    };
+
+    // bishop positional score
+    constexpr std::array<int32_t, NumberOfSquares> bishopScore {
+          0,   0, -10,   0,   0, -10,   0,   0,
+          0,  30,   0,   0,   0,   0,  30,   0,
+          0,  10,   0,   0,   0,   0,  10,   0,
+          0,   0,  10,  20,  20,  10,   0,   0,
+          0,   0,  10,  20,  20,  10,   0,   0,
+          0,   0,   0,  10,  10,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+    };
+
+    // rook positional score
+    constexpr std::array<int32_t, NumberOfSquares> rookScore {
+          0,   0,   0,  20,  20,   0,   0,   0,
+          0,   0,  10,  20,  20,  10,   0,   0,
+          0,   0,  10,  20,  20,  10,   0,   0,
+          0,   0,  10,  20,  20,  10,   0,   0,
+          0,   0,  10,  20,  20,  10,   0,   0,
+          0,   0,  10,  20,  20,  10,   0,   0,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         50,  50,  50,  50,  50,  50,  50,  50,
+    };
+
+    // king positional score
+    constexpr std::array<int32_t, NumberOfSquares> kingScore {
+          0,   0,   5,   0, -15,   0,  10,   0,
+          0,   5,   5,  -5,  -5,   0,   5,   0,
+          0,   0,   5,  10,  10,   5,   0,   0,
+          0,   5,  10,  20,  20,  10,   5,   0,
+          0,   5,  10,  20,  20,  10,   5,   0,
+          0,   5,   5,  10,  10,   5,   5,   0,
+          0,   0,   5,   5,   5,   5,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,
+    };
+
+    /*
+     * Most valuable victim & least valuable attacker [attacker][victim], see https://www.chessprogramming.org/MVV-LVA
+     * The victims are ranked by their material score and the attackers in reverse order.
+     */
+    constexpr std::array<std::array<int32_t, NumberOfFigureTypes>, NumberOfFigureTypes> mvvLva {{
+        {105, 205, 305, 405, 505, 605,  105, 205, 305, 405, 505, 605},
+        {104, 204, 304, 404, 504, 604,  104, 204, 304, 404, 504, 604},
+        {103, 203, 303, 403, 503, 603,  103, 203, 303, 403, 503, 603},
+        {102, 202, 302, 402, 502, 602,  102, 202, 302, 402, 502, 602},
+        {101, 201, 301, 401, 501, 601,  101, 201, 301, 401, 501, 601},
+        {100, 200, 300, 400, 500, 600,  100, 200, 300, 400, 500, 600},
+        {105, 205, 305, 405, 505, 605,  105, 205, 305, 405, 505, 605},
+        {104, 204, 304, 404, 504, 604,  104, 204, 304, 404, 504, 604},
+        {103, 203, 303, 403, 503, 603,  103, 203, 303, 403, 503, 603},
+        {102, 202, 302, 402, 502, 602,  102, 202, 302, 402, 502, 602},
+        {101, 201, 301, 401, 501, 601,  101, 201, 301, 401, 501, 601},
+        {100, 200, 300, 400, 500, 600,  100, 200, 300, 400, 500, 600}
+    }};
+}
\ No newline at end of file
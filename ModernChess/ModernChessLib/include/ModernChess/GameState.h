@@ -3,14 +3,15 @@
 #include "Board.h"
 #include "Move.h"
 #include "ZobristHasher.h"
-#include "TranspositionTable.h"
 
 namespace ModernChess
 {
+    struct Accumulator;
+
     class GameState
     {
     public:
-        GameState();
+        GameState() = default;
 
     //private:
         Board board{};
@@ -18,13 +19,12 @@ namespace ModernChess
         int32_t halfMoveClock = 0;
         int32_t nextMoveClock = 0;
         uint64_t gameStateHash = 0;
-        static TranspositionTable transpositionTable;
+        // First layer of the neural network evaluation, which is updated by MoveExecution. Set only by searches,
+        // which use the network. It is not part of the game state, because copying it would slow down every move.
+        Accumulator *accumulator = nullptr;
 
         //std::vector<Move> moveList;
         bool operator==(const GameState &other) const = default;
-
-    private:
-        static const ZobristHasher m_hasher;
     };
 
 }
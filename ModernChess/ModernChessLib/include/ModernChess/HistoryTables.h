@@ -0,0 +1,82 @@
+#pragma once
+
+#include "GlobalConstants.h"
+#include "Move.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+namespace ModernChess
+{
+    /**
+     * @brief Statistics for ordering quiet moves, which are learned during the search.
+     *
+     * - Butterfly history [color][from][to]
+     * - Counter moves [figure of previous move][target square of previous move]
+     * - Continuation history for the previous move (1-ply) and our own previous move (2-ply)
+     *
+     * @see https://www.chessprogramming.org/History_Heuristic
+     * @see https://www.chessprogramming.org/Countermove_Heuristic
+     */
+    struct HistoryTables
+    {
+        // Every history entry stays within [-MaxHistoryScore, MaxHistoryScore]
+        static constexpr int32_t MaxHistoryScore = 16'384;
+
+        // [figure][target square]
+        using FigureToHistory = std::array<std::array<int16_t, NumberOfSquares>, NumberOfFigureTypes>;
+
+        // butterfly history [color][from][to]
+        std::array<std::array<std::array<int16_t, NumberOfSquares>, NumberOfSquares>, 2> butterfly{};
+
+        // counter moves [figure of previous move][target square of previous move]
+        std::array<std::array<Move, NumberOfSquares>, NumberOfFigureTypes> counterMoves{};
+
+        // continuation history [plies back - 1][previous figure][previous target square][figure][target square]
+        std::array<std::array<std::array<FigureToHistory, NumberOfSquares>, NumberOfFigureTypes>, 2> continuation{};
+
+        /**
+         * @brief Assigning empty tables would create large temporaries on the stack
+         */
+        void clear()
+        {
+            for (auto &fromSquares : butterfly)
+            {
+                for (auto &toSquares : fromSquares)
+                {
+                    toSquares.fill(0);
+                }
+            }
+
+            for (auto &targetSquares : counterMoves)
+            {
+                targetSquares.fill(Move());
+            }
+
+            for (auto &previousFigures : continuation)
+            {
+                for (auto &previousTargetSquares : previousFigures)
+                {
+                    for (FigureToHistory &figureToHistory : previousTargetSquares)
+                    {
+                        for (auto &targetSquares : figureToHistory)
+                        {
+                            targetSquares.fill(0);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief "History gravity": The closer an entry is to the bound, the less it changes. This keeps the entries
+         *        bounded without periodic aging and lets recent results outweigh old ones.
+         */
+        static void update(int16_t &entry, int32_t bonus)
+        {
+            const int32_t clampedBonus = std::clamp(bonus, -MaxHistoryScore, MaxHistoryScore);
+            entry = int16_t(entry + clampedBonus - entry * std::abs(clampedBonus) / MaxHistoryScore);
+        }
+    };
+}
\ No newline at end of file
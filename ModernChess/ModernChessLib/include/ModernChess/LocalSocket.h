@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace ModernChess::LocalSocket {
+
+    /**
+     * @brief Stream buffer of a connected socket, e.g. for std::istream and std::ostream.
+     *        Reading and writing from different threads needs two buffers on the same socket.
+     *        The socket is not closed by the buffer.
+     */
+    class SocketStreamBuffer final : public std::streambuf
+    {
+    public:
+        explicit SocketStreamBuffer(int socket);
+        ~SocketStreamBuffer() override;
+
+        SocketStreamBuffer(const SocketStreamBuffer &) = delete;
+        SocketStreamBuffer &operator=(const SocketStreamBuffer &) = delete;
+
+    protected:
+        int_type underflow() override;
+        int_type overflow(int_type character) override;
+        int sync() override;
+
+    private:
+        static constexpr size_t BufferSize = 4096;
+
+        int m_socket;
+        std::array<char, BufferSize> m_inputBuffer{};
+        std::array<char, BufferSize> m_outputBuffer{};
+    };
+
+    /**
+     * @brief An address is either "localhost:<port>" resp. "<port>" for TCP on the loopback interface
+     *        or the path of a Unix domain socket.
+     */
+    [[nodiscard]] bool isTcpAddress(std::string_view address);
+
+    /**
+     * @brief An existing Unix domain socket file is replaced.
+     * @return listening socket
+     * @throws std::runtime_error
+     */
+    [[nodiscard]] int listenOn(std::string_view address, int backlog);
+
+    /**
+     * @return connected socket
+     * @throws std::runtime_error
+     */
+    [[nodiscard]] int connectTo(std::string_view address);
+
+    /**
+     * @brief Sends everything of stdin to the socket and everything of the socket to stdout,
+     *        until the socket has been closed by the other side.
+     */
+    void relayStandardStreams(int socket);
+
+    void closeSocket(int socket);
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "GameState.h"
+#include "SelfPlay.h"
+
+#include <cinttypes>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace ModernChess
+{
+    /**
+     * @brief Games of a match from the view of the first engine
+     */
+    struct MatchResult
+    {
+        uint32_t wins{};
+        uint32_t losses{};
+        uint32_t draws{};
+
+        [[nodiscard]] uint32_t numberOfGames() const
+        {
+            return wins + losses + draws;
+        }
+
+        /**
+         * @return points per game between 0 and 1
+         */
+        [[nodiscard]] double score() const;
+
+        /**
+         * @return Elo difference of the first to the second engine according to the logistic model
+         */
+        [[nodiscard]] double eloDifference() const;
+
+        /**
+         * @return half of the 95% confidence interval of eloDifference()
+         */
+        [[nodiscard]] double eloErrorMargin() const;
+
+        /**
+         * @return likelihood of superiority: probability, that the first engine is stronger. Draws are ignored.
+         */
+        [[nodiscard]] double likelihoodOfSuperiority() const;
+
+        /**
+         * @return log-likelihood ratio of the hypothesis "Elo difference = elo1" against "Elo difference = elo0"
+         *         with the normal approximation of the trinomial distribution of the game results
+         */
+        [[nodiscard]] double logLikelihoodRatio(double elo0, double elo1) const;
+    };
+
+    std::ostream &operator<<(std::ostream &os, const MatchResult &matchResult);
+
+    /**
+     * @brief Sequential probability ratio test: The match stops as soon as the games show, that the Elo
+     *        difference is elo0 (H0) rather than elo1 (H1) or vice versa, with the given error probabilities.
+     * @see https://www.chessprogramming.org/Sequential_Probability_Ratio_Test
+     */
+    struct Sprt
+    {
+        enum class Status : uint8_t
+        {
+            Continue,
+            AcceptH0, ///< e.g. the patch does not gain elo1
+            AcceptH1
+        };
+
+        double elo0 = 0.0;
+        double elo1 = 5.0;
+        double alpha = 0.05; ///< probability to accept H1, although H0 is true
+        double beta = 0.05; ///< probability to accept H0, although H1 is true
+
+        [[nodiscard]] double lowerBound() const;
+
+        [[nodiscard]] double upperBound() const;
+
+        [[nodiscard]] Status status(const MatchResult &matchResult) const;
+    };
+
+    std::ostream &operator<<(std::ostream &os, Sprt::Status status);
+
+    /**
+     * @brief Plays two engine configurations against each other in this process. Every opening is played
+     *        with both colors, so the openings do not favor one engine. The pairs of games are played in parallel,
+     *        both games of a pair one after the other, so a stopped match never ends with half a pair.
+     */
+    class Match
+    {
+    public:
+        struct Settings
+        {
+            uint32_t numberOfGames = 100; ///< maximum, if the SPRT stops the match earlier
+            uint32_t concurrency = 1;
+            uint32_t maximumNumberOfPlies = SelfPlay::DefaultMaximumNumberOfPlies;
+            std::optional<Adjudication> adjudication = Adjudication{};
+            std::optional<Sprt> sprt{};
+        };
+
+        /**
+         * @throws std::invalid_argument if there are no openings
+         */
+        Match(Settings settings, EngineConfiguration first, EngineConfiguration second, std::vector<GameState> openings);
+
+        /**
+         * @param onGameFinished called after every game with the game, the index of the game and the result so far.
+         *        The calls are serialized.
+         * @return result of all finished games
+         */
+        MatchResult run(const std::function<void(const SelfPlayGame &, uint32_t, const MatchResult &)> &onGameFinished = {});
+
+    private:
+        Settings m_settings;
+        EngineConfiguration m_first;
+        EngineConfiguration m_second;
+        std::vector<GameState> m_openings;
+    };
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <memory>
 #include <functional>
 #include <iostream>
+#include <string>
 
 namespace ModernChess
 {
@@ -35,20 +36,45 @@ namespace ModernChess
         template<typename T>
         static std::unique_ptr<T[], std::function<void(T*)>> alignedArray(size_t allocSizeBytes)
         {
-            T* ptr = static_cast<T*>(MemoryAllocator::alignedAllocRawPtr(allocSizeBytes));
+            auto array = tryAlignedArray<T>(allocSizeBytes);
 
-            if (not ptr)
+            if (not array)
             {
                 std::cerr << "Failed to allocate " << allocSizeBytes << " bytes!" << std::endl;
                 exit(EXIT_FAILURE);
             }
 
+            return array;
+        }
+
+        /**
+         * @return an empty pointer, if the memory cannot be allocated
+         */
+        template<typename T>
+        static std::unique_ptr<T[], std::function<void(T*)>> tryAlignedArray(size_t allocSizeBytes)
+        {
+            T* ptr = static_cast<T*>(MemoryAllocator::alignedAllocRawPtr(allocSizeBytes));
+
+            if (not ptr)
+            {
+                return nullptr;
+            }
+
             std::function<void(T*)> deleter = [](T *ptr) {
                 MemoryAllocator::alignedFree((void*) ptr);
             };
 
             return std::unique_ptr<T[], std::function<void(T*)>>(ptr, deleter);
         }
+
+        /**
+         * @brief Maps the file read-only into memory, so it is neither copied nor converted.
+         *        Without POSIX, the file is read into memory instead.
+         * @param sizeInBytes set to the size of the file
+         * @throws std::runtime_error if the file cannot be read
+         */
+        static std::shared_ptr<const uint8_t> mapFile(const std::string &path, size_t &sizeInBytes);
+
     private:
         static void* alignedAllocRawPtr(size_t allocSizeBytes);
 
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "GameState.h"
+#include "Move.h"
+#include "UCIParser.h"
+
+namespace ModernChess
+{
+    /**
+     * @brief Converts a UCI move into the internal move encoding by looking at the board directly,
+     *        instead of generating all pseudo moves and searching the matching one.
+     *        Pseudo legality is checked like in the move generation, e.g. blocked sliders or castling through
+     *        attacked squares. Whether the own king is in check afterwards is checked by MoveExecution.
+     */
+    class MoveDecoder
+    {
+    public:
+        MoveDecoder() = delete;
+
+        /**
+         * @return the null move, if the move is not pseudo legal in the given position
+         */
+        [[nodiscard]] static Move decodeMove(const GameState &gameState, const UCIParser::UCIMove &uciMove);
+
+    private:
+        [[nodiscard]] static Figure figureOnSquare(const Board &board, Color color, Square square);
+
+        [[nodiscard]] static Figure promotedFigure(Color color, char promotionCharacter);
+
+        [[nodiscard]] static Move decodePawnMove(const Board &board, Square from, Square to, char promotionCharacter);
+
+        [[nodiscard]] static Move decodeCastlingMove(const Board &board, Square from, Square to);
+    };
+}
\ No newline at end of file
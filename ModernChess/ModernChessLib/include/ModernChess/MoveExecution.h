@@ -3,6 +3,8 @@
 #include "GameState.h"
 #include "BitBoardOperations.h"
 #include "AttackQueries.h"
+#include "CheckInfo.h"
+#include "NeuralNetwork.h"
 
 namespace ModernChess
 {
@@ -27,7 +29,22 @@ namespace ModernChess
             return MoveExecution::executeMoveForBlack(gameState, move, moveType);
         }
 
-        static bool executeMoveForWhite(GameState &gameState, Move move, MoveType moveType)
+        /**
+         * @brief Same as above, but skips the king safety check, if the check info proves that the move is legal.
+         */
+        static bool executeMove(GameState &gameState, Move move, MoveType moveType, const CheckInfo &checkInfo)
+        {
+            const bool verifyKingSafety = not checkInfo.moveIsKnownToBeLegal(move);
+
+            if (gameState.board.sideToMove == Color::White)
+            {
+                return MoveExecution::executeMoveForWhite(gameState, move, moveType, verifyKingSafety);
+            }
+
+            return MoveExecution::executeMoveForBlack(gameState, move, moveType, verifyKingSafety);
+        }
+
+        static bool executeMoveForWhite(GameState &gameState, Move move, MoveType moveType, bool verifyKingSafety = true)
         {
             // make quiet or capture move
             if (moveType == MoveType::AllMoves or move.isCapture())
@@ -103,6 +120,7 @@ namespace ModernChess
 
                 // make sure that king has not been exposed into a check
                 if (const Square kingsSquare = BitBoardOperations::bitScanForward(gameState.board.bitboards[Figure::WhiteKing]);
+                        verifyKingSafety &&
                         AttackQueries::squareIsAttackedByBlack(gameState.board, kingsSquare))
                 {
                     // take move back
@@ -132,7 +150,7 @@ namespace ModernChess
             return false;
         }
 
-        static bool executeMoveForBlack(GameState &gameState, Move move, MoveType moveType)
+        static bool executeMoveForBlack(GameState &gameState, Move move, MoveType moveType, bool verifyKingSafety = true)
         {
             // make quiet or capture move
             if (moveType == MoveType::AllMoves or move.isCapture())
@@ -208,6 +226,7 @@ namespace ModernChess
 
                 // make sure that king has not been exposed into a check
                 if (const Square kingsSquare = BitBoardOperations::bitScanForward(gameState.board.bitboards[Figure::BlackKing]);
+                        verifyKingSafety &&
                         AttackQueries::squareIsAttackedByWhite(gameState.board, kingsSquare))
                 {
                     // take move back
@@ -272,6 +291,11 @@ namespace ModernChess
 
             // remove the figure from hash key
             gameState.gameStateHash ^= ZobristHasher::pieceKeys[figure][square];
+
+            if (gameState.accumulator != nullptr)
+            {
+                gameState.accumulator->removeFigure(figure, square);
+            }
         }
 
         static void addToBitboards(GameState &gameState, Figure figure, Color color, Square square)
@@ -282,6 +306,11 @@ namespace ModernChess
 
             // set figure to the target square in hash key
             gameState.gameStateHash ^= ZobristHasher::pieceKeys[figure][square];
+
+            if (gameState.accumulator != nullptr)
+            {
+                gameState.accumulator->addFigure(figure, square);
+            }
         }
     };
 }
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Board.h"
+#include "Color.h"
+#include "Figure.h"
+#include "GlobalConstants.h"
+#include "Square.h"
+
+#include <array>
+#include <cinttypes>
+#include <memory>
+#include <string>
+
+namespace ModernChess
+{
+    class NeuralNetwork;
+
+    /**
+     * @brief Output of the first layer of the neural network for both perspectives.
+     *        MoveExecution adds and removes the weights of every figure, which is put on or taken from a square,
+     *        so the first layer is not recomputed for every evaluation. The search keeps one accumulator per ply
+     *        and lets the game state point to the accumulator of the current ply, see GameState::accumulator.
+     */
+    struct Accumulator
+    {
+        static constexpr size_t HiddenSize = 64;
+
+        // Assigned by NeuralNetwork::refresh()
+        const NeuralNetwork *network = nullptr;
+        // [perspective][neuron]
+        std::array<std::array<int16_t, HiddenSize>, 2> values{};
+
+        void addFigure(Figure figure, Square square);
+
+        void removeFigure(Figure figure, Square square);
+
+        bool operator==(const Accumulator &other) const = default;
+    };
+
+    /**
+     * @brief Efficiently updatable neural network (NNUE) with the architecture 768 -> 2x64 -> 1.
+     *        The input features are the figures on their squares from the view of each side, i.e. the board
+     *        is mirrored and the colors are swapped for the perspective of black. The hidden neurons are clipped
+     *        to [0, 127] and multiplied by int8 weights. The perspective of the side to move comes first.
+     *
+     *        The kernels use AVX2 or SSE4.1, if the build enables them (see MODERN_CHESS_NATIVE_ARCH),
+     *        otherwise plain loops.
+     * @see https://www.chessprogramming.org/NNUE
+     */
+    class NeuralNetwork
+    {
+    public:
+        static constexpr size_t NumberOfFeatures = size_t(NumberOfFigureTypes) * NumberOfSquares;
+        static constexpr size_t HiddenSize = Accumulator::HiddenSize;
+        static constexpr int16_t ClippingLimit = 127;
+        // The score is (output bias + output) * output scale / OutputScaleDivisor
+        static constexpr int32_t OutputScaleDivisor = 64;
+
+        /**
+         * @brief Built-in network, which is not trained, but generated from the material and piece-square tables
+         *        of the handcrafted evaluation. It evaluates like Evaluation::evaluatePosition() up to +-40 pawns
+         *        and is the baseline for the speed of the network evaluation.
+         */
+        static std::shared_ptr<const NeuralNetwork> defaultNetwork();
+
+        /**
+         * @brief Maps the file into memory, so the weights are neither copied nor converted.
+         *        The format is described in NeuralNetwork.cpp.
+         * @throws std::runtime_error if the file cannot be read or has another architecture
+         */
+        static std::shared_ptr<const NeuralNetwork> load(const std::string &path);
+
+        /**
+         * @brief Writes the network in the format of load()
+         * @throws std::runtime_error
+         */
+        void save(const std::string &path) const;
+
+        /**
+         * @brief Recomputes the accumulator from scratch and assigns this network to it, so it can be updated
+         *        incrementally from now on. The network has to outlive the accumulator.
+         */
+        void refresh(Accumulator &accumulator, const Board &board) const;
+
+        /**
+         * @return score in centipawns from the view of the side to move
+         */
+        [[nodiscard]] int32_t evaluate(const Accumulator &accumulator, Color sideToMove) const;
+
+        void addFigure(Accumulator &accumulator, Figure figure, Square square) const;
+
+        void removeFigure(Accumulator &accumulator, Figure figure, Square square) const;
+
+    private:
+        // The mapped file or the memory of the generated network. It owns the weights.
+        std::shared_ptr<const uint8_t> m_memory;
+        size_t m_sizeInBytes{};
+        const int16_t *m_featureBiases{};
+        // [feature][neuron]
+        const int16_t *m_featureWeights{};
+        // [perspective][neuron]
+        const int8_t *m_outputWeights{};
+        int32_t m_outputBias{};
+        int32_t m_outputScale{};
+
+        /**
+         * @throws std::runtime_error if the memory does not contain a network of this architecture
+         */
+        NeuralNetwork(std::shared_ptr<const uint8_t> memory, size_t sizeInBytes);
+
+        [[nodiscard]] static size_t featureIndex(Color perspective, Figure figure, Square square);
+    };
+
+    inline void Accumulator::addFigure(Figure figure, Square square)
+    {
+        network->addFigure(*this, figure, square);
+    }
+
+    inline void Accumulator::removeFigure(Figure figure, Square square)
+    {
+        network->removeFigure(*this, figure, square);
+    }
+}
\ No newline at end of file
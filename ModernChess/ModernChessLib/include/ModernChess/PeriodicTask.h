@@ -60,11 +60,13 @@ namespace ModernChess
             while (continueTask)
             {
                 std::unique_lock lock(m_mutex);
-                m_triggered.waitFor(lock, m_period, [this, &continueTask]
+                // The predicate has to be true in order to stop waiting, so the task is only
+                // executed once per period and leaves immediately after being stopped.
+                m_triggered.waitFor(lock, m_period, [this]
                 {
-                    continueTask = not m_isStopped;
-                    return continueTask;
+                    return m_isStopped;
                 });
+                continueTask = not m_isStopped;
                 lock.unlock();
 
                 if (continueTask)
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "GameState.h"
+#include "Move.h"
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ModernChess
+{
+    /**
+     * @brief Entry of an opening book in the Polyglot format. In the file, the entries are sorted by key
+     *        and all values are big-endian.
+     */
+    struct PolyglotEntry
+    {
+        uint64_t key{}; ///< see PolyglotHasher
+        uint16_t move{}; ///< see PolyglotBook::encodeMove()
+        uint16_t weight{}; ///< moves of weight 0 are not played
+        uint32_t learn{};
+
+        bool operator==(const PolyglotEntry &other) const = default;
+    };
+
+    /**
+     * @brief Read-only opening book in the Polyglot format. The file is mapped into memory and the entries
+     *        of a position are found by binary search, so even big books are neither read nor parsed on loading.
+     * @see http://hgm.nubati.net/book_format.html
+     */
+    class PolyglotBook
+    {
+    public:
+        static constexpr size_t EntrySize = 16;
+
+        /**
+         * @throws std::runtime_error if the file cannot be read or is not a sequence of entries
+         */
+        static std::shared_ptr<const PolyglotBook> load(const std::string &path);
+
+        /**
+         * @brief Writes the entries in the format of load(). They are sorted by key before.
+         * @throws std::runtime_error
+         */
+        static void save(const std::string &path, std::vector<PolyglotEntry> entries);
+
+        [[nodiscard]] size_t numberOfEntries() const
+        {
+            return m_numberOfEntries;
+        }
+
+        [[nodiscard]] PolyglotEntry entry(size_t index) const;
+
+        /**
+         * @return all entries of the key in the order of the file
+         */
+        [[nodiscard]] std::vector<PolyglotEntry> findEntries(uint64_t key) const;
+
+        /**
+         * @brief Chooses one of the legal book moves of the position randomly. The more weight an entry has,
+         *        the more often its move is chosen.
+         * @param randomNumber e.g. 0 always chooses the first book move
+         * @return the null move, if the position has no legal book move
+         */
+        [[nodiscard]] Move chooseMove(const GameState &gameState, uint32_t randomNumber) const;
+
+        /**
+         * @return the move in 16 bits: target square, source square and promoted figure with 3 bits for each
+         *         file and rank. Castling is encoded as the king capturing its own rook, e.g. e1h1.
+         */
+        [[nodiscard]] static uint16_t encodeMove(Move move);
+
+        /**
+         * @return the null move, if the move is not pseudo legal in the given position
+         */
+        [[nodiscard]] static Move decodeMove(const GameState &gameState, uint16_t polyglotMove);
+
+    private:
+        PolyglotBook(std::shared_ptr<const uint8_t> memory, size_t numberOfEntries);
+
+        [[nodiscard]] uint64_t keyAt(size_t index) const;
+
+        std::shared_ptr<const uint8_t> m_memory;
+        size_t m_numberOfEntries;
+    };
+}
\ No newline at end of file
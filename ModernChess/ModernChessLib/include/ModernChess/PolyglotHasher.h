@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Figure.h"
+#include "GlobalConstants.h"
+#include "Square.h"
+
+#include <array>
+#include <cstddef>
+
+namespace ModernChess {
+    class Board;
+
+    /**
+     * @brief Hash keys of opening books in the Polyglot format. Unlike ZobristHasher, the layout of the keys is
+     *        fixed by the format, so the keys of a position are the same in every program.
+     * @see http://hgm.nubati.net/book_format.html
+     */
+    class PolyglotHasher {
+    public:
+        // 12 figures on 64 squares, 4 castling rights, 8 en passant files and the side to move
+        static constexpr size_t NumberOfKeys = 781;
+        static constexpr size_t CastlingKeysOffset = 768;
+        static constexpr size_t EnPassantKeysOffset = 772;
+        static constexpr size_t SideKeyOffset = 780;
+
+        PolyglotHasher() = delete;
+
+        static uint64_t generateHash(const Board &board);
+
+        /**
+         * @return index of the figure on the square in randomKeys
+         */
+        static size_t figureKeyIndex(Figure figure, Square square);
+
+        // "Random64" of the specification: [figure key index | castling keys | en passant keys | side key]
+        static const std::array<uint64_t, NumberOfKeys> randomKeys;
+    };
+}
\ No newline at end of file
@@ -41,7 +41,23 @@ namespace ModernChess {
             return n1 | (n2 << 16) | (n3 << 32) | (n4 << 48);
         }
 
+        /**
+         * @brief 64-bit pseudo random numbers of the xorshift* algorithm. In contrast to getRandomU64Number(), the
+         *        numbers are not derived from a 32-bit state, hence they are not linearly dependent on each other,
+         *        which is required for hash keys.
+         * @see https://www.chessprogramming.org/Pseudorandom_Number_Generator#Xorshift
+         */
+        [[nodiscard]] uint64_t getRandomU64NumberXorShiftStar()
+        {
+            state64 ^= state64 >> 12;
+            state64 ^= state64 << 25;
+            state64 ^= state64 >> 27;
+
+            return state64 * 2685821657736338717ULL;
+        }
+
     private:
         uint32_t state = 1804289383; // initial state
+        uint64_t state64 = 1070372; // initial state of xorshift*
     };
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "HistoryTables.h"
+#include "NeuralNetwork.h"
+#include "SearchParameters.h"
+#include "TranspositionTable.h"
+
+#include <memory>
+
+namespace ModernChess
+{
+    /**
+     * @brief Tables of one engine, which are filled by its searches. Every engine of a process needs its own
+     *        context, otherwise the engines overwrite each other's entries. Only one search may use a context
+     *        at a time. The Zobrist keys and the attack tables are constant, so they are shared by all engines.
+     */
+    class SearchContext
+    {
+    public:
+        explicit SearchContext(size_t transpositionTableSizeInMB = TranspositionTable::DefaultSizeInMB) :
+                m_transpositionTable(transpositionTableSizeInMB),
+                m_historyTables(std::make_unique<HistoryTables>())
+        {}
+
+        /**
+         * @brief Kept between the searches, e.g. for the moves of one game
+         */
+        [[nodiscard]] TranspositionTable &transpositionTable()
+        {
+            return m_transpositionTable;
+        }
+
+        /**
+         * @brief Reset at the beginning of every search
+         */
+        [[nodiscard]] HistoryTables &historyTables()
+        {
+            return *m_historyTables;
+        }
+
+        /**
+         * @return network of the evaluation or nullptr for the handcrafted evaluation
+         */
+        [[nodiscard]] const NeuralNetwork *neuralNetwork() const
+        {
+            return m_neuralNetwork.get();
+        }
+
+        /**
+         * @param neuralNetwork nullptr switches back to the handcrafted evaluation
+         */
+        void setNeuralNetwork(std::shared_ptr<const NeuralNetwork> neuralNetwork)
+        {
+            m_neuralNetwork = std::move(neuralNetwork);
+        }
+
+        [[nodiscard]] const SearchParameters &searchParameters() const
+        {
+            return m_searchParameters;
+        }
+
+        /**
+         * @brief Used by the next search
+         */
+        void setSearchParameters(const SearchParameters &searchParameters)
+        {
+            m_searchParameters = searchParameters;
+        }
+
+        /**
+         * @brief Forgets all positions, e.g. for a new game. Searches, which start with a cleared context,
+         *        do not depend on the previous searches.
+         */
+        void clear()
+        {
+            m_transpositionTable.clear();
+            m_historyTables->clear();
+        }
+
+    private:
+        TranspositionTable m_transpositionTable;
+        // Allocated on the heap due to its size
+        std::unique_ptr<HistoryTables> m_historyTables;
+        std::shared_ptr<const NeuralNetwork> m_neuralNetwork;
+        SearchParameters m_searchParameters;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cinttypes>
+#include <string_view>
+
+namespace ModernChess
+{
+    /**
+     * @brief Constants of the pruning and of the move ordering of the search, which can be changed at runtime,
+     *        e.g. by the UCI options of the same name or by the SPSA tuner. The defaults are the hand-picked values.
+     */
+    struct SearchParameters
+    {
+        // Late move reductions: The first moves and the nodes near the horizon are searched with full depth
+        int32_t numberOfMovesForFullDepthSearch = 3;
+        int32_t minimumDepthForFullDepthSearch = 2;
+
+        // Null move pruning
+        int32_t minimumDepthForNullMovePruning = 3;
+        int32_t nullMovePruningDepthReduction = 2;
+
+        // Move ordering: The MVV-LVA score of a capture is added to the offset. Quiet moves without these
+        // scores are ordered by their history scores, see HistoryTables.
+        int32_t captureScoreOffset = 100'000;
+        int32_t bestKillerMoveScore = 90'000;
+        int32_t secondBestKillerMoveScore = 80'000;
+        int32_t counterMoveScore = 70'000;
+
+        bool operator==(const SearchParameters &other) const = default;
+    };
+
+    /**
+     * @brief Parameter of SearchParameters with the range, in which it is tuned
+     */
+    struct TunableSearchParameter
+    {
+        std::string_view name;
+        int32_t SearchParameters::*value;
+        int32_t minimum;
+        int32_t maximum;
+        double perturbation; ///< initial perturbation of SPSA, see SpsaTuner
+    };
+
+    // The names are the UCI options. None of them is a prefix of another one.
+    inline constexpr std::array<TunableSearchParameter, 8> TunableSearchParameters{{
+        {"NumberOfMovesForFullDepthSearch", &SearchParameters::numberOfMovesForFullDepthSearch, 1, 20, 1.5},
+        {"MinimumDepthForFullDepthSearch", &SearchParameters::minimumDepthForFullDepthSearch, 1, 8, 1.0},
+        {"MinimumDepthForNullMovePruning", &SearchParameters::minimumDepthForNullMovePruning, 2, 8, 1.0},
+        {"NullMovePruningDepthReduction", &SearchParameters::nullMovePruningDepthReduction, 1, 5, 0.75},
+        {"CaptureScoreOffset", &SearchParameters::captureScoreOffset, 50'000, 150'000, 10'000},
+        {"BestKillerMoveScore", &SearchParameters::bestKillerMoveScore, 0, 99'000, 8'000},
+        {"SecondBestKillerMoveScore", &SearchParameters::secondBestKillerMoveScore, 0, 99'000, 8'000},
+        {"CounterMoveScore", &SearchParameters::counterMoveScore, 0, 99'000, 8'000}
+    }};
+}
\ No newline at end of file
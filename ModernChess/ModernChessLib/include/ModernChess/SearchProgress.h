@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Move.h"
+
+#include <atomic>
+#include <cinttypes>
+
+namespace ModernChess
+{
+    /**
+     * @brief Progress of a running search. It is written by the search thread and can be read by other threads
+     *        without locking, e.g. in order to report the progress periodically to the UI.
+     */
+    struct SearchProgress
+    {
+        std::atomic<uint64_t> numberOfNodes{};
+        std::atomic<uint32_t> depth{};
+        std::atomic<Move> currentMove{}; ///< root move which is searched at the moment
+        std::atomic<uint32_t> currentMoveNumber{}; ///< starts with 1 for the first root move
+        std::atomic<uint32_t> hashfull{}; ///< occupancy of the transposition table in permille
+    };
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "GameState.h"
+#include "Move.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ModernChess {
+
+    /**
+     * @brief Limits of a search task. Both limits are enforced by the scheduler whenever the task yields,
+     *        so they may be exceeded by up to one time slice.
+     */
+    struct SearchTaskLimits {
+        uint8_t depth = 6;
+        uint64_t nodes = std::numeric_limits<uint64_t>::max(); ///< no node budget by default
+        std::chrono::milliseconds time{0}; ///< deadline relative to the submission. 0: no deadline
+    };
+
+    struct SearchTaskResult {
+        Move bestMove{}; ///< null move, if there is no legal move or if the deadline was over before the start
+        int32_t score{};
+        uint32_t depth{}; ///< last completed iteration
+        uint64_t numberOfNodes{}; ///< all searched nodes including the ones of an interrupted iteration
+        std::chrono::milliseconds latency{}; ///< from the submission to the result
+        bool completed{}; ///< false, if the node budget or the deadline stopped the search
+    };
+
+    /**
+     * @brief Runs many short searches concurrently on a few threads, e.g. for a hint service.
+     *        Every search is a stackful coroutine, which yields after every time slice of nodes. Every worker
+     *        thread resumes its active tasks in turn, so a long search cannot starve the others.
+     *        The number of active tasks per thread is limited. Their search contexts and stacks are reused,
+     *        so the memory does not grow with the number of submitted tasks.
+     */
+    class SearchScheduler {
+    public:
+        static constexpr uint64_t DefaultTimeSliceInNodes = 2048;
+        static constexpr uint32_t DefaultMaxActiveTasksPerThread = 8;
+        static constexpr size_t DefaultHashSizePerTaskInMB = 1;
+
+        explicit SearchScheduler(uint32_t numberOfThreads,
+                                 uint64_t timeSliceInNodes = DefaultTimeSliceInNodes,
+                                 uint32_t maxActiveTasksPerThread = DefaultMaxActiveTasksPerThread,
+                                 size_t hashSizePerTaskInMB = DefaultHashSizePerTaskInMB);
+
+        /**
+         * @brief Stops all tasks. Their results are delivered with completed == false.
+         */
+        ~SearchScheduler();
+
+        SearchScheduler(const SearchScheduler &) = delete;
+        SearchScheduler &operator=(const SearchScheduler &) = delete;
+
+        /**
+         * @brief Searches with iterative deepening up to the depth of the limits. Thread-safe.
+         */
+        [[nodiscard]] std::future<SearchTaskResult> submit(const GameState &gameState, const SearchTaskLimits &limits);
+
+        /**
+         * @return number of tasks, which have not been started yet
+         */
+        [[nodiscard]] size_t numberOfPendingTasks() const;
+
+    private:
+        struct Task;
+        struct Worker;
+
+        uint64_t m_timeSliceInNodes;
+        uint32_t m_maxActiveTasksPerThread;
+        size_t m_hashSizePerTaskInMB;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_taskHasBeenSubmitted;
+        std::deque<std::unique_ptr<Task>> m_pendingTasks;
+        bool m_stopped = false;
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::vector<std::thread> m_threads;
+
+        void runWorker(Worker &worker);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cinttypes>
+#include <ostream>
+#include <vector>
+
+namespace ModernChess
+{
+    // The counters can be compiled out with the CMake option MODERN_CHESS_SEARCH_STATISTICS=OFF
+#if defined(MODERN_CHESS_SEARCH_STATISTICS)
+    constexpr bool SearchStatisticsEnabled = true;
+#else
+    constexpr bool SearchStatisticsEnabled = false;
+#endif
+
+    inline void countStatistic(uint64_t &counter)
+    {
+        if constexpr (SearchStatisticsEnabled)
+        {
+            ++counter;
+        }
+    }
+
+    /**
+     * @brief Counters, which show why a search is slow, e.g. the quality of the move ordering
+     *        by the rate of beta cutoffs caused by the first move.
+     */
+    struct SearchStatistics
+    {
+        uint64_t transpositionTableProbes{};
+        uint64_t transpositionTableHits{}; ///< an entry of the position has been found
+        uint64_t transpositionTableCutoffs{}; ///< the score of the entry has been returned
+        uint64_t betaCutoffs{};
+        uint64_t firstMoveBetaCutoffs{}; ///< beta cutoffs caused by the first searched move
+        uint64_t nullMoveAttempts{};
+        uint64_t nullMoveCutoffs{};
+        uint64_t lateMoveReductions{};
+        uint64_t lateMoveReductionReSearches{}; ///< reduced searches, which had to be repeated with full depth
+        uint64_t principalVariationReSearches{}; ///< null window searches, which had to be repeated with full window
+        uint64_t mainNodes{};
+        uint64_t quiescenceNodes{};
+        std::vector<uint64_t> nodesPerDepth{}; ///< nodes of the iteration of the given depth
+
+        /**
+         * @return percentage of beta cutoffs caused by the first move. The higher, the better is the move ordering.
+         */
+        [[nodiscard]] double firstMoveCutoffRate() const;
+
+        /**
+         * @return nodes of the iteration of the given depth divided by the nodes of the previous iteration.
+         *         0, if unknown.
+         * @see https://www.chessprogramming.org/Branching_Factor#EffectiveBranchingFactor
+         */
+        [[nodiscard]] double effectiveBranchingFactor(size_t depth) const;
+
+        SearchStatistics &operator+=(const SearchStatistics &other);
+
+        void printAsInfoStrings(std::ostream &outputStream) const;
+
+        void writeJson(std::ostream &outputStream) const;
+    };
+}
\ No newline at end of file
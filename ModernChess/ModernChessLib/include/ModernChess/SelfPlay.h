@@ -0,0 +1,148 @@
+#pragma once
+
+#include "GameState.h"
+#include "Move.h"
+#include "NeuralNetwork.h"
+#include "SearchContext.h"
+#include "SearchParameters.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ModernChess
+{
+    /**
+     * @brief Clock of one side: The base time for the whole game plus the increment after every move
+     */
+    struct TimeControl
+    {
+        std::chrono::milliseconds baseTime{0}; ///< 0: no time control
+        std::chrono::milliseconds increment{0};
+
+        [[nodiscard]] bool isEnabled() const
+        {
+            return baseTime > std::chrono::milliseconds(0);
+        }
+    };
+
+    /**
+     * @brief Settings of one side of a self-play game
+     */
+    struct EngineConfiguration
+    {
+        std::string name = "ModernChess";
+        SearchParameters searchParameters{};
+        std::shared_ptr<const NeuralNetwork> neuralNetwork{}; ///< nullptr for the handcrafted evaluation
+        uint64_t nodesPerMove = 10'000; ///< the search does not depend on the speed of the machine or on the load
+        TimeControl timeControl{}; ///< additionally to the node limit, if enabled
+        size_t hashSizeInMB = 1;
+    };
+
+    /**
+     * @brief Ends games early, whose result is clear to both engines. The scores are in centipawns.
+     */
+    struct Adjudication
+    {
+        // Both engines see one side ahead by at least this score for the number of plies in a row, e.g. a mate
+        int32_t winScore = 1'000;
+        uint32_t winNumberOfPlies = 6;
+        // Both engines see a balanced position for the number of plies in a row after the minimum number of plies
+        int32_t drawScore = 10;
+        uint32_t drawNumberOfPlies = 16;
+        uint32_t drawMinimumNumberOfPlies = 80;
+    };
+
+    enum class GameResult : uint8_t
+    {
+        WhiteWins,
+        BlackWins,
+        Draw
+    };
+
+    enum class GameTermination : uint8_t
+    {
+        Checkmate,
+        Stalemate,
+        FiftyMoveRule,
+        ThreefoldRepetition,
+        InsufficientMaterial,
+        MaximumLength, ///< adjudicated as draw
+        AdjudicatedWin,
+        AdjudicatedDraw,
+        TimeForfeit
+    };
+
+    std::ostream &operator<<(std::ostream &os, GameTermination termination);
+
+    struct SelfPlayGame
+    {
+        GameResult result{};
+        GameTermination termination{};
+        std::vector<Move> moves;
+    };
+
+    struct SearchedMove
+    {
+        Move move{}; ///< null move, if there is no legal move
+        int32_t score{}; ///< from the view of the side to move
+    };
+
+    /**
+     * @brief Plays games between two engine configurations in the calling thread, so many games can be played
+     *        in parallel. Every side searches with its own search context, which is kept for the whole game.
+     */
+    class SelfPlay
+    {
+    public:
+        static constexpr uint32_t DefaultMaximumNumberOfPlies = 400;
+
+        /**
+         * @param startPosition e.g. an opening. Its half move clock is taken for the fifty-move rule.
+         * @param adjudication the games are played until the end by the rules, if there is none
+         */
+        [[nodiscard]] static SelfPlayGame playGame(const GameState &startPosition,
+                                                   const EngineConfiguration &white,
+                                                   const EngineConfiguration &black,
+                                                   uint32_t maximumNumberOfPlies = DefaultMaximumNumberOfPlies,
+                                                   const std::optional<Adjudication> &adjudication = std::nullopt);
+
+        /**
+         * @brief Searches with iterative deepening until the node limit or the time limit has been reached.
+         *        No new iteration is started after half of the time.
+         * @param timeLimit 0: no time limit
+         * @return best move of the last completed iteration
+         */
+        [[nodiscard]] static SearchedMove searchMove(SearchContext &searchContext,
+                                                     const GameState &gameState,
+                                                     uint64_t numberOfNodes,
+                                                     std::chrono::milliseconds timeLimit = std::chrono::milliseconds(0));
+
+        /**
+         * @return time for the next move: a share of the remaining time plus most of the increment
+         */
+        [[nodiscard]] static std::chrono::milliseconds allocateTime(std::chrono::milliseconds remainingTime,
+                                                                    std::chrono::milliseconds increment);
+
+        /**
+         * @brief Reads one FEN or EPD per line. Empty lines are skipped.
+         * @throws std::runtime_error if a line does not contain a position
+         */
+        [[nodiscard]] static std::vector<GameState> readOpenings(std::istream &inputStream);
+
+        /**
+         * @return all legal moves of the position
+         */
+        [[nodiscard]] static std::vector<Move> generateLegalMoves(const GameState &gameState);
+
+        /**
+         * @return true, if neither side can checkmate, e.g. king and bishop versus king
+         */
+        [[nodiscard]] static bool hasInsufficientMaterial(const Board &board);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "GameState.h"
+#include "SearchParameters.h"
+#include "SelfPlay.h"
+
+#include <array>
+#include <cinttypes>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace ModernChess
+{
+    class ThreadPool;
+
+    /**
+     * @brief Simultaneous perturbation stochastic approximation (SPSA) of the TunableSearchParameters by self-play:
+     *        Every iteration perturbs all parameters at once in random directions and lets the perturbed
+     *        parameters play game pairs against the oppositely perturbed ones. All parameters are moved
+     *        towards the winner. The games are played in parallel on all cores.
+     *
+     *        The games are played with a fixed number of nodes per move. Parameters, which prune more, search
+     *        deeper with the same number of nodes, so they only win, if they do not lose strength.
+     * @see https://www.chessprogramming.org/SPSA
+     */
+    class SpsaTuner
+    {
+    public:
+        struct Settings
+        {
+            uint32_t numberOfThreads = 1;
+            uint32_t numberOfIterations = 1'000;
+            uint32_t numberOfGamePairsPerIteration = 8; ///< every opening is played with both colors
+            uint64_t nodesPerMove = 5'000;
+            uint32_t maximumNumberOfPlies = SelfPlay::DefaultMaximumNumberOfPlies;
+            /// Change of a parameter in the first iteration in units of its perturbation, if the
+            /// perturbed parameters win all games
+            double learningRate = 1.0;
+            uint64_t seed = 1;
+        };
+
+        using Values = std::array<double, TunableSearchParameters.size()>;
+
+        /**
+         * @param openings start positions of the games, which are played in turn
+         * @throws std::invalid_argument if there are no openings
+         */
+        SpsaTuner(Settings settings, std::vector<GameState> openings);
+
+        ~SpsaTuner();
+
+        /**
+         * @param logStream the values are written after every tenth iteration
+         * @return the converged values rounded to the next valid values
+         */
+        [[nodiscard]] SearchParameters tune(const SearchParameters &initialParameters, std::ostream &logStream);
+
+        /**
+         * @return values rounded and clamped to the range of every parameter
+         */
+        [[nodiscard]] static SearchParameters toSearchParameters(const Values &values);
+
+        [[nodiscard]] static Values toValues(const SearchParameters &searchParameters);
+
+    private:
+        Settings m_settings;
+        std::vector<GameState> m_openings;
+        size_t m_nextOpening{};
+        std::unique_ptr<ThreadPool> m_threadPool;
+
+        /**
+         * @return points of the first parameters minus points of the second parameters divided by the number of games
+         */
+        [[nodiscard]] double playGamePairs(const SearchParameters &first, const SearchParameters &second);
+    };
+}
\ No newline at end of file
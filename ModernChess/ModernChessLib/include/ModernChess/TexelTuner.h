@@ -0,0 +1,185 @@
+#pragma once
+
+#include "BitBoardOperations.h"
+#include "GameState.h"
+#include "GlobalConstants.h"
+
+#include <array>
+#include <cinttypes>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ModernChess
+{
+    class ThreadPool;
+
+    /**
+     * @brief Material and positional scores of the handcrafted evaluation as real numbers, which can be optimized.
+     *        The evaluation is linear in these parameters.
+     */
+    class TexelParameters
+    {
+    public:
+        // Material of pawn, knight, bishop, rook and queen. Both sides always have a king.
+        static constexpr size_t NumberOfMaterialScores = 5;
+        // Positional scores of pawn, knight, bishop, rook and king. The queen has none.
+        static constexpr size_t NumberOfPositionalTables = 5;
+        static constexpr size_t NumberOfParameters = NumberOfMaterialScores + NumberOfPositionalTables * NumberOfSquares;
+        static constexpr size_t NoParameter = NumberOfParameters;
+
+        /**
+         * @return the parameters of EvaluationParameters.h
+         */
+        static TexelParameters fromEvaluation();
+
+        [[nodiscard]] double &operator[](size_t index) { return m_values[index]; }
+
+        [[nodiscard]] double operator[](size_t index) const { return m_values[index]; }
+
+        /**
+         * @return index of the material score of the figure or NoParameter for kings
+         */
+        [[nodiscard]] static size_t materialIndex(Figure figure);
+
+        /**
+         * @param square from the view of white, i.e. mirrored for black figures
+         * @return index of the positional score of the figure on the square or NoParameter for queens
+         */
+        [[nodiscard]] static size_t positionalIndex(Figure figure, Square square);
+
+        /**
+         * @return static evaluation from the view of white, like Evaluation::evaluatePosition() does it
+         */
+        [[nodiscard]] double evaluate(const Board &board) const;
+
+        /**
+         * @brief Writes the parameters rounded to centipawns as EvaluationParameters.h. The MVV-LVA table is
+         *        derived from the material scores, because the game results say nothing about the move ordering.
+         */
+        void writeHeader(std::ostream &outputStream) const;
+
+    private:
+        std::array<double, NumberOfParameters> m_values{};
+    };
+
+    /**
+     * @brief Position of the training data in 32 bytes, so tens of millions of positions fit into the memory.
+     *        The figures of the occupied squares are stored as nibbles in the order of the squares.
+     */
+    struct PackedPosition
+    {
+        static constexpr uint32_t MaxNumberOfFigures = 32;
+
+        BitBoardState occupancy{};
+        std::array<uint8_t, MaxNumberOfFigures / 2> figures{};
+        // 0 = black wins, 1 = draw, 2 = white wins
+        uint8_t result{};
+
+        /**
+         * @return std::nullopt, if the board has more than MaxNumberOfFigures figures
+         */
+        static std::optional<PackedPosition> pack(const Board &board, uint8_t result);
+
+        [[nodiscard]] Board unpack() const;
+
+        /**
+         * @return result from the view of white: 0, 0.5 or 1
+         */
+        [[nodiscard]] double score() const
+        {
+            return result / 2.0;
+        }
+
+        /**
+         * @brief Calls visitor(figure, square) for every figure on the board
+         */
+        template<typename Visitor>
+        void forEachFigure(Visitor &&visitor) const;
+    };
+
+    /**
+     * @brief Texel's tuning method: The parameters of the evaluation are optimized, so the evaluation predicts
+     *        the results of the games, from which the positions are taken. Every position is resolved by a
+     *        quiescence search first, so only quiet positions are evaluated.
+     *        The mean squared error is minimized by gradient descent with Adam on all cores.
+     * @see https://www.chessprogramming.org/Texel%27s_Tuning_Method
+     */
+    class TexelTuner
+    {
+    public:
+        struct Settings
+        {
+            uint32_t numberOfThreads = 1;
+            uint32_t numberOfEpochs = 500;
+            double learningRate = 1.0; ///< maximum change of a parameter per epoch in centipawns
+            bool resolveQuiescence = true;
+        };
+
+        explicit TexelTuner(Settings settings);
+
+        ~TexelTuner();
+
+        /**
+         * @brief Reads lines with a FEN and the result of the game, e.g. "<FEN> [0.5]", "<FEN> [1-0]" or
+         *        the EPD operation c9 "1/2-1/2". Lines without result or with an invalid FEN are skipped.
+         * @return number of the loaded positions
+         */
+        size_t loadPositions(std::istream &inputStream);
+
+        [[nodiscard]] size_t numberOfPositions() const;
+
+        [[nodiscard]] size_t numberOfSkippedLines() const;
+
+        /**
+         * @return K, which maps the evaluation to the expected result with 1 / (1 + 10^(-K * evaluation / 400)).
+         *         It is chosen, so the parameters have the smallest error.
+         */
+        [[nodiscard]] double findScalingConstant(const TexelParameters &parameters) const;
+
+        [[nodiscard]] double meanSquaredError(const TexelParameters &parameters, double scalingConstant) const;
+
+        /**
+         * @brief Runs the configured number of epochs. Every epoch uses all positions.
+         * @param logStream the error is written after every tenth epoch
+         */
+        [[nodiscard]] TexelParameters tune(const TexelParameters &initialParameters, std::ostream &logStream) const;
+
+        /**
+         * @return FEN and result of the line from the view of white: 0, 1 or 2 for a loss, a draw or a win.
+         *         std::nullopt, if the line has no FEN or no result. The FEN is not validated.
+         */
+        [[nodiscard]] static std::optional<std::pair<std::string, uint8_t>> parseLine(std::string_view line);
+
+    private:
+        Settings m_settings;
+        std::vector<PackedPosition> m_positions;
+        size_t m_numberOfSkippedLines{};
+        std::unique_ptr<ThreadPool> m_threadPool;
+
+        /**
+         * @brief Sums up the values of all positions in parallel
+         */
+        template<typename Result, typename Function>
+        [[nodiscard]] Result sumOverPositions(Function &&function) const;
+    };
+
+    template<typename Visitor>
+    void PackedPosition::forEachFigure(Visitor &&visitor) const
+    {
+        size_t figureIndex = 0;
+
+        for (BitBoardState bitboard = occupancy; bitboard != BoardState::empty; ++figureIndex)
+        {
+            const Square square = BitBoardOperations::bitScanForward(bitboard);
+            bitboard = BitBoardOperations::eraseSquare(bitboard, square);
+            const uint8_t figure = (figures[figureIndex / 2] >> (4 * (figureIndex % 2))) & 0xf;
+            visitor(Figure(figure), square);
+        }
+    }
+}
\ No newline at end of file
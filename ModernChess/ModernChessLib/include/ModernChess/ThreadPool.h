@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ModernChess
+{
+    /**
+     * @brief Work-stealing thread pool: Every worker has its own deque of tasks. A worker executes its newest task
+     *        first, because it belongs to the subproblem it has just split up. Idle workers steal the oldest tasks
+     *        of the others, which are usually the biggest ones.
+     *        Tasks of threads outside the pool are distributed round robin.
+     * @see TaskGroup for fork-join
+     * @see https://en.wikipedia.org/wiki/Work_stealing
+     */
+    class ThreadPool
+    {
+    public:
+        static constexpr uint32_t NoWorker = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @param pinThreads binds every worker to its own CPU on Linux. Ignored on other platforms.
+         */
+        explicit ThreadPool(uint32_t numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u),
+                            bool pinThreads = false);
+
+        /**
+         * @brief Waits until all tasks have been executed
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief The task must not throw. Use a TaskGroup in order to get the exceptions.
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Calls body(index) for every index in [begin, end). The range is split in halves until it is not
+         *        larger than grainSize, so idle workers steal big chunks. Blocks until all indices have been processed.
+         */
+        template<typename Body>
+        void parallelFor(size_t begin, size_t end, Body &&body, size_t grainSize = 1);
+
+        [[nodiscard]] uint32_t numberOfThreads() const;
+
+        /**
+         * @return index of the calling worker in [0, numberOfThreads()) or NoWorker, if it is not a worker of this pool,
+         *         e.g. for data per worker
+         */
+        [[nodiscard]] uint32_t currentWorkerIndex() const;
+
+    private:
+        friend class TaskGroup;
+
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<WorkQueue>> m_queues;
+        std::vector<std::thread> m_threads;
+        std::atomic<size_t> m_numberOfQueuedTasks{0};
+        std::atomic<uint32_t> m_nextQueue{0};
+        std::mutex m_sleepMutex;
+        std::condition_variable m_taskHasBeenSubmitted;
+        bool m_stopped = false;
+
+        void runWorker(uint32_t workerIndex);
+
+        /**
+         * @brief Executes the newest task of the own queue or steals the oldest task of another queue.
+         * @return false, if all queues are empty
+         */
+        bool runPendingTask(uint32_t workerIndex);
+    };
+
+    /**
+     * @brief Fork-join: The tasks of a group can be waited for. A worker waiting for a group executes other tasks
+     *        meanwhile, so groups can be nested without blocking the pool. Other threads just block.
+     */
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(ThreadPool &threadPool) :
+                m_threadPool(threadPool)
+        {}
+
+        /**
+         * @brief Waits for the tasks, but ignores their exceptions
+         */
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        void run(std::function<void()> task);
+
+        /**
+         * @brief Blocks until all tasks of the group have been executed
+         * @throws the first exception thrown by a task
+         */
+        void wait();
+
+    private:
+        ThreadPool &m_threadPool;
+        std::atomic<size_t> m_numberOfPendingTasks{0};
+        std::mutex m_mutex;
+        std::condition_variable m_allTasksAreDone;
+        std::exception_ptr m_exception{};
+
+        void waitForPendingTasks();
+    };
+
+    template<typename Body>
+    void ThreadPool::parallelFor(size_t begin, size_t end, Body &&body, size_t grainSize)
+    {
+        grainSize = std::max<size_t>(grainSize, 1);
+        TaskGroup taskGroup(*this);
+
+        // The upper half is offered to the other workers, the lower half is split further
+        std::function<void(size_t, size_t)> split = [&](size_t first, size_t last) {
+            while (last - first > grainSize)
+            {
+                const size_t middle = first + (last - first) / 2;
+                taskGroup.run([&split, middle, last] { split(middle, last); });
+                last = middle;
+            }
+
+            for (size_t index = first; index < last; ++index)
+            {
+                body(index);
+            }
+        };
+
+        if (begin < end)
+        {
+            taskGroup.run([&split, begin, end] { split(begin, end); });
+        }
+
+        taskGroup.wait();
+    }
+}
\ No newline at end of file
@@ -17,32 +17,70 @@ namespace ModernChess {
         Beta
     };
 
+    /**
+     * @brief Every bucket has a depth-preferred entry and an always replaced one, so shallow entries, e.g. of the
+     *        quiescence search, cannot overwrite deep ones. Entries of previous searches are replaced regardless
+     *        of their depth, so they cannot block the bucket forever.
+     */
     class TranspositionTable {
     public:
-        TranspositionTable();
+        static constexpr size_t DefaultSizeInMB = 16;
+        static constexpr size_t MaxSizeInMB = 256 * 1024;
 
+        explicit TranspositionTable(size_t mbSize = DefaultSizeInMB);
+
+        /**
+         * @brief Starts a new generation of entries. Must be called once per search.
+         */
+        void newSearch();
         void addEntry(uint64_t hash, HashFlag flag, int32_t score, uint8_t depth);
         [[nodiscard]] int32_t getScore(uint64_t hash, int32_t alpha, int32_t beta, uint8_t depth) const;
+        /**
+         * @return true, if there is an entry of the position regardless of its depth and its score
+         */
+        [[nodiscard]] bool contains(uint64_t hash) const;
+
+        /**
+         * @return occupancy of the table in permille, sampled from the first buckets like the UCI "hashfull".
+         *         Only the depth-preferred entries of the current search are sampled, since they are filled first.
+         */
+        [[nodiscard]] uint32_t hashfull() const;
         void clear();
-        void resize(size_t mbSize);
+        /**
+         * @brief Reallocates the table. The new table is empty.
+         * @return false, if the memory could not be allocated. The table keeps its previous size then.
+         */
+        bool resize(size_t mbSize);
+        [[nodiscard]] size_t sizeInMB() const;
 
         // This value has been chosen, because Evaluation::Infinity is defined as std::numeric_limits<int32_t>::max() / 2
         static constexpr int32_t NoHashEntryFound = std::numeric_limits<int32_t>::max();
     private:
         struct TTEntry {
-            TTEntry(uint64_t hash, HashFlag hashFlag, int32_t score, uint8_t depth) :
+            TTEntry() = default;
+            TTEntry(uint64_t hash, HashFlag hashFlag, int32_t score, uint8_t depth, uint8_t generation) :
                     hash(hash),
                     score(score),
                     depth(depth),
-                    hashFlag(hashFlag)
+                    hashFlag(hashFlag),
+                    generation(generation)
             {}
             uint64_t hash{};
             int32_t score{};
             uint8_t depth{}; //< current search depth
             HashFlag hashFlag{};
+            uint8_t generation{}; //< search, which has stored the entry
         };
 
-        std::unique_ptr<TTEntry[], std::function<void(TTEntry*)>> m_table;
-        size_t m_numberEntries{};
+        struct TTBucket {
+            TTEntry depthPreferred; //< only replaced by entries of at least the same depth or of a newer search
+            TTEntry alwaysReplaced;
+        };
+
+        [[nodiscard]] static int32_t scoreOfEntry(const TTEntry &entry, int32_t alpha, int32_t beta, uint8_t depth);
+
+        std::unique_ptr<TTBucket[], std::function<void(TTBucket*)>> m_table;
+        size_t m_numberOfBuckets{};
+        uint8_t m_generation{};
     };
 }
\ No newline at end of file
@@ -1,10 +1,15 @@
 #pragma once
 
 #include "GameState.h"
+#include "NeuralNetwork.h"
+#include "PolyglotBook.h"
+#include "SearchContext.h"
 #include "Timer.h"
 #include "PeriodicTask.h"
+#include "SearchProgress.h"
 
 #include <string>
+#include <string_view>
 #include <istream>
 #include <ostream>
 #include <mutex>
@@ -12,6 +17,8 @@
 #include <chrono>
 #include <atomic>
 #include <limits>
+#include <functional>
+#include <random>
 
 namespace ModernChess
 {
@@ -23,6 +30,14 @@ namespace ModernChess
         static constexpr std::chrono::milliseconds InfiniteTime = std::chrono::hours (100);
         // Make sure the engine does not exceed the allowed time to search
         static constexpr std::chrono::milliseconds TimeSecurityMargin{50};
+        static constexpr uint32_t MaxNumberOfPVs = 256;
+        static constexpr std::chrono::milliseconds SearchProgressReportPeriod{1000};
+        // UCI option Threads: the search is single-threaded
+        static constexpr uint32_t MaxNumberOfThreads = 1;
+        // Value of the option EvalFile for the network, which is generated from the handcrafted evaluation
+        static constexpr std::string_view BuiltInEvalFile = "<built-in>";
+        // Value of the option BookFile without opening book
+        static constexpr std::string_view NoBookFile = "<empty>";
 
         struct SearchRequest {
             SearchRequest() = default;
@@ -30,10 +45,27 @@ namespace ModernChess
 
             GameState gameState{};
             uint8_t depth = 14; // default depth
+            uint64_t nodes = std::numeric_limits<uint64_t>::max(); // no node limit by default
             std::chrono::time_point<std::chrono::steady_clock> timePointToStopSearch{};
         };
+
+        /**
+         * @brief GUIs send the whole game with every "position" command. If the new command extends
+         *        the last one, only the new moves are applied to the cached game state.
+         */
+        struct PositionCache {
+            std::string position; ///< "startpos" or "fen <FEN>". Empty, if the cache is invalid.
+            std::string moves; ///< moves which have been applied to the position
+            GameState gameState{};
+        };
     public:
-        explicit UCICommunication(std::istream &inputStream, std::ostream &outputStream, std::ostream &errorStream);
+        /**
+         * @param searchContext Used by all searches of the communication. It has to outlive the communication.
+         */
+        explicit UCICommunication(std::istream &inputStream,
+                                  std::ostream &outputStream,
+                                  std::ostream &errorStream,
+                                  SearchContext &searchContext);
 
         UCICommunication(const UCICommunication&) = delete;
         UCICommunication(UCICommunication&&) = delete;
@@ -44,6 +76,17 @@ namespace ModernChess
 
         void startCommunication();
 
+        /**
+         * @brief Upper limit of the UCI option Hash, e.g. a slice of the memory budget of a server
+         */
+        void setMaxHashSize(size_t mbSize);
+
+        /**
+         * @brief If true, the end of the input is handled like "quit", e.g. when a socket has been closed.
+         *        Default: false, so the input can be appended while communicating.
+         */
+        void setQuitAtEndOfInput(bool quitAtEndOfInput);
+
         [[nodiscard]] GameState getGameState() const
         {
             const std::lock_guard lock(m_mutex);
@@ -54,13 +97,37 @@ namespace ModernChess
         std::istream &m_inputStream;
         std::ostream &m_outputStream;
         std::ostream &m_errorStream;
+        SearchContext &m_searchContext;
+        size_t m_maxHashSizeInMB = TranspositionTable::MaxSizeInMB;
+        bool m_quitAtEndOfInput = false;
 
         mutable std::mutex m_mutex;
+        std::mutex m_outputMutex; ///< The search progress is sent by another thread than the search results
         bool m_stopped = true;
         bool m_quit = false;
         Timer<> m_timeSinceSearchStarted{};
         WaitCondition m_waitForSearchRequest;
         SearchRequest m_searchRequest;
+        PositionCache m_positionCache; ///< only used by the UCI thread
+        uint32_t m_numberOfPVs = 1; ///< UCI option MultiPV
+        // While pondering, the search runs without time limit until the UI sends "ponderhit" or "stop"
+        bool m_pondering = false;
+        std::chrono::milliseconds m_timeToSearchAfterPonderHit{};
+        // UCI option Deterministic: Time limits are ignored, so identical commands lead to identical searches
+        bool m_deterministic = false;
+        // "debug on": the search statistics are sent as info strings after each search
+        bool m_debug = false;
+        // UCI option UseNNUE: the positions are evaluated by the network of option EvalFile
+        bool m_useNeuralNetwork = false;
+        // UCI option EvalFile: nullptr for the built-in network
+        std::shared_ptr<const NeuralNetwork> m_evalFileNetwork;
+        // UCI option OwnBook: moves of the opening book are played without searching
+        bool m_useBook = false;
+        // UCI option BookFile: nullptr without opening book
+        std::shared_ptr<const PolyglotBook> m_book;
+        std::mt19937 m_bookRandomGenerator{std::random_device{}()};
+        // Unlike m_stopped, it stays true until the search thread does not use the transposition table anymore
+        bool m_searchThreadIsBusy = false;
         std::thread m_searchThread;
 
         void registerToUI();
@@ -71,14 +138,60 @@ namespace ModernChess
 
         void parsePosition(UCIParser &parser);
 
-        Move executeMoves(UCIParser &parser) const;
+        /**
+         * @param position "startpos" or "fen <FEN>"
+         */
+        [[nodiscard]] static GameState parseStartPosition(std::string_view position);
 
         void executeGoCommand(UCIParser &parser);
 
+        /**
+         * @brief Sends a move of the opening book as best move, so the search thread is not woken up at all.
+         *        With the option Deterministic, always the first book move is played.
+         * @return false, if the option OwnBook is not set or the position is not in the book
+         */
+        bool sendBookMove();
+
+        void setOption(UCIParser &parser);
+
+        void ponderHit();
+
+        /**
+         * @brief The transposition table must not be changed while the search thread is using it
+         * @note m_mutex has to be locked by the caller
+         */
+        [[nodiscard]] bool searchIsRunning() const;
+
+        /**
+         * @brief Options Hash, Clear Hash, UseNNUE and EvalFile are applied only between searches.
+         *        Refused while searching.
+         */
+        void changeSearchContext(const std::function<void()> &change);
+
+        /**
+         * @brief Applies the options UseNNUE and EvalFile to the search context
+         */
+        void updateNeuralNetwork();
+
+        /**
+         * @brief Runs the bench synchronously. Not possible while searching.
+         */
+        void runBench(UCIParser &parser);
+
+        /**
+         * @brief The UCI protocol does not allow to send the best move while pondering. So wait for "ponderhit" or "stop".
+         */
+        void waitUntilPonderingHasFinished();
+
         void createNewGame();
 
         void searchBestMove();
 
+        /**
+         * @brief Sends nodes, nps, time, hashfull and the current root move as UCI info string.
+         */
+        void sendSearchProgress(const SearchProgress &searchProgress);
+
         void setGameState(GameState gameState);
 
         void stopSearch();
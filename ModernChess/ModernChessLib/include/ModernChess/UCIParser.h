@@ -2,6 +2,7 @@
 
 #include "BasicParser.h"
 #include "Move.h"
+#include "SearchParameters.h"
 
 #include <string_view>
 
@@ -13,14 +14,17 @@ namespace ModernChess
         struct UCIMove {
             explicit UCIMove(Square sourceSquare,
                              Square targetSquare,
-                             bool legalPromotionCharacter) :
+                             bool legalPromotionCharacter,
+                             char promotionCharacter = '\0') :
                              sourceSquare(sourceSquare),
                              targetSquare(targetSquare),
-                             legalPromotionCharacter(legalPromotionCharacter)
+                             legalPromotionCharacter(legalPromotionCharacter),
+                             promotionCharacter(promotionCharacter)
             {};
             Square sourceSquare{};
             Square targetSquare{};
             bool legalPromotionCharacter{};
+            char promotionCharacter{}; ///< '\0', if the move is not a promotion
         };
 
         explicit UCIParser(std::string_view uiCommand);
@@ -61,9 +65,62 @@ namespace ModernChess
 
         [[nodiscard]] bool uiHasSentInfiniteTime();
 
+        [[nodiscard]] bool uiHasSentNodes();
+
+        [[nodiscard]] bool uiHasSentPonder();
+
+        [[nodiscard]] bool uiHasSentPonderHit();
+
+        [[nodiscard]] bool uiHasSentSetOption();
+
+        [[nodiscard]] bool uiHasSentOptionName();
+
+        [[nodiscard]] bool uiHasSentOptionValue();
+
+        [[nodiscard]] bool uiHasSentMultiPVOption();
+
+        [[nodiscard]] bool uiHasSentPonderOption();
+
+        [[nodiscard]] bool uiHasSentDeterministicOption();
+
+        [[nodiscard]] bool uiHasSentHashOption();
+
+        [[nodiscard]] bool uiHasSentThreadsOption();
+
+        [[nodiscard]] bool uiHasSentClearHashOption();
+
+        [[nodiscard]] bool uiHasSentUseNNUEOption();
+
+        [[nodiscard]] bool uiHasSentEvalFileOption();
+
+        [[nodiscard]] bool uiHasSentOwnBookOption();
+
+        [[nodiscard]] bool uiHasSentBookFileOption();
+
+        /**
+         * @return parameter of the option, if the UI has sent one of the TunableSearchParameters
+         */
+        [[nodiscard]] const TunableSearchParameter *uiHasSentSearchParameterOption();
+
+        [[nodiscard]] bool uiHasSentTrueValue();
+
+        [[nodiscard]] bool uiHasSentDebugCommand();
+
+        [[nodiscard]] bool uiHasSentOnValue();
+
+        /**
+         * @brief Non-standard command "bench [depth]", see Bench
+         */
+        [[nodiscard]] bool uiHasSentBenchCommand();
+
         [[nodiscard]] UCIMove parseMove();
 
     private:
         [[nodiscard]] bool uiHasSentCommand(std::string_view command);
+        /**
+         * @brief Option names are case-insensitive and have to match the whole name, e.g. "multipv" is MultiPV,
+         *        but "Hashfoo" is not Hash.
+         */
+        [[nodiscard]] bool uiHasSentOption(std::string_view optionName);
     };
 }
\ No newline at end of file
@@ -0,0 +1,402 @@
+#include "ModernChess/BatchAnalysis.h"
+#include "ModernChess/Evaluation.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/ThreadPool.h"
+#include "ModernChess/WaitCondition.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+using namespace ModernChess;
+
+namespace
+{
+    constexpr std::string_view WhiteSpaces = " \t\r\n";
+
+    std::string_view trimWhiteSpaces(std::string_view text)
+    {
+        const size_t begin = text.find_first_not_of(WhiteSpaces);
+
+        if (begin == std::string_view::npos)
+        {
+            return {};
+        }
+
+        return text.substr(begin, text.find_last_not_of(WhiteSpaces) - begin + 1);
+    }
+
+    /**
+     * @brief Removes the next white space separated token from the text
+     */
+    std::string_view nextToken(std::string_view &text)
+    {
+        text = trimWhiteSpaces(text);
+        const size_t end = std::min(text.find_first_of(WhiteSpaces), text.size());
+        const std::string_view token = text.substr(0, end);
+        text.remove_prefix(end);
+
+        return token;
+    }
+
+    bool isNumber(std::string_view token)
+    {
+        return not token.empty() and std::all_of(token.begin(), token.end(), [](char c) { return c >= '0' and c <= '9'; });
+    }
+
+    struct AnalysisTask {
+        BatchAnalysisPosition position;
+        GameState gameState;
+    };
+
+    /**
+     * @brief The reading thread waits, if the workers are busy, so the input is not read at once
+     */
+    class TaskThrottle {
+    public:
+        explicit TaskThrottle(size_t capacity) : m_capacity(capacity) {}
+
+        /**
+         * @brief Blocks while the maximum number of tasks is queued
+         */
+        void acquire()
+        {
+            std::unique_lock lock(m_mutex);
+            m_taskHasBeenFinished.wait(lock, [this] { return m_numberOfTasks < m_capacity; });
+            ++m_numberOfTasks;
+        }
+
+        void release()
+        {
+            {
+                const std::lock_guard lock(m_mutex);
+                --m_numberOfTasks;
+            }
+            m_taskHasBeenFinished.notifyOne();
+        }
+
+    private:
+        size_t m_capacity;
+        size_t m_numberOfTasks = 0;
+        std::mutex m_mutex;
+        WaitCondition m_taskHasBeenFinished;
+    };
+
+    /**
+     * @brief Releases the slot of a task, when the task ends, even if it throws
+     */
+    class TaskThrottleRelease {
+    public:
+        explicit TaskThrottleRelease(TaskThrottle &taskThrottle) : m_taskThrottle(taskThrottle) {}
+        TaskThrottleRelease(const TaskThrottleRelease &) = delete;
+        TaskThrottleRelease &operator=(const TaskThrottleRelease &) = delete;
+
+        ~TaskThrottleRelease()
+        {
+            m_taskThrottle.release();
+        }
+
+    private:
+        TaskThrottle &m_taskThrottle;
+    };
+
+    /**
+     * @brief Writes the results in the order of the input or as soon as they are available
+     */
+    class ResultWriter {
+    public:
+        ResultWriter(std::ostream &outputStream, bool keepInputOrder) :
+                m_outputStream(outputStream),
+                m_keepInputOrder(keepInputOrder)
+        {}
+
+        void write(BatchAnalysisResult result)
+        {
+            const std::lock_guard lock(m_mutex);
+
+            ++m_summary.numberOfPositions;
+            m_summary.numberOfNodes += result.numberOfNodes;
+
+            if (not result.error.empty())
+            {
+                ++m_summary.numberOfErrors;
+            }
+
+            if (not m_keepInputOrder)
+            {
+                m_outputStream << BatchAnalysis::formatResult(result) << "\n" << std::flush;
+                return;
+            }
+
+            // Results of later positions wait for the results of the earlier ones
+            m_pendingResults.emplace(result.index, std::move(result));
+
+            for (auto nextResult = m_pendingResults.begin();
+                 nextResult != m_pendingResults.end() && nextResult->first == m_nextIndex;
+                 nextResult = m_pendingResults.erase(nextResult), ++m_nextIndex)
+            {
+                m_outputStream << BatchAnalysis::formatResult(nextResult->second) << "\n";
+            }
+
+            m_outputStream << std::flush;
+        }
+
+        [[nodiscard]] BatchAnalysisSummary summary() const
+        {
+            const std::lock_guard lock(m_mutex);
+            return m_summary;
+        }
+
+    private:
+        std::ostream &m_outputStream;
+        bool m_keepInputOrder;
+        mutable std::mutex m_mutex;
+        std::map<size_t, BatchAnalysisResult> m_pendingResults;
+        size_t m_nextIndex = 0;
+        BatchAnalysisSummary m_summary{};
+    };
+
+    BatchAnalysisResult analyze(const AnalysisTask &task,
+                                const BatchAnalysisLimits &limits,
+                                SearchContext &searchContext)
+    {
+        BatchAnalysisResult result;
+        result.index = task.position.index;
+        result.id = task.position.id;
+
+        const auto begin = std::chrono::steady_clock::now();
+        const bool hasTimeLimit = limits.time > std::chrono::milliseconds(0);
+        const auto timeLimit = begin + limits.time;
+        const auto timeIsUp = [hasTimeLimit, timeLimit] {
+            return hasTimeLimit and std::chrono::steady_clock::now() >= timeLimit;
+        };
+
+        searchContext.clear();
+
+        Evaluation evaluation(searchContext, task.gameState, timeIsUp);
+        evaluation.setNodeLimit(limits.nodes);
+
+        IterativeDeepeningResult iterativeDeepeningResult = evaluation.searchIteratively(limits.depth);
+
+        result.bestMove = iterativeDeepeningResult.bestMove();
+        result.score = iterativeDeepeningResult.score;
+        result.depth = iterativeDeepeningResult.depth;
+        result.numberOfNodes = iterativeDeepeningResult.numberOfNodes;
+        result.pv = std::move(iterativeDeepeningResult.pv);
+
+        result.elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+
+        return result;
+    }
+}
+
+namespace ModernChess {
+
+    BatchAnalysisPosition BatchAnalysisPosition::fromLine(std::string_view line, size_t index, size_t lineNumber)
+    {
+        BatchAnalysisPosition position;
+        position.index = index;
+        position.id = std::to_string(lineNumber);
+
+        std::string_view remainingLine = line;
+
+        // piece placement, side to move, castling rights and en passant square
+        for (int field = 0; field < 4; ++field)
+        {
+            const std::string_view token = nextToken(remainingLine);
+
+            if (token.empty())
+            {
+                throw std::runtime_error("Line " + std::to_string(lineNumber) + " does not contain a position: " + std::string(line));
+            }
+
+            position.fen += token;
+            position.fen += ' ';
+        }
+
+        // A FEN ends with the half move clock and the move number, an EPD with operations
+        if (std::string_view operations = remainingLine;
+            isNumber(nextToken(operations)) and isNumber(nextToken(operations)))
+        {
+            position.fen += nextToken(remainingLine);
+            position.fen += ' ';
+            position.fen += nextToken(remainingLine);
+        }
+        else
+        {
+            position.fen += "0 1";
+        }
+
+        // EPD operations like 'bm Nf3; id "WAC.001";'
+        while (not remainingLine.empty())
+        {
+            const size_t endOfOperation = std::min(remainingLine.find(';'), remainingLine.size());
+            std::string_view operation = trimWhiteSpaces(remainingLine.substr(0, endOfOperation));
+            remainingLine.remove_prefix(std::min(endOfOperation + 1, remainingLine.size()));
+
+            if (nextToken(operation) == "id")
+            {
+                operation = trimWhiteSpaces(operation);
+
+                if (operation.size() >= 2 and operation.front() == '"' and operation.back() == '"')
+                {
+                    operation = operation.substr(1, operation.size() - 2);
+                }
+
+                position.id = operation;
+            }
+        }
+
+        return position;
+    }
+
+    BatchAnalysis::BatchAnalysis(uint32_t numberOfThreads, size_t hashSizeInMB) :
+            m_numberOfThreads(std::max(numberOfThreads, uint32_t(1))),
+            m_hashSizeInMB(std::max(hashSizeInMB, size_t(1)))
+    {}
+
+    void BatchAnalysis::setLimits(const BatchAnalysisLimits &limits)
+    {
+        m_limits = limits;
+    }
+
+    void BatchAnalysis::setKeepInputOrder(bool keepInputOrder)
+    {
+        m_keepInputOrder = keepInputOrder;
+    }
+
+    BatchAnalysisSummary BatchAnalysis::run(std::istream &inputStream, std::ostream &outputStream) const
+    {
+        const auto begin = std::chrono::steady_clock::now();
+
+        TaskThrottle taskThrottle(4 * size_t(m_numberOfThreads));
+        ResultWriter resultWriter(outputStream, m_keepInputOrder);
+
+        ThreadPool threadPool(m_numberOfThreads);
+        TaskGroup taskGroup(threadPool);
+        // Every worker searches with its own context, which is created by its first task
+        std::vector<std::unique_ptr<SearchContext>> searchContexts(threadPool.numberOfThreads());
+
+        size_t index = 0;
+        size_t lineNumber = 0;
+
+        for (std::string line; std::getline(inputStream, line);)
+        {
+            ++lineNumber;
+            const std::string_view trimmedLine = trimWhiteSpaces(line);
+
+            if (trimmedLine.empty() or trimmedLine.starts_with('#'))
+            {
+                continue;
+            }
+
+            // The positions are parsed by this thread only, so the indices follow the order of the input
+            try
+            {
+                BatchAnalysisPosition position = BatchAnalysisPosition::fromLine(trimmedLine, index, lineNumber);
+                const GameState gameState = FenParsing::FenParser(position.fen).parse();
+
+                AnalysisTask task{std::move(position), gameState};
+
+                taskThrottle.acquire();
+
+                try
+                {
+                    taskGroup.run([this, &threadPool, &searchContexts, &resultWriter, &taskThrottle, task = std::move(task)] {
+                        const TaskThrottleRelease taskThrottleRelease(taskThrottle);
+                        BatchAnalysisResult result;
+
+                        // An error must not stop the other tasks, and the ordered output waits for every index
+                        try
+                        {
+                            std::unique_ptr<SearchContext> &searchContext = searchContexts[threadPool.currentWorkerIndex()];
+
+                            if (not searchContext)
+                            {
+                                searchContext = std::make_unique<SearchContext>(m_hashSizeInMB);
+                            }
+
+                            result = analyze(task, m_limits, *searchContext);
+                        }
+                        catch (const std::exception &exception)
+                        {
+                            result = BatchAnalysisResult{};
+                            result.index = task.position.index;
+                            result.id = task.position.id;
+                            result.error = exception.what();
+                        }
+
+                        resultWriter.write(std::move(result));
+                    });
+                }
+                catch (...)
+                {
+                    // The task has not been queued
+                    taskThrottle.release();
+                    throw;
+                }
+            }
+            catch (const std::exception &exception)
+            {
+                BatchAnalysisResult result;
+                result.index = index;
+                result.id = std::to_string(lineNumber);
+                result.error = exception.what();
+                resultWriter.write(std::move(result));
+            }
+
+            ++index;
+        }
+
+        taskGroup.wait();
+
+        BatchAnalysisSummary summary = resultWriter.summary();
+        summary.elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+
+        const auto elapsedMs = uint64_t(std::max<int64_t>(summary.elapsedTime.count(), 1));
+        summary.positionsPerSecond = double(summary.numberOfPositions) * 1000.0 / double(elapsedMs);
+        summary.nodesPerSecond = summary.numberOfNodes * 1000 / elapsedMs;
+
+        return summary;
+    }
+
+    std::string BatchAnalysis::formatResult(const BatchAnalysisResult &result)
+    {
+        std::ostringstream resultLine;
+        resultLine << "id " << result.id;
+
+        if (not result.error.empty())
+        {
+            resultLine << " error " << result.error;
+            return resultLine.str();
+        }
+
+        resultLine << " bestmove " << result.bestMove
+                   << " score cp " << result.score
+                   << " depth " << result.depth
+                   << " nodes " << result.numberOfNodes
+                   << " time " << result.elapsedTime.count()
+                   << " pv";
+
+        for (const Move move : result.pv)
+        {
+            resultLine << " " << move;
+        }
+
+        return resultLine.str();
+    }
+}
+
+std::ostream &operator<<(std::ostream &os, const ModernChess::BatchAnalysisSummary &summary)
+{
+    os << "Positions       : " << summary.numberOfPositions << "\n"
+       << "Errors          : " << summary.numberOfErrors << "\n"
+       << "Total time (ms) : " << summary.elapsedTime.count() << "\n"
+       << "Positions/second: " << summary.positionsPerSecond << "\n"
+       << "Nodes searched  : " << summary.numberOfNodes << "\n"
+       << "Nodes/second    : " << summary.nodesPerSecond << "\n";
+
+    return os;
+}
\ No newline at end of file
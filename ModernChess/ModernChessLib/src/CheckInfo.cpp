@@ -0,0 +1,203 @@
+#include "ModernChess/CheckInfo.h"
+#include "ModernChess/AttackQueries.h"
+#include "ModernChess/BitBoardOperations.h"
+
+using namespace ModernChess::BitBoardOperations;
+
+namespace ModernChess
+{
+    CheckInfo::CheckInfo(const Board &board) :
+        m_board(board),
+        m_opponent(Color(!bool(board.sideToMove))),
+        m_opponentsKingSquare(Square::undefined),
+        m_figureOffset(board.sideToMove == Color::White ? Figure::WhitePawn : Figure::BlackPawn)
+    {
+        const Color us = board.sideToMove;
+        const Figure opponentsOffset = (us == Color::White) ? Figure::BlackPawn : Figure::WhitePawn;
+        const BitBoardState occupancy = board.occupancies[Color::Both];
+
+        const BitBoardState ourRookSliders = board.bitboards[m_figureOffset + Figure::WhiteRook] |
+                                             board.bitboards[m_figureOffset + Figure::WhiteQueen];
+        const BitBoardState ourBishopSliders = board.bitboards[m_figureOffset + Figure::WhiteBishop] |
+                                               board.bitboards[m_figureOffset + Figure::WhiteQueen];
+        const BitBoardState opponentsRookSliders = board.bitboards[opponentsOffset + Figure::WhiteRook] |
+                                                   board.bitboards[opponentsOffset + Figure::WhiteQueen];
+        const BitBoardState opponentsBishopSliders = board.bitboards[opponentsOffset + Figure::WhiteBishop] |
+                                                     board.bitboards[opponentsOffset + Figure::WhiteQueen];
+
+        const Square kingsSquare = bitScanForward(board.bitboards[m_figureOffset + Figure::WhiteKing]);
+        m_opponentsKingSquare = bitScanForward(board.bitboards[opponentsOffset + Figure::WhiteKing]);
+
+        checkers = (AttackQueries::pawnAttackTable[us][kingsSquare] & board.bitboards[opponentsOffset + Figure::WhitePawn]) |
+                   (AttackQueries::knightAttackTable[kingsSquare] & board.bitboards[opponentsOffset + Figure::WhiteKnight]) |
+                   (AttackQueries::bishopAttacks.getAttacks(kingsSquare, occupancy) & opponentsBishopSliders) |
+                   (AttackQueries::rookAttacks.getAttacks(kingsSquare, occupancy) & opponentsRookSliders);
+
+        pinned = blockersForKing(kingsSquare, board.occupancies[us], opponentsRookSliders, opponentsBishopSliders);
+        discoveredCheckCandidates = blockersForKing(m_opponentsKingSquare, board.occupancies[us], ourRookSliders, ourBishopSliders);
+
+        const BitBoardState bishopChecks = AttackQueries::bishopAttacks.getAttacks(m_opponentsKingSquare, occupancy);
+        const BitBoardState rookChecks = AttackQueries::rookAttacks.getAttacks(m_opponentsKingSquare, occupancy);
+
+        checkSquares[Figure::WhitePawn] = AttackQueries::pawnAttackTable[m_opponent][m_opponentsKingSquare];
+        checkSquares[Figure::WhiteKnight] = AttackQueries::knightAttackTable[m_opponentsKingSquare];
+        checkSquares[Figure::WhiteBishop] = bishopChecks;
+        checkSquares[Figure::WhiteRook] = rookChecks;
+        checkSquares[Figure::WhiteQueen] = bishopChecks | rookChecks;
+        checkSquares[Figure::WhiteKing] = BoardState::empty;
+    }
+
+    bool CheckInfo::givesCheck(Move move) const
+    {
+        const Square sourceSquare = move.getFrom();
+        const Square targetSquare = move.getTo();
+        const BitBoardState occupancy = m_board.occupancies[Color::Both];
+        const BitBoardState sourceBit = occupySquare(BoardState::empty, sourceSquare);
+        const BitBoardState targetBit = occupySquare(BoardState::empty, targetSquare);
+
+        const BitBoardState ourRookSliders = (m_board.bitboards[m_figureOffset + Figure::WhiteRook] |
+                                              m_board.bitboards[m_figureOffset + Figure::WhiteQueen]) & ~sourceBit;
+        const BitBoardState ourBishopSliders = (m_board.bitboards[m_figureOffset + Figure::WhiteBishop] |
+                                                m_board.bitboards[m_figureOffset + Figure::WhiteQueen]) & ~sourceBit;
+
+        if (move.isCastlingMove())
+        {
+            Square rookSourceSquare;
+            Square rookTargetSquare;
+
+            switch (targetSquare)
+            {
+                case Square::g1:
+                    rookSourceSquare = Square::h1;
+                    rookTargetSquare = Square::f1;
+                    break;
+                case Square::c1:
+                    rookSourceSquare = Square::a1;
+                    rookTargetSquare = Square::d1;
+                    break;
+                case Square::g8:
+                    rookSourceSquare = Square::h8;
+                    rookTargetSquare = Square::f8;
+                    break;
+                default:
+                    rookSourceSquare = Square::a8;
+                    rookTargetSquare = Square::d8;
+                    break;
+            }
+
+            const BitBoardState rookSourceBit = occupySquare(BoardState::empty, rookSourceSquare);
+            const BitBoardState rookTargetBit = occupySquare(BoardState::empty, rookTargetSquare);
+            const BitBoardState occupancyAfterMove = (occupancy & ~sourceBit & ~rookSourceBit) | targetBit | rookTargetBit;
+
+            return slidersAttackOpponentsKing(occupancyAfterMove,
+                                              (ourRookSliders & ~rookSourceBit) | rookTargetBit,
+                                              ourBishopSliders);
+        }
+
+        const Figure promotedPiece = move.getPromotedPiece();
+        const bool isPromotion = promotedPiece != Figure::None;
+        const Figure figureType = Figure((isPromotion ? promotedPiece : move.getMovedFigure()) - m_figureOffset);
+
+        // direct check
+        if (isPromotion)
+        {
+            // The pawn, which is about to be promoted, might block the line to the king
+            const BitBoardState occupancyAfterMove = (occupancy & ~sourceBit) | targetBit;
+            BitBoardState attacks;
+
+            switch (figureType)
+            {
+                case Figure::WhiteKnight:
+                    attacks = AttackQueries::knightAttackTable[targetSquare];
+                    break;
+                case Figure::WhiteBishop:
+                    attacks = AttackQueries::bishopAttacks.getAttacks(targetSquare, occupancyAfterMove);
+                    break;
+                case Figure::WhiteRook:
+                    attacks = AttackQueries::rookAttacks.getAttacks(targetSquare, occupancyAfterMove);
+                    break;
+                default:
+                    attacks = AttackQueries::queenAttacks.getAttacks(targetSquare, occupancyAfterMove);
+                    break;
+            }
+
+            if (isOccupied(attacks, m_opponentsKingSquare))
+            {
+                return true;
+            }
+        }
+        else if (isOccupied(checkSquares[figureType], targetSquare))
+        {
+            return true;
+        }
+
+        if (move.isEnPassantCapture())
+        {
+            // The captured pawn is not on the target square and its removal might discover a check, too
+            const Square capturedPawnSquare = (m_board.sideToMove == Color::White) ?
+                    getSouthSquareFromGivenSquare(targetSquare) : getNorthSquareFromGivenSquare(targetSquare);
+            const BitBoardState occupancyAfterMove = (occupancy & ~sourceBit & ~occupySquare(BoardState::empty, capturedPawnSquare)) | targetBit;
+
+            return slidersAttackOpponentsKing(occupancyAfterMove, ourRookSliders, ourBishopSliders);
+        }
+
+        // discovered check
+        if (isOccupied(discoveredCheckCandidates, sourceSquare))
+        {
+            const BitBoardState occupancyAfterMove = (occupancy & ~sourceBit) | targetBit;
+
+            return slidersAttackOpponentsKing(occupancyAfterMove, ourRookSliders, ourBishopSliders);
+        }
+
+        return false;
+    }
+
+    bool CheckInfo::moveIsKnownToBeLegal(Move move) const
+    {
+        const Figure movedFigure = move.getMovedFigure();
+
+        return not kingIsInCheck() &&
+               movedFigure != Figure::WhiteKing &&
+               movedFigure != Figure::BlackKing &&
+               not move.isEnPassantCapture() &&
+               not isOccupied(pinned, move.getFrom());
+    }
+
+    BitBoardState CheckInfo::blockersForKing(Square kingsSquare,
+                                             BitBoardState blockerCandidates,
+                                             BitBoardState rookSliders,
+                                             BitBoardState bishopSliders) const
+    {
+        // X-ray attacks through the first blocker candidate reveal the sliders behind it
+        // @see https://www.chessprogramming.org/X-ray_Attacks_(Bitboards)
+        const BitBoardState occupancy = m_board.occupancies[Color::Both];
+        BitBoardState blockers = BoardState::empty;
+
+        const BitBoardState rookAttacks = AttackQueries::rookAttacks.getAttacks(kingsSquare, occupancy);
+        const BitBoardState rookXRays = rookAttacks ^ AttackQueries::rookAttacks.getAttacks(kingsSquare, occupancy ^ (rookAttacks & blockerCandidates));
+
+        for (BitBoardState pinners = rookXRays & rookSliders; pinners != BoardState::empty; pinners &= pinners - 1)
+        {
+            // The only square seen from both, the king and the pinner, is the blocker in between
+            blockers |= AttackQueries::rookAttacks.getAttacks(bitScanForward(pinners), occupancy) & rookAttacks & blockerCandidates;
+        }
+
+        const BitBoardState bishopAttacks = AttackQueries::bishopAttacks.getAttacks(kingsSquare, occupancy);
+        const BitBoardState bishopXRays = bishopAttacks ^ AttackQueries::bishopAttacks.getAttacks(kingsSquare, occupancy ^ (bishopAttacks & blockerCandidates));
+
+        for (BitBoardState pinners = bishopXRays & bishopSliders; pinners != BoardState::empty; pinners &= pinners - 1)
+        {
+            blockers |= AttackQueries::bishopAttacks.getAttacks(bitScanForward(pinners), occupancy) & bishopAttacks & blockerCandidates;
+        }
+
+        return blockers;
+    }
+
+    bool CheckInfo::slidersAttackOpponentsKing(BitBoardState occupancy,
+                                               BitBoardState rookSliders,
+                                               BitBoardState bishopSliders) const
+    {
+        return (AttackQueries::rookAttacks.getAttacks(m_opponentsKingSquare, occupancy) & rookSliders) != BoardState::empty ||
+               (AttackQueries::bishopAttacks.getAttacks(m_opponentsKingSquare, occupancy) & bishopSliders) != BoardState::empty;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "ModernChess/EngineServer.h"
+#include "ModernChess/LocalSocket.h"
+#include "ModernChess/SearchContext.h"
+#include "ModernChess/UCICommunication.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+
+namespace ModernChess {
+
+    EngineServer::EngineServer(std::string address, size_t hashBudgetInMB, uint32_t maxNumberOfSessions) :
+            m_address(std::move(address)),
+            m_hashSizePerSessionInMB(std::max<size_t>(hashBudgetInMB / std::max(maxNumberOfSessions, 1u), 1)),
+            m_maxNumberOfSessions(std::max(maxNumberOfSessions, 1u))
+    {}
+
+    EngineServer::~EngineServer()
+    {
+        stop();
+    }
+
+    void EngineServer::start()
+    {
+        m_listeningSocket = LocalSocket::listenOn(m_address, int(m_maxNumberOfSessions));
+        m_acceptThread = std::thread(&EngineServer::acceptConnections, this);
+    }
+
+    void EngineServer::stop()
+    {
+        m_stopped = true;
+        m_stopped.notify_all();
+
+        if (m_listeningSocket >= 0)
+        {
+            // Wakes up the accept thread
+            ::shutdown(m_listeningSocket, SHUT_RDWR);
+        }
+
+        if (m_acceptThread.joinable())
+        {
+            m_acceptThread.join();
+        }
+
+        if (m_listeningSocket >= 0)
+        {
+            LocalSocket::closeSocket(m_listeningSocket);
+            m_listeningSocket = -1;
+
+            if (not LocalSocket::isTcpAddress(m_address))
+            {
+                ::unlink(m_address.c_str());
+            }
+        }
+
+        const std::scoped_lock lock{m_mutex};
+
+        // The sessions quit at the end of their input
+        for (const std::unique_ptr<Session> &session : m_sessions)
+        {
+            ::shutdown(session->socket, SHUT_RDWR);
+        }
+
+        for (const std::unique_ptr<Session> &session : m_sessions)
+        {
+            session->thread.join();
+            LocalSocket::closeSocket(session->socket);
+        }
+
+        m_sessions.clear();
+    }
+
+    void EngineServer::waitUntilStopped()
+    {
+        m_stopped.wait(false);
+    }
+
+    size_t EngineServer::hashSizePerSessionInMB() const
+    {
+        return m_hashSizePerSessionInMB;
+    }
+
+    size_t EngineServer::numberOfSessions() const
+    {
+        const std::scoped_lock lock{m_mutex};
+
+        return size_t(std::count_if(m_sessions.begin(), m_sessions.end(), [](const std::unique_ptr<Session> &session){
+            return not session->finished;
+        }));
+    }
+
+    void EngineServer::acceptConnections()
+    {
+        while (not m_stopped)
+        {
+            const int connectedSocket = ::accept(m_listeningSocket, nullptr, nullptr);
+
+            if (connectedSocket < 0)
+            {
+                if (m_stopped or (errno != EINTR and errno != ECONNABORTED))
+                {
+                    break;
+                }
+                continue;
+            }
+
+            const std::scoped_lock lock{m_mutex};
+
+            removeFinishedSessions();
+
+            if (m_sessions.size() >= m_maxNumberOfSessions)
+            {
+                LocalSocket::SocketStreamBuffer outputBuffer(connectedSocket);
+                std::ostream outputStream(&outputBuffer);
+                outputStream << "info string The server is busy. Maximum number of sessions: "
+                             << m_maxNumberOfSessions << std::endl;
+
+                LocalSocket::closeSocket(connectedSocket);
+                continue;
+            }
+
+            Session &session = *m_sessions.emplace_back(std::make_unique<Session>());
+            session.socket = connectedSocket;
+            session.thread = std::thread(&EngineServer::runSession, this, std::ref(session));
+        }
+    }
+
+    void EngineServer::runSession(Session &session) const
+    {
+        // Reading and writing are done by different threads
+        LocalSocket::SocketStreamBuffer inputBuffer(session.socket);
+        LocalSocket::SocketStreamBuffer outputBuffer(session.socket);
+        std::istream inputStream(&inputBuffer);
+        std::ostream outputStream(&outputBuffer);
+
+        SearchContext searchContext(m_hashSizePerSessionInMB);
+
+        {
+            UCICommunication uciCommunication(inputStream, outputStream, std::cerr, searchContext);
+            uciCommunication.setMaxHashSize(m_hashSizePerSessionInMB);
+            uciCommunication.setQuitAtEndOfInput(true);
+            uciCommunication.startCommunication();
+        }
+
+        outputStream.flush();
+
+        // Tell the client that the session has ended. The socket is closed after joining this thread.
+        ::shutdown(session.socket, SHUT_RDWR);
+        session.finished = true;
+    }
+
+    void EngineServer::removeFinishedSessions()
+    {
+        std::erase_if(m_sessions, [](const std::unique_ptr<Session> &session){
+            if (not session->finished)
+            {
+                return false;
+            }
+
+            session->thread.join();
+            LocalSocket::closeSocket(session->socket);
+
+            return true;
+        });
+    }
+}
\ No newline at end of file
@@ -1,13 +1,12 @@
 #include "ModernChess/Evaluation.h"
 
 #include "ModernChess/PseudoMoveGeneration.h"
-#include "ModernChess/MoveExecution.h"
 
 #include <algorithm>
 
 std::ostream &operator<<(std::ostream &os, const ModernChess::EvaluationResult &evalResult)
 {
-    os << "info score cp " << evalResult.score << " depth " << evalResult.depth << " nodes " <<
+    os << "info multipv " << evalResult.multiPv << " score cp " << evalResult.score << " depth " << evalResult.depth << " nodes " <<
     evalResult.numberOfNodes << " pv ";
 
     for (const ModernChess::Move move : *evalResult.pvTable)
@@ -24,31 +23,112 @@ namespace ModernChess
 {
     EvaluationResult Evaluation::getBestMove(uint8_t depth)
     {
+        const uint64_t numberOfNodesBefore = m_numberOfNodes + m_numberOfQuiescenceNodes;
+
         m_followPv = true;
         // find best move within a given position
         const int32_t score = negamax(-Infinity, Infinity, depth);
 
-        return EvaluationResult{score, m_numberOfNodes, depth, pvTable};
+        if constexpr (SearchStatisticsEnabled)
+        {
+            // The passes of the Multi-PV mode belong to the same iteration
+            if (m_statistics.nodesPerDepth.size() <= depth)
+            {
+                m_statistics.nodesPerDepth.resize(depth + 1);
+            }
+            m_statistics.nodesPerDepth[depth] += m_numberOfNodes + m_numberOfQuiescenceNodes - numberOfNodesBefore;
+        }
+
+        return EvaluationResult{score, m_numberOfNodes + m_numberOfQuiescenceNodes, m_numberOfQuiescenceNodes, depth, pvTable};
     }
 
-    bool Evaluation::kingIsInCheck() const
+    IterativeDeepeningResult Evaluation::searchIteratively(uint8_t maxDepth, const IterativeDeepeningOptions &options)
     {
-        return kingIsInCheck(m_gameState.board.sideToMove);
+        IterativeDeepeningResult result;
+
+        for (uint32_t depth = 1; depth <= maxDepth; ++depth)
+        {
+            if (m_searchProgress)
+            {
+                m_searchProgress->depth.store(depth, std::memory_order_relaxed);
+            }
+
+            // A single line does not need the copies of the PV table of the Multi-PV mode
+            const std::vector<EvaluationResult> evaluationResults = (options.numberOfPVs > 1) ?
+                                                                    getBestMoves(uint8_t(depth), options.numberOfPVs) :
+                                                                    std::vector{getBestMove(uint8_t(depth))};
+            const EvaluationResult &evaluationResult = evaluationResults.front();
+            const bool searchHasBeenInterrupted = searchHasToBeStopped();
+
+            result.numberOfNodes = evaluationResult.numberOfNodes;
+
+            if (searchHasBeenInterrupted and depth > 1)
+            {
+                return result;
+            }
+
+            result.score = evaluationResult.score;
+            result.depth = depth;
+            result.pv.assign(evaluationResult.pvTable->begin(), evaluationResult.pvTable->end());
+
+            if (options.onIterationFinished)
+            {
+                options.onIterationFinished(evaluationResults);
+            }
+
+            if (searchHasBeenInterrupted or (options.stopBeforeNextIteration and options.stopBeforeNextIteration()))
+            {
+                return result;
+            }
+        }
+
+        result.completed = true;
+
+        return result;
     }
 
-    bool Evaluation::kingIsInCheck(Color sideToMove) const
+    std::vector<EvaluationResult> Evaluation::getBestMoves(uint8_t depth, uint32_t numberOfPVs)
     {
-        if (sideToMove == Color::White)
+        std::vector<EvaluationResult> results;
+        results.reserve(numberOfPVs);
+
+        m_excludedRootMoves.clear();
+
+        for (uint32_t multiPv = 1; multiPv <= numberOfPVs; ++multiPv)
         {
-            const Square kingsSquare = BitBoardOperations::bitScanForward(m_gameState.board.bitboards[Figure::WhiteKing]);
-            return AttackQueries::squareIsAttackedByBlack(m_gameState.board, kingsSquare);
+            EvaluationResult result = getBestMove(depth);
+
+            // No legal moves left or the pass has been stopped before it could be completed.
+            // The first line is always returned like in the single PV mode.
+            if (multiPv > 1 && (pvTable->begin() == pvTable->end() || searchHasToBeStopped()))
+            {
+                break;
+            }
+
+            // Every line needs its own PV, since the PV table is reused by the next pass
+            result.pvTable = std::make_shared<PrincipalVariationTable>(*pvTable);
+            result.multiPv = multiPv;
+            m_excludedRootMoves.push_back(result.bestMove());
+            results.push_back(std::move(result));
+
+            if (searchHasToBeStopped())
+            {
+                break;
+            }
         }
 
-        const Square kingsSquare = BitBoardOperations::bitScanForward(m_gameState.board.bitboards[Figure::BlackKing]);
-        return AttackQueries::squareIsAttackedByWhite(m_gameState.board, kingsSquare);
+        m_excludedRootMoves.clear();
+
+        if (not results.empty())
+        {
+            // The next iteration shall follow the PV of the best line
+            *pvTable = *results.front().pvTable;
+        }
+
+        return results;
     }
 
-    std::vector<Move> Evaluation::generateSortedMoves()
+    std::vector<Move> Evaluation::generateSortedMoves(MoveType moveType)
     {
         std::vector<Move> moves =  PseudoMoveGeneration::generateMoves(m_gameState);
 
@@ -61,10 +141,29 @@ namespace ModernChess
             m_followPv = m_scorePv;
         }
 
+        if (moveType == MoveType::CapturesOnly)
+        {
+            // quiet moves won't be executed anyway, so don't waste time on scoring them
+            std::erase_if(moves, [](const Move move){ return not move.isCapture(); });
+        }
+
+        // Score every move only once, because the history lookups are too expensive for the sort comparator
+        std::vector<std::pair<int32_t, Move>> scoredMoves;
+        scoredMoves.reserve(moves.size());
+
+        for (const Move move : moves)
+        {
+            scoredMoves.emplace_back(scoreMove(move), move);
+        }
+
         // Sort moves, such that captures with higher scores are evaluated first and makes an early pruning more probable
         // Use also stable_sort, because on capture moves, we insert first the most valuable pieces!
-        std::stable_sort(moves.begin(), moves.end(), [this](const Move leftOrderedMove, const Move rightOrderedMove){
-            return scoreMove(leftOrderedMove) > scoreMove(rightOrderedMove);
+        std::stable_sort(scoredMoves.begin(), scoredMoves.end(), [](const auto &leftScoredMove, const auto &rightScoredMove){
+            return leftScoredMove.first > rightScoredMove.first;
+        });
+
+        std::transform(scoredMoves.begin(), scoredMoves.end(), moves.begin(), [](const auto &scoredMove){
+            return scoredMove.second;
         });
 
         m_scorePv = false;
@@ -74,20 +173,24 @@ namespace ModernChess
 
     int32_t Evaluation::negamax(int32_t alpha, int32_t beta, uint8_t depth)
     {
-        if (const int32_t score = GameState::transpositionTable.getScore(m_gameState.gameStateHash, alpha, beta, depth);
-            score != TranspositionTable::NoHashEntryFound &&
-            // In the first iteration/move/ply, there is no PV node to be returned, therefore don't return a score for the first ply.
-            m_gameState.halfMoveClock > m_halfMoveClockRootSearch
-            )
+        // Init PV length. This has to be done before the transposition table cutoff, otherwise the parent node
+        // would copy a stale PV of another branch.
+        pvTable->pvLength[m_gameState.halfMoveClock] = m_gameState.halfMoveClock;
+
+        // In the first iteration/move/ply, there is no PV node to be returned, therefore don't return a score for the first ply.
+        if (m_gameState.halfMoveClock > m_halfMoveClockRootSearch)
         {
-            // Position has already been scored with at least the same depth
-            return score;
+            if (const int32_t score = probeTranspositionTable(alpha, beta, depth);
+                score != TranspositionTable::NoHashEntryFound)
+            {
+                // Position has already been scored with at least the same depth
+                return score;
+            }
         }
 
-        // Init PV length
-        pvTable->pvLength[m_gameState.halfMoveClock] = m_gameState.halfMoveClock;
-
-        const bool kingInCheck = kingIsInCheck();
+        // checkers, pins and check squares are computed once and reused for every move of this node
+        const CheckInfo checkInfo(m_gameState.board);
+        const bool kingInCheck = checkInfo.kingIsInCheck();
 
         // increase search depth if the king has been exposed into a check
         if (kingInCheck)
@@ -113,16 +216,18 @@ namespace ModernChess
 
         // increment nodes count
         ++m_numberOfNodes;
+        publishNumberOfNodes();
 
         // Null Move Pruning
         // see also https://web.archive.org/web/20071031095933/http://www.brucemo.com/compchess/programming/nullmove.htm
-        if (m_allowNullMove && depth >= 3 &&
+        if (m_allowNullMove && depth >= m_searchParameters.minimumDepthForNullMovePruning &&
             not kingInCheck &&
             m_gameState.halfMoveClock > m_halfMoveClockRootSearch &&
             not isEndGame() // Null Move Pruning does not work for end games
             )
         {
             m_allowNullMove = false; // Don't allow consecutive null moves
+            countStatistic(m_statistics.nullMoveAttempts);
             // preserve board state
             const GameState gameStateCopy = m_gameState;
 
@@ -139,17 +244,24 @@ namespace ModernChess
             m_gameState.board.sideToMove = Color(!bool(m_gameState.board.sideToMove));
             m_gameState.gameStateHash ^= ZobristHasher::sideKey;
 
+            // The null move is searched on the same ply. Therefore, there is no previous move for the opponent.
+            const Move previousMoveCopy = m_moveStack[m_gameState.halfMoveClock];
+            m_moveStack[m_gameState.halfMoveClock] = Move{};
+
             // search moves with reduced depth to find beta cutoffs (depth - 1 - R) where R is a depth reduction
-            const int32_t score = -negamax(-beta, -beta + 1, depth - 1 - NullMovePruningDepthReduction);
+            const auto reducedDepth = uint8_t(std::max(depth - 1 - m_searchParameters.nullMovePruningDepthReduction, 0));
+            const int32_t score = -negamax(-beta, -beta + 1, reducedDepth);
 
             // restore board state
             m_gameState = gameStateCopy;
+            m_moveStack[m_gameState.halfMoveClock] = previousMoveCopy;
 
             // fail-hard beta cutoff
             if (score >= beta)
             {
+                countStatistic(m_statistics.nullMoveCutoffs);
                 // node (move) fails high
-                GameState::transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, depth);
+                m_transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, depth);
                 return beta;
             }
         }
@@ -162,6 +274,10 @@ namespace ModernChess
         // legal moves counter
         uint32_t legalMoves = 0;
 
+        // quiet moves which did not cause a beta cutoff (yet)
+        std::array<Move, MaxNumberOfQuietMovesForHistoryUpdate> quietMovesSearched{};
+        size_t numberOfQuietMovesSearched = 0;
+
         // loop over moves within a move list
         for (const Move move : moves)
         {
@@ -170,15 +286,37 @@ namespace ModernChess
             // preserve board state
             const GameState gameStateCopy = m_gameState;
 
+            // skip root moves, which have already been reported by previous Multi-PV passes
+            if (m_gameState.halfMoveClock == m_halfMoveClockRootSearch &&
+                std::find(m_excludedRootMoves.begin(), m_excludedRootMoves.end(), move) != m_excludedRootMoves.end())
+            {
+                continue;
+            }
+
+            // Has to be determined before the move is executed
+            const bool moveGivesCheck = checkInfo.givesCheck(move);
+
+            prepareAccumulatorForNextPly();
+
             // make sure to make only legal moves
-            if (not MoveExecution::executeMove(m_gameState, move, MoveType::AllMoves))
+            if (not MoveExecution::executeMove(m_gameState, move, MoveType::AllMoves, checkInfo))
             {
+                // The illegal move has been taken back, but the game state still points to the next accumulator
+                m_gameState.accumulator = gameStateCopy.accumulator;
                 // skip to next move
                 continue;
             }
 
             ++legalMoves;
 
+            if (m_searchProgress && gameStateCopy.halfMoveClock == m_halfMoveClockRootSearch)
+            {
+                m_searchProgress->currentMove.store(move, std::memory_order_relaxed);
+                m_searchProgress->currentMoveNumber.store(legalMoves, std::memory_order_relaxed);
+            }
+
+            m_moveStack[m_gameState.halfMoveClock] = move;
+
             int32_t score;
 
             // full depth search in order to get a PV node
@@ -193,15 +331,21 @@ namespace ModernChess
                 // @see https://www.chessprogramming.org/Late_Move_Reductions
                 // @see https://web.archive.org/web/20150212051846/http://www.glaurungchess.com/lmr.html
                 // condition to consider LMR
-                if (movesSearched > NumberOfMovesForFullDepthSearch &&
-                    depth > MinimumDepthForFullDepthSearch &&
+                if (movesSearched > uint32_t(m_searchParameters.numberOfMovesForFullDepthSearch) &&
+                    depth > m_searchParameters.minimumDepthForFullDepthSearch &&
                     not kingInCheck &&
                     not move.isCapture() &&
                     move.getPromotedPiece() == Figure::None &&
-                    not kingIsInCheck(Color(!bool(m_gameState.board.sideToMove)))) // Also opponent must not be in check
+                    not moveGivesCheck) // Also opponent must not be in check
                 {
                     // search current move with reduced depth:
+                    countStatistic(m_statistics.lateMoveReductions);
                     score = -negamax(-(alpha + 1), -alpha, depth - 2);
+
+                    if (score > alpha)
+                    {
+                        countStatistic(m_statistics.lateMoveReductionReSearches);
+                    }
                 }
                 else
                 {
@@ -231,6 +375,7 @@ namespace ModernChess
                     {
                         // re-search the move that has failed to be proved to be bad
                         // with normal alpha beta score bounds
+                        countStatistic(m_statistics.principalVariationReSearches);
                         score = -negamax(-beta, -alpha, depth - 1);
                     }
                 }
@@ -245,38 +390,46 @@ namespace ModernChess
             // fail-hard beta cutoff
             if (score >= beta)
             {
+                countStatistic(m_statistics.betaCutoffs);
+
+                if (movesSearched == 1)
+                {
+                    countStatistic(m_statistics.firstMoveBetaCutoffs);
+                }
+
                 if (not move.isCapture())
                 {
                     // store killer moves for later reuse
                     m_killerMoves[1][m_gameState.halfMoveClock] = m_killerMoves[0][m_gameState.halfMoveClock]; // old killer move
                     m_killerMoves[0][m_gameState.halfMoveClock] = move; // new and better killer move
+
+                    updateQuietMoveHistories(move,
+                                             std::span<const Move>(quietMovesSearched.data(), numberOfQuietMovesSearched),
+                                             depth);
                 }
 
-                GameState::transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, depth);
+                m_transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, depth);
 
                 // node (move) fails high
                 return beta;
             }
 
+            if (not move.isCapture() && numberOfQuietMovesSearched < quietMovesSearched.size())
+            {
+                quietMovesSearched[numberOfQuietMovesSearched] = move;
+                ++numberOfQuietMovesSearched;
+            }
+
             // found a better move
             if (score > alpha)
             {
-                if (not move.isCapture())
-                {
-                    // store history moves.
-                    // The added value is typically depth * depth or 2 ^ depth,
-                    // based on the assumption that otherwise moves from the plies near the leaves would have too
-                    // much impact on the result.
-                    m_historyMoves[move.getMovedFigure()][move.getTo()] += (depth * depth);
-                }
-
                 // PV node (move)
                 alpha = score;
                 hashFlag = HashFlag::Exact; // Store PV node
                 pvTable->addPrincipalVariation(move, m_gameState.halfMoveClock);
             }
 
-            if (m_stopSearching())
+            if (searchHasToBeStopped())
             {
                 break;
             }
@@ -299,7 +452,11 @@ namespace ModernChess
             }
         }
 
-        GameState::transpositionTable.addEntry(m_gameState.gameStateHash, hashFlag, alpha, depth);
+        // The score of the root is not the score of the position, if some root moves have been excluded
+        if (m_excludedRootMoves.empty() || m_gameState.halfMoveClock != m_halfMoveClockRootSearch)
+        {
+            m_transpositionTable.addEntry(m_gameState.gameStateHash, hashFlag, alpha, depth);
+        }
 
         // node (move) fails low
         return alpha;
@@ -307,7 +464,15 @@ namespace ModernChess
 
     int32_t Evaluation::quiescenceSearch(int32_t alpha, int32_t beta)
     {
-        ++m_numberOfNodes;
+        ++m_numberOfQuiescenceNodes;
+        publishNumberOfNodes();
+
+        // Any stored score is at least as accurate as the quiescence search, which has the depth 0
+        if (const int32_t score = probeTranspositionTable(alpha, beta, 0);
+            score != TranspositionTable::NoHashEntryFound)
+        {
+            return score;
+        }
 
         // evaluate position
         const int32_t evaluation = evaluatePosition();
@@ -315,6 +480,7 @@ namespace ModernChess
         // fail-hard beta cutoff
         if (evaluation >= beta)
         {
+            m_transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, evaluation, 0);
             // node (move) fails high
             return beta;
         }
@@ -326,31 +492,49 @@ namespace ModernChess
         }
 
         // Assume alpha score does not increase
-        //HashFlag hashFlag = HashFlag::Alpha;
+        HashFlag hashFlag = HashFlag::Alpha;
 
         // found a better move
         if (evaluation > alpha)
         {
-            //hashFlag = HashFlag::Exact; // Store PV node
+            hashFlag = HashFlag::Exact; // Store PV node
             // PV node (move)
             alpha = evaluation;
         }
 
-        const std::vector<Move> moves = generateSortedMoves();
+        // Delta pruning doesn't work in the end game, where the material is not as important anymore
+        // @see https://www.chessprogramming.org/Delta_Pruning
+        const bool allowDeltaPruning = not isEndGame();
+
+        const std::vector<Move> moves = generateSortedMoves(MoveType::CapturesOnly);
 
         // loop over moves within a move list
         for (const Move move : moves)
         {
+            // Delta pruning: skip captures, which cannot raise the score up to alpha, even with a safety margin
+            if (allowDeltaPruning &&
+                move.getPromotedPiece() == Figure::None &&
+                evaluation + std::abs(materialScore[capturedFigure(move)]) + DeltaPruningMargin <= alpha)
+            {
+                continue;
+            }
+
             // preserve board state
             const GameState gameStateCopy = m_gameState;
 
+            prepareAccumulatorForNextPly();
+
             // make sure to make only legal moves
             if (not MoveExecution::executeMove(m_gameState, move, MoveType::CapturesOnly))
             {
+                // The illegal move has been taken back, but the game state still points to the next accumulator
+                m_gameState.accumulator = gameStateCopy.accumulator;
                 // skip to next move
                 continue;
             }
 
+            m_moveStack[m_gameState.halfMoveClock] = move;
+
             // score current move
             const int32_t score = -quiescenceSearch(-beta, -alpha);
 
@@ -360,7 +544,7 @@ namespace ModernChess
             // fail-hard beta cutoff
             if (score >= beta)
             {
-                //GameState::transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, 0);
+                m_transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, 0);
                 // node (move) fails high
                 return beta;
             }
@@ -368,25 +552,65 @@ namespace ModernChess
             // found a better move
             if (score > alpha)
             {
-                //hashFlag = HashFlag::Exact; // Store PV node
+                hashFlag = HashFlag::Exact; // Store PV node
                 // PV node (move)
                 alpha = score;
             }
 
-            if (m_stopSearching())
+            if (searchHasToBeStopped())
             {
                 break;
             }
         }
 
-        //GameState::transpositionTable.addEntry(m_gameState.gameStateHash, hashFlag, alpha, 0);
+        m_transpositionTable.addEntry(m_gameState.gameStateHash, hashFlag, alpha, 0);
 
         // node (move) fails low
         return alpha;
     }
 
+    int32_t Evaluation::probeTranspositionTable(int32_t alpha, int32_t beta, uint8_t depth)
+    {
+        const int32_t score = m_transpositionTable.getScore(m_gameState.gameStateHash, alpha, beta, depth);
+
+        if constexpr (SearchStatisticsEnabled)
+        {
+            countStatistic(m_statistics.transpositionTableProbes);
+
+            if (m_transpositionTable.contains(m_gameState.gameStateHash))
+            {
+                countStatistic(m_statistics.transpositionTableHits);
+            }
+
+            if (score != TranspositionTable::NoHashEntryFound)
+            {
+                countStatistic(m_statistics.transpositionTableCutoffs);
+            }
+        }
+
+        return score;
+    }
+
+    SearchStatistics Evaluation::statistics() const
+    {
+        SearchStatistics statistics = m_statistics;
+
+        if constexpr (SearchStatisticsEnabled)
+        {
+            statistics.mainNodes = m_numberOfNodes;
+            statistics.quiescenceNodes = m_numberOfQuiescenceNodes;
+        }
+
+        return statistics;
+    }
+
     int32_t Evaluation::evaluatePosition() const
     {
+        if (m_neuralNetwork != nullptr)
+        {
+            return m_neuralNetwork->evaluate(*m_gameState.accumulator, m_gameState.board.sideToMove);
+        }
+
         // static evaluation score
         int32_t score = 0;
 
@@ -444,51 +668,147 @@ namespace ModernChess
         // score capture move
         if (move.isCapture())
         {
-            // init target figure with white pawn or black pawn (doesn't matter which one,
-            // because scoring with the same color yields the same valid score), in case of en-passant captures
-            Figure targetFigure = Figure::WhitePawn;
+            // score move by MVV LVA lookup [source piece][target piece]
+            return mvvLva[move.getMovedFigure()][capturedFigure(move)] + m_searchParameters.captureScoreOffset;
+        }
 
-            // pick up bitboard figure index ranges depending on side
-            Figure opponentsFigureStart;
-            Figure opponentsFigureEnd;
+        // score 1st killer move
+        if (m_killerMoves[0][m_gameState.halfMoveClock] == move)
+        {
+            return m_searchParameters.bestKillerMoveScore;
+        }
+
+        // score 2nd killer move
+        if (m_killerMoves[1][m_gameState.halfMoveClock] == move)
+        {
+            return m_searchParameters.secondBestKillerMoveScore;
+        }
+
+        // score counter move, i.e. the move which refuted the opponent's previous move last time
+        if (const Move lastMove = previousMove(1);
+            not lastMove.isNullMove() &&
+            m_historyTables.counterMoves[lastMove.getMovedFigure()][lastMove.getTo()] == move)
+        {
+            return m_searchParameters.counterMoveScore;
+        }
+
+        return scoreQuietMove(move);
+    }
 
-            if (m_gameState.board.sideToMove == Color::White)
+    Figure Evaluation::capturedFigure(Move move) const
+    {
+        // pick up bitboard figure index ranges depending on side
+        Figure opponentsFigureStart;
+        Figure opponentsFigureEnd;
+
+        if (m_gameState.board.sideToMove == Color::White)
+        {
+            opponentsFigureStart = Figure::BlackPawn;
+            opponentsFigureEnd = Figure::BlackKing;
+        }
+        else
+        {
+            opponentsFigureStart = Figure::WhitePawn;
+            opponentsFigureEnd = Figure::WhiteKing;
+        }
+
+        for (Figure figure = opponentsFigureStart; figure <= opponentsFigureEnd; ++figure)
+        {
+            if (BitBoardOperations::isOccupied(m_gameState.board.bitboards[figure], move.getTo()))
             {
-                opponentsFigureStart = Figure::BlackPawn;
-                opponentsFigureEnd = Figure::BlackKing;
+                return figure;
             }
-            else
+        }
+
+        // In case of en-passant captures, return white pawn or black pawn (doesn't matter which one,
+        // because scoring with the same color yields the same valid score)
+        return Figure::WhitePawn;
+    }
+
+    Move Evaluation::previousMove(int32_t pliesBack) const
+    {
+        Move move{};
+
+        for (int32_t ply = m_gameState.halfMoveClock; pliesBack > 0; --ply, --pliesBack)
+        {
+            // there are no moves before the root of the search
+            if (ply <= m_halfMoveClockRootSearch)
+            {
+                return {};
+            }
+
+            move = m_moveStack[ply];
+
+            // the move sequence is interrupted by a null move
+            if (move.isNullMove())
+            {
+                return {};
+            }
+        }
+
+        return move;
+    }
+
+    int32_t Evaluation::scoreQuietMove(Move move) const
+    {
+        const Figure figure = move.getMovedFigure();
+        const Square targetSquare = move.getTo();
+
+        int32_t score = m_historyTables.butterfly[m_gameState.board.sideToMove][move.getFrom()][targetSquare];
+
+        // continuation history of the previous move (1-ply) and of our own previous move (2-ply)
+        for (int32_t pliesBack = 1; pliesBack <= 2; ++pliesBack)
+        {
+            if (const Move lastMove = previousMove(pliesBack); not lastMove.isNullMove())
             {
-                opponentsFigureStart = Figure::WhitePawn;
-                opponentsFigureEnd = Figure::BlackKing;
+                score += m_historyTables.continuation[pliesBack - 1][lastMove.getMovedFigure()][lastMove.getTo()][figure][targetSquare];
             }
+        }
+
+        return score;
+    }
+
+    void Evaluation::updateQuietMoveHistories(Move bestMove, std::span<const Move> failedQuietMoves, uint8_t depth)
+    {
+        // The bonus is depth * depth, based on the assumption that otherwise moves from the plies near
+        // the leaves would have too much impact on the result.
+        const int32_t bonus = depth * depth;
 
-            for (Figure figure = opponentsFigureStart; figure <= opponentsFigureEnd; ++figure)
+        const Color sideToMove = m_gameState.board.sideToMove;
+        const std::array<Move, 2> lastMoves{previousMove(1), previousMove(2)};
+
+        auto updateHistories = [&](Move move, int32_t moveBonus)
+        {
+            HistoryTables::update(m_historyTables.butterfly[sideToMove][move.getFrom()][move.getTo()], moveBonus);
+
+            for (size_t index = 0; index < lastMoves.size(); ++index)
             {
-                if (BitBoardOperations::isOccupied(m_gameState.board.bitboards[figure], move.getTo()))
+                if (const Move lastMove = lastMoves[index]; not lastMove.isNullMove())
                 {
-                    targetFigure = figure;
-                    break;
+                    HistoryTables::update(m_historyTables.continuation[index][lastMove.getMovedFigure()][lastMove.getTo()]
+                                                                       [move.getMovedFigure()][move.getTo()], moveBonus);
                 }
             }
+        };
 
-            // score move by MVV LVA lookup [source piece][target piece]
-            return mvvLva[move.getMovedFigure()][targetFigure] + CaptureScoreOffset;
+        if (const Move lastMove = lastMoves[0]; not lastMove.isNullMove())
+        {
+            m_historyTables.counterMoves[lastMove.getMovedFigure()][lastMove.getTo()] = bestMove;
         }
 
-        // score 1st killer move
-        if (m_killerMoves[0][m_gameState.halfMoveClock] == move)
+        // A cutoff by the first quiet move close to the leaves is too common to tell anything about the move
+        if (depth <= 1 && failedQuietMoves.empty())
         {
-            return BestKillerMoveScore;
+            return;
         }
 
-        // score 2nd killer move
-        if (m_killerMoves[1][m_gameState.halfMoveClock] == move)
+        updateHistories(bestMove, bonus);
+
+        // the quiet moves searched before have failed to produce a cutoff
+        for (const Move failedMove : failedQuietMoves)
         {
-            return SecondBestKillerMoveScore;
+            updateHistories(failedMove, -bonus);
         }
-
-        return m_historyMoves[move.getMovedFigure()][move.getTo()];
     }
 
     bool Evaluation::isEndGame() const
@@ -1,16 +1,5 @@
 #include "ModernChess/GameState.h"
 
-namespace ModernChess
-{
-    const ZobristHasher GameState::m_hasher{};
-    TranspositionTable GameState::transpositionTable{};
-
-    GameState::GameState()
-    {
-        transpositionTable.clear();
-    }
-}
-
 std::ostream& operator<<(std::ostream& os, const ModernChess::GameState &gameState)
 {
     using namespace ModernChess;
@@ -0,0 +1,381 @@
+#include "ModernChess/LocalSocket.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // Writing to a socket closed by the other side must not terminate the process with SIGPIPE
+#ifdef MSG_NOSIGNAL
+    constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+    constexpr int SendFlags = 0;
+#endif
+
+    constexpr std::string_view LocalHostPrefix = "localhost:";
+
+    std::runtime_error socketError(std::string_view what, std::string_view address)
+    {
+        return std::runtime_error(std::string(what) + " " + std::string(address) + ": " + std::strerror(errno));
+    }
+
+    bool sendAll(int socket, const char *data, size_t size)
+    {
+        while (size > 0)
+        {
+            const ssize_t sentBytes = ::send(socket, data, size, SendFlags);
+
+            if (sentBytes < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+
+            data += sentBytes;
+            size -= size_t(sentBytes);
+        }
+
+        return true;
+    }
+
+    bool writeAll(int fileDescriptor, const char *data, size_t size)
+    {
+        while (size > 0)
+        {
+            const ssize_t writtenBytes = ::write(fileDescriptor, data, size);
+
+            if (writtenBytes < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+
+            data += writtenBytes;
+            size -= size_t(writtenBytes);
+        }
+
+        return true;
+    }
+
+    sockaddr_in tcpAddress(std::string_view address)
+    {
+        if (address.starts_with(LocalHostPrefix))
+        {
+            address.remove_prefix(LocalHostPrefix.size());
+        }
+
+        const std::string portString(address);
+        size_t parsedCharacters{};
+        int port{};
+
+        try
+        {
+            port = std::stoi(portString, &parsedCharacters);
+        }
+        catch (const std::logic_error &)
+        {
+            // std::invalid_argument or std::out_of_range
+            parsedCharacters = 0;
+        }
+
+        if (parsedCharacters != portString.size() or port <= 0 or port > 65535)
+        {
+            throw std::runtime_error("Invalid port " + portString);
+        }
+
+        sockaddr_in socketAddress{};
+        socketAddress.sin_family = AF_INET;
+        socketAddress.sin_port = htons(uint16_t(port));
+        // Only local clients are served
+        socketAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        return socketAddress;
+    }
+
+    sockaddr_un unixAddress(std::string_view address)
+    {
+        sockaddr_un socketAddress{};
+        socketAddress.sun_family = AF_UNIX;
+
+        if (address.empty() or address.size() >= sizeof(socketAddress.sun_path))
+        {
+            throw std::runtime_error("Invalid socket path " + std::string(address));
+        }
+
+        std::copy(address.begin(), address.end(), socketAddress.sun_path);
+
+        return socketAddress;
+    }
+
+    /**
+     * @brief Removes the socket file left behind by a server, which has not been shut down properly.
+     * @throws std::runtime_error if the path is not a socket or a server is still listening on it
+     */
+    void removeStaleSocketFile(const sockaddr_un &socketAddress)
+    {
+        const std::string path(socketAddress.sun_path);
+        struct stat fileStatus{};
+
+        if (::lstat(path.c_str(), &fileStatus) < 0)
+        {
+            // Nothing to remove
+            return;
+        }
+
+        if (not S_ISSOCK(fileStatus.st_mode))
+        {
+            throw std::runtime_error(path + " exists and is not a socket");
+        }
+
+        const int testSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (testSocket >= 0)
+        {
+            const bool serverIsRunning =
+                    ::connect(testSocket, reinterpret_cast<const sockaddr *>(&socketAddress), sizeof(socketAddress)) == 0;
+            ::close(testSocket);
+
+            if (serverIsRunning)
+            {
+                throw std::runtime_error("Another server is listening on " + path);
+            }
+        }
+
+        ::unlink(path.c_str());
+    }
+}
+
+namespace ModernChess::LocalSocket {
+
+    SocketStreamBuffer::SocketStreamBuffer(int socket) :
+            m_socket(socket)
+    {
+        setg(m_inputBuffer.data(), m_inputBuffer.data(), m_inputBuffer.data());
+        setp(m_outputBuffer.data(), m_outputBuffer.data() + m_outputBuffer.size());
+    }
+
+    SocketStreamBuffer::~SocketStreamBuffer()
+    {
+        sync();
+    }
+
+    SocketStreamBuffer::int_type SocketStreamBuffer::underflow()
+    {
+        if (gptr() < egptr())
+        {
+            return traits_type::to_int_type(*gptr());
+        }
+
+        ssize_t receivedBytes{};
+
+        do
+        {
+            receivedBytes = ::recv(m_socket, m_inputBuffer.data(), m_inputBuffer.size(), 0);
+        } while (receivedBytes < 0 and errno == EINTR);
+
+        if (receivedBytes <= 0)
+        {
+            return traits_type::eof();
+        }
+
+        setg(m_inputBuffer.data(), m_inputBuffer.data(), m_inputBuffer.data() + receivedBytes);
+
+        return traits_type::to_int_type(*gptr());
+    }
+
+    SocketStreamBuffer::int_type SocketStreamBuffer::overflow(int_type character)
+    {
+        if (sync() != 0)
+        {
+            return traits_type::eof();
+        }
+
+        if (not traits_type::eq_int_type(character, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(character);
+            pbump(1);
+        }
+
+        return traits_type::not_eof(character);
+    }
+
+    int SocketStreamBuffer::sync()
+    {
+        const bool sent = sendAll(m_socket, pbase(), size_t(pptr() - pbase()));
+
+        setp(m_outputBuffer.data(), m_outputBuffer.data() + m_outputBuffer.size());
+
+        return sent ? 0 : -1;
+    }
+
+    bool isTcpAddress(std::string_view address)
+    {
+        if (address.starts_with(LocalHostPrefix))
+        {
+            return true;
+        }
+
+        return not address.empty() and std::all_of(address.begin(), address.end(), [](char character){
+            return character >= '0' and character <= '9';
+        });
+    }
+
+    int listenOn(std::string_view address, int backlog)
+    {
+        const bool tcp = isTcpAddress(address);
+        const int listeningSocket = ::socket(tcp ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+
+        if (listeningSocket < 0)
+        {
+            throw socketError("Could not create a socket for", address);
+        }
+
+        int bindResult{};
+
+        if (tcp)
+        {
+            const int reuseAddress = 1;
+            ::setsockopt(listeningSocket, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
+
+            const sockaddr_in socketAddress = tcpAddress(address);
+            bindResult = ::bind(listeningSocket, reinterpret_cast<const sockaddr *>(&socketAddress), sizeof(socketAddress));
+        }
+        else
+        {
+            const sockaddr_un socketAddress = unixAddress(address);
+
+            try
+            {
+                removeStaleSocketFile(socketAddress);
+            }
+            catch (const std::runtime_error &)
+            {
+                ::close(listeningSocket);
+                throw;
+            }
+
+            bindResult = ::bind(listeningSocket, reinterpret_cast<const sockaddr *>(&socketAddress), sizeof(socketAddress));
+        }
+
+        if (bindResult < 0 or ::listen(listeningSocket, backlog) < 0)
+        {
+            const std::runtime_error error = socketError("Could not listen on", address);
+            ::close(listeningSocket);
+            throw error;
+        }
+
+        return listeningSocket;
+    }
+
+    int connectTo(std::string_view address)
+    {
+        const bool tcp = isTcpAddress(address);
+        const int connectedSocket = ::socket(tcp ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+
+        if (connectedSocket < 0)
+        {
+            throw socketError("Could not create a socket for", address);
+        }
+
+        int connectResult{};
+
+        if (tcp)
+        {
+            const sockaddr_in socketAddress = tcpAddress(address);
+            connectResult = ::connect(connectedSocket, reinterpret_cast<const sockaddr *>(&socketAddress), sizeof(socketAddress));
+        }
+        else
+        {
+            const sockaddr_un socketAddress = unixAddress(address);
+            connectResult = ::connect(connectedSocket, reinterpret_cast<const sockaddr *>(&socketAddress), sizeof(socketAddress));
+        }
+
+        if (connectResult < 0)
+        {
+            const std::runtime_error error = socketError("Could not connect to", address);
+            ::close(connectedSocket);
+            throw error;
+        }
+
+        return connectedSocket;
+    }
+
+    void relayStandardStreams(int socket)
+    {
+        std::array<char, 4096> buffer{};
+        std::array<pollfd, 2> fileDescriptors{pollfd{STDIN_FILENO, POLLIN, 0}, pollfd{socket, POLLIN, 0}};
+        bool inputIsOpen = true;
+
+        while (true)
+        {
+            // After the end of stdin, only the answers of the server are relayed
+            if (::poll(fileDescriptors.data(), inputIsOpen ? 2 : 1, -1) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return;
+            }
+
+            if (inputIsOpen and fileDescriptors[0].revents != 0)
+            {
+                const ssize_t readBytes = ::read(STDIN_FILENO, buffer.data(), buffer.size());
+
+                if (readBytes > 0)
+                {
+                    if (not sendAll(socket, buffer.data(), size_t(readBytes)))
+                    {
+                        return;
+                    }
+                }
+                else if (readBytes == 0 or errno != EINTR)
+                {
+                    // The server quits at the end of its input
+                    ::shutdown(socket, SHUT_WR);
+                    inputIsOpen = false;
+                    fileDescriptors[0] = fileDescriptors[1];
+                    continue;
+                }
+            }
+
+            pollfd &socketDescriptor = inputIsOpen ? fileDescriptors[1] : fileDescriptors[0];
+
+            if (socketDescriptor.revents != 0)
+            {
+                const ssize_t receivedBytes = ::recv(socket, buffer.data(), buffer.size(), 0);
+
+                if (receivedBytes == 0 or (receivedBytes < 0 and errno != EINTR))
+                {
+                    return;
+                }
+
+                if (receivedBytes > 0 and not writeAll(STDOUT_FILENO, buffer.data(), size_t(receivedBytes)))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    void closeSocket(int socket)
+    {
+        ::close(socket);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "ModernChess/Match.h"
+#include "ModernChess/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+
+namespace
+{
+    // Quantile of the normal distribution for the 95% confidence interval
+    constexpr double ConfidenceQuantile = 1.959964;
+    // Keeps the Elo difference finite, if one engine has won or lost all games
+    constexpr double MinimumScore = 1e-6;
+
+    double scoreToElo(double score)
+    {
+        score = std::clamp(score, MinimumScore, 1.0 - MinimumScore);
+        return 400.0 * std::log10(score / (1.0 - score));
+    }
+
+    double eloToScore(double elo)
+    {
+        return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+    }
+}
+
+namespace ModernChess
+{
+    double MatchResult::score() const
+    {
+        if (numberOfGames() == 0)
+        {
+            return 0.5;
+        }
+
+        return (wins + 0.5 * draws) / numberOfGames();
+    }
+
+    double MatchResult::eloDifference() const
+    {
+        return scoreToElo(score());
+    }
+
+    double MatchResult::eloErrorMargin() const
+    {
+        if (numberOfGames() == 0)
+        {
+            return 0.0;
+        }
+
+        const double meanScore = score();
+        const double variance = (wins * std::pow(1.0 - meanScore, 2) +
+                                 draws * std::pow(0.5 - meanScore, 2) +
+                                 losses * std::pow(meanScore, 2)) / numberOfGames();
+        const double deviation = ConfidenceQuantile * std::sqrt(variance / numberOfGames());
+
+        return (scoreToElo(meanScore + deviation) - scoreToElo(meanScore - deviation)) / 2;
+    }
+
+    double MatchResult::likelihoodOfSuperiority() const
+    {
+        if (wins + losses == 0)
+        {
+            return 0.5;
+        }
+
+        return 0.5 * (1.0 + std::erf((double(wins) - double(losses)) / std::sqrt(2.0 * (wins + losses))));
+    }
+
+    double MatchResult::logLikelihoodRatio(double elo0, double elo1) const
+    {
+        if (numberOfGames() == 0)
+        {
+            return 0.0;
+        }
+
+        const double meanScore = score();
+        const double variance = (wins * std::pow(1.0 - meanScore, 2) +
+                                 draws * std::pow(0.5 - meanScore, 2) +
+                                 losses * std::pow(meanScore, 2)) / numberOfGames();
+
+        // Without variance, e.g. only draws, the games say nothing about the hypotheses
+        if (variance <= 0.0)
+        {
+            return 0.0;
+        }
+
+        const double score0 = eloToScore(elo0);
+        const double score1 = eloToScore(elo1);
+
+        return numberOfGames() * (score1 - score0) * (2 * meanScore - score0 - score1) / (2 * variance);
+    }
+
+    std::ostream &operator<<(std::ostream &os, const MatchResult &matchResult)
+    {
+        const auto flags = os.flags();
+        const auto precision = os.precision();
+
+        os << "+" << matchResult.wins << " -" << matchResult.losses << " =" << matchResult.draws
+           << std::fixed << std::setprecision(1)
+           << "  Elo " << matchResult.eloDifference() << " +/- " << matchResult.eloErrorMargin()
+           << "  LOS " << 100 * matchResult.likelihoodOfSuperiority() << "%";
+
+        os.flags(flags);
+        os.precision(precision);
+
+        return os;
+    }
+
+    double Sprt::lowerBound() const
+    {
+        return std::log(beta / (1.0 - alpha));
+    }
+
+    double Sprt::upperBound() const
+    {
+        return std::log((1.0 - beta) / alpha);
+    }
+
+    Sprt::Status Sprt::status(const MatchResult &matchResult) const
+    {
+        const double logLikelihoodRatio = matchResult.logLikelihoodRatio(elo0, elo1);
+
+        if (logLikelihoodRatio >= upperBound())
+        {
+            return Status::AcceptH1;
+        }
+
+        if (logLikelihoodRatio <= lowerBound())
+        {
+            return Status::AcceptH0;
+        }
+
+        return Status::Continue;
+    }
+
+    std::ostream &operator<<(std::ostream &os, Sprt::Status status)
+    {
+        switch (status)
+        {
+            case Sprt::Status::Continue: return os << "continue";
+            case Sprt::Status::AcceptH0: return os << "H0 accepted";
+            case Sprt::Status::AcceptH1: return os << "H1 accepted";
+        }
+
+        return os;
+    }
+
+    Match::Match(Settings settings, EngineConfiguration first, EngineConfiguration second, std::vector<GameState> openings) :
+            m_settings(std::move(settings)),
+            m_first(std::move(first)),
+            m_second(std::move(second)),
+            m_openings(std::move(openings))
+    {
+        if (m_openings.empty())
+        {
+            throw std::invalid_argument("A match needs at least one opening");
+        }
+    }
+
+    MatchResult Match::run(const std::function<void(const SelfPlayGame &, uint32_t, const MatchResult &)> &onGameFinished)
+    {
+        ThreadPool threadPool(m_settings.concurrency);
+        std::mutex mutex;
+        MatchResult matchResult;
+        // Set by the SPRT. The running pairs are finished, but no new pairs are started.
+        std::atomic<bool> stopped = false;
+
+        const auto playGame = [&](size_t gameIndex) {
+            const GameState &opening = m_openings[(gameIndex / 2) % m_openings.size()];
+            const bool firstPlaysWhite = gameIndex % 2 == 0;
+            const EngineConfiguration &white = firstPlaysWhite ? m_first : m_second;
+            const EngineConfiguration &black = firstPlaysWhite ? m_second : m_first;
+
+            const SelfPlayGame game = SelfPlay::playGame(opening, white, black, m_settings.maximumNumberOfPlies, m_settings.adjudication);
+
+            const std::lock_guard lock(mutex);
+
+            if (game.result == GameResult::Draw)
+            {
+                ++matchResult.draws;
+            }
+            else if ((game.result == GameResult::WhiteWins) == firstPlaysWhite)
+            {
+                ++matchResult.wins;
+            }
+            else
+            {
+                ++matchResult.losses;
+            }
+
+            if (onGameFinished)
+            {
+                onGameFinished(game, uint32_t(gameIndex), matchResult);
+            }
+
+            if (m_settings.sprt and m_settings.sprt->status(matchResult) != Sprt::Status::Continue)
+            {
+                stopped = true;
+            }
+        };
+
+        const size_t numberOfPairs = (size_t(m_settings.numberOfGames) + 1) / 2;
+
+        threadPool.parallelFor(0, numberOfPairs, [&](size_t pairIndex) {
+            if (stopped)
+            {
+                return;
+            }
+
+            for (size_t gameIndex = 2 * pairIndex; gameIndex < std::min<size_t>(2 * pairIndex + 2, m_settings.numberOfGames); ++gameIndex)
+            {
+                playGame(gameIndex);
+            }
+        });
+
+        return matchResult;
+    }
+}
\ No newline at end of file
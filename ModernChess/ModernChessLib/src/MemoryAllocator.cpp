@@ -1,5 +1,19 @@
 #include "ModernChess/MemoryAllocator.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MODERN_CHESS_MAP_FILE
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
 namespace ModernChess
 {
     void* std_aligned_alloc(size_t alignment, size_t size)
@@ -27,7 +41,11 @@ namespace ModernChess
         const size_t size = ((allocSizeBytes + alignment - 1) / alignment) * alignment;
         void *mem = std_aligned_alloc(alignment, size);
 #if defined(MADV_HUGEPAGE)
-        madvise(mem, size, MADV_HUGEPAGE);
+        if (mem)
+        {
+            // Transparent huge pages reduce TLB misses of big tables
+            madvise(mem, size, MADV_HUGEPAGE);
+        }
 #endif
         return mem;
     }
@@ -40,6 +58,53 @@ namespace ModernChess
         _mm_free(ptr);
 #else
         std::free(ptr);
+#endif
+    }
+
+    std::shared_ptr<const uint8_t> MemoryAllocator::mapFile(const std::string &path, size_t &sizeInBytes)
+    {
+#ifdef MODERN_CHESS_MAP_FILE
+        const int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+
+        if (fileDescriptor < 0)
+        {
+            throw std::runtime_error("Could not open " + path + ": " + std::strerror(errno));
+        }
+
+        struct stat fileStatus{};
+
+        if (::fstat(fileDescriptor, &fileStatus) != 0 or fileStatus.st_size == 0)
+        {
+            ::close(fileDescriptor);
+            throw std::runtime_error("Could not read " + path);
+        }
+
+        sizeInBytes = size_t(fileStatus.st_size);
+        void *address = ::mmap(nullptr, sizeInBytes, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        // The mapping stays valid after closing the file
+        ::close(fileDescriptor);
+
+        if (address == MAP_FAILED)
+        {
+            throw std::runtime_error("Could not map " + path + ": " + std::strerror(errno));
+        }
+
+        return {static_cast<const uint8_t *>(address), [sizeInBytes](const uint8_t *mappedMemory) {
+            ::munmap(const_cast<uint8_t *>(mappedMemory), sizeInBytes);
+        }};
+#else
+        std::ifstream file(path, std::ios::binary);
+
+        if (not file)
+        {
+            throw std::runtime_error("Could not open " + path);
+        }
+
+        const auto memory = std::make_shared<std::vector<uint8_t>>(std::istreambuf_iterator<char>(file),
+                                                                   std::istreambuf_iterator<char>());
+        sizeInBytes = memory->size();
+
+        return {memory, memory->data()};
 #endif
     }
 }
\ No newline at end of file
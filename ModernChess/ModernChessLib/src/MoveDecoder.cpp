@@ -0,0 +1,232 @@
+#include "ModernChess/MoveDecoder.h"
+#include "ModernChess/AttackQueries.h"
+#include "ModernChess/BitBoardOperations.h"
+
+#include <initializer_list>
+
+namespace ModernChess
+{
+    Move MoveDecoder::decodeMove(const GameState &gameState, const UCIParser::UCIMove &uciMove)
+    {
+        const Board &board = gameState.board;
+        const Square from = uciMove.sourceSquare;
+        const Square to = uciMove.targetSquare;
+
+        // Illegal promotion characters are parsed as undefined squares
+        if (from > Square::h8 or to > Square::h8 or from == to)
+        {
+            return {};
+        }
+
+        const Color sideToMove = board.sideToMove;
+        const Color opponent = (sideToMove == Color::White) ? Color::Black : Color::White;
+        const Figure movedFigure = figureOnSquare(board, sideToMove, from);
+
+        if (movedFigure == Figure::None or BitBoardOperations::isOccupied(board.occupancies[sideToMove], to))
+        {
+            return {};
+        }
+
+        if (movedFigure == Figure::WhitePawn or movedFigure == Figure::BlackPawn)
+        {
+            return decodePawnMove(board, from, to, uciMove.promotionCharacter);
+        }
+
+        if (uciMove.promotionCharacter != '\0')
+        {
+            return {};
+        }
+
+        const BitBoardState occupancy = board.occupancies[Color::Both];
+        BitBoardState attacks = BoardState::empty;
+
+        switch (movedFigure)
+        {
+            case Figure::WhiteKnight:
+            case Figure::BlackKnight:
+                attacks = AttackQueries::knightAttackTable[from];
+                break;
+            case Figure::WhiteBishop:
+            case Figure::BlackBishop:
+                attacks = AttackQueries::bishopAttacks.getAttacks(from, occupancy);
+                break;
+            case Figure::WhiteRook:
+            case Figure::BlackRook:
+                attacks = AttackQueries::rookAttacks.getAttacks(from, occupancy);
+                break;
+            case Figure::WhiteQueen:
+            case Figure::BlackQueen:
+                attacks = AttackQueries::queenAttacks.getAttacks(from, occupancy);
+                break;
+            default:
+                // The king moves two squares only when castling
+                if (to == from + 2 or to == from - 2)
+                {
+                    return decodeCastlingMove(board, from, to);
+                }
+                attacks = AttackQueries::kingAttackTable[from];
+                break;
+        }
+
+        if (not BitBoardOperations::isOccupied(attacks, to))
+        {
+            return {};
+        }
+
+        const bool isCapture = BitBoardOperations::isOccupied(board.occupancies[opponent], to);
+
+        return Move{from, to, movedFigure, Figure::None, isCapture, false, false, false};
+    }
+
+    Figure MoveDecoder::figureOnSquare(const Board &board, Color color, Square square)
+    {
+        const Figure firstFigure = (color == Color::White) ? Figure::WhitePawn : Figure::BlackPawn;
+        const Figure lastFigure = (color == Color::White) ? Figure::WhiteKing : Figure::BlackKing;
+
+        for (Figure figure = firstFigure; figure <= lastFigure; ++figure)
+        {
+            if (BitBoardOperations::isOccupied(board.bitboards[figure], square))
+            {
+                return figure;
+            }
+        }
+
+        return Figure::None;
+    }
+
+    Figure MoveDecoder::promotedFigure(Color color, char promotionCharacter)
+    {
+        const bool white = color == Color::White;
+
+        switch (promotionCharacter)
+        {
+            case 'q':
+                return white ? Figure::WhiteQueen : Figure::BlackQueen;
+            case 'r':
+                return white ? Figure::WhiteRook : Figure::BlackRook;
+            case 'b':
+                return white ? Figure::WhiteBishop : Figure::BlackBishop;
+            case 'n':
+                return white ? Figure::WhiteKnight : Figure::BlackKnight;
+            default:
+                return Figure::None;
+        }
+    }
+
+    Move MoveDecoder::decodePawnMove(const Board &board, Square from, Square to, char promotionCharacter)
+    {
+        const Color sideToMove = board.sideToMove;
+        const bool white = sideToMove == Color::White;
+        const Figure pawn = white ? Figure::WhitePawn : Figure::BlackPawn;
+        const Color opponent = white ? Color::Black : Color::White;
+        const int32_t direction = white ? 8 : -8;
+
+        const bool isPromotion = white ? (to >= Square::a8) : (to <= Square::h1);
+        const Figure promotedPiece = promotedFigure(sideToMove, promotionCharacter);
+
+        // A promotion needs a promotion piece and other moves must not have one
+        if (isPromotion != (promotedPiece != Figure::None))
+        {
+            return {};
+        }
+
+        if (BitBoardOperations::isOccupied(AttackQueries::pawnAttackTable[sideToMove][from], to))
+        {
+            if (BitBoardOperations::isOccupied(board.occupancies[opponent], to))
+            {
+                return Move{from, to, pawn, promotedPiece, true, false, false, false};
+            }
+
+            if (to == board.enPassantTarget)
+            {
+                return Move{from, to, pawn, Figure::None, true, false, true, false};
+            }
+
+            return {};
+        }
+
+        const BitBoardState occupancy = board.occupancies[Color::Both];
+
+        if (BitBoardOperations::isOccupied(occupancy, to))
+        {
+            return {};
+        }
+
+        if (to == from + direction)
+        {
+            return Move{from, to, pawn, promotedPiece, false, false, false, false};
+        }
+
+        const bool isOnStartRank = white ? (from >= Square::a2 and from <= Square::h2)
+                                         : (from >= Square::a7 and from <= Square::h7);
+
+        if (to == from + 2 * direction and isOnStartRank and
+            not BitBoardOperations::isOccupied(occupancy, Square(from + direction)))
+        {
+            return Move{from, to, pawn, Figure::None, false, true, false, false};
+        }
+
+        return {};
+    }
+
+    Move MoveDecoder::decodeCastlingMove(const Board &board, Square from, Square to)
+    {
+        const auto squaresAreEmpty = [&board](std::initializer_list<Square> squares) {
+            for (const Square square : squares)
+            {
+                if (BitBoardOperations::isOccupied(board.occupancies[Color::Both], square))
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        // Like in the move generation, the target square of the king is checked by MoveExecution
+        bool castlingIsPossible = false;
+
+        if (board.sideToMove == Color::White and from == Square::e1)
+        {
+            const auto isAttacked = [&board](Square square) { return AttackQueries::squareIsAttackedByBlack(board, square); };
+
+            if (to == Square::g1)
+            {
+                castlingIsPossible = whiteCanCastleKingSide(board.castlingRights) and
+                                     squaresAreEmpty({Square::f1, Square::g1}) and
+                                     not isAttacked(Square::e1) and not isAttacked(Square::f1);
+            }
+            else if (to == Square::c1)
+            {
+                castlingIsPossible = whiteCanCastleQueenSide(board.castlingRights) and
+                                     squaresAreEmpty({Square::d1, Square::c1, Square::b1}) and
+                                     not isAttacked(Square::e1) and not isAttacked(Square::d1);
+            }
+        }
+        else if (board.sideToMove == Color::Black and from == Square::e8)
+        {
+            const auto isAttacked = [&board](Square square) { return AttackQueries::squareIsAttackedByWhite(board, square); };
+
+            if (to == Square::g8)
+            {
+                castlingIsPossible = blackCanCastleKingSide(board.castlingRights) and
+                                     squaresAreEmpty({Square::f8, Square::g8}) and
+                                     not isAttacked(Square::e8) and not isAttacked(Square::f8);
+            }
+            else if (to == Square::c8)
+            {
+                castlingIsPossible = blackCanCastleQueenSide(board.castlingRights) and
+                                     squaresAreEmpty({Square::d8, Square::c8, Square::b8}) and
+                                     not isAttacked(Square::e8) and not isAttacked(Square::d8);
+            }
+        }
+
+        if (not castlingIsPossible)
+        {
+            return {};
+        }
+
+        const Figure king = (board.sideToMove == Color::White) ? Figure::WhiteKing : Figure::BlackKing;
+
+        return Move{from, to, king, Figure::None, false, false, false, true};
+    }
+}
\ No newline at end of file
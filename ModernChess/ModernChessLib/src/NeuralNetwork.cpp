@@ -0,0 +1,354 @@
+#include "ModernChess/NeuralNetwork.h"
+#include "ModernChess/BitBoardOperations.h"
+#include "ModernChess/EvaluationParameters.h"
+#include "ModernChess/MemoryAllocator.h"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    using namespace ModernChess;
+
+    constexpr size_t HiddenSize = NeuralNetwork::HiddenSize;
+
+    /*
+     * File format, little endian:
+     *   FileHeader                                         64 bytes
+     *   int16 feature biases  [HiddenSize]
+     *   int16 feature weights [NumberOfFeatures][HiddenSize]
+     *   int8  output weights  [2][HiddenSize]              perspective of the side to move first
+     *
+     * The header size keeps the weights aligned, if the file is mapped to a page.
+     */
+    struct FileHeader
+    {
+        std::array<char, 4> magic{};
+        uint32_t version{};
+        uint32_t numberOfFeatures{};
+        uint32_t hiddenSize{};
+        int32_t outputBias{};
+        int32_t outputScale{};
+        std::array<uint8_t, 40> reserved{};
+    };
+    static_assert(sizeof(FileHeader) == 64);
+
+    constexpr std::array<char, 4> Magic{'M', 'C', 'N', 'N'};
+    constexpr uint32_t Version = 1;
+
+    constexpr size_t FeatureBiasesOffset = sizeof(FileHeader);
+    constexpr size_t FeatureWeightsOffset = FeatureBiasesOffset + HiddenSize * sizeof(int16_t);
+    constexpr size_t OutputWeightsOffset = FeatureWeightsOffset + NeuralNetwork::NumberOfFeatures * HiddenSize * sizeof(int16_t);
+    constexpr size_t FileSize = OutputWeightsOffset + 2 * HiddenSize * sizeof(int8_t);
+
+    static_assert(HiddenSize % 32 == 0, "The SIMD kernels process 32 neurons at once");
+
+    void addWeights(int16_t *values, const int16_t *weights)
+    {
+#if defined(__AVX2__)
+        for (size_t index = 0; index < HiddenSize; index += 16)
+        {
+            const __m256i sum = _mm256_add_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + index)),
+                                                 _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + index)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + index), sum);
+        }
+#elif defined(__SSE4_1__)
+        for (size_t index = 0; index < HiddenSize; index += 8)
+        {
+            const __m128i sum = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values + index)),
+                                              _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + index)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(values + index), sum);
+        }
+#else
+        for (size_t index = 0; index < HiddenSize; ++index)
+        {
+            values[index] = int16_t(values[index] + weights[index]);
+        }
+#endif
+    }
+
+    void subtractWeights(int16_t *values, const int16_t *weights)
+    {
+#if defined(__AVX2__)
+        for (size_t index = 0; index < HiddenSize; index += 16)
+        {
+            const __m256i difference = _mm256_sub_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + index)),
+                                                        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + index)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + index), difference);
+        }
+#elif defined(__SSE4_1__)
+        for (size_t index = 0; index < HiddenSize; index += 8)
+        {
+            const __m128i difference = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values + index)),
+                                                     _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + index)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(values + index), difference);
+        }
+#else
+        for (size_t index = 0; index < HiddenSize; ++index)
+        {
+            values[index] = int16_t(values[index] - weights[index]);
+        }
+#endif
+    }
+
+    /**
+     * @return sum of the neurons clipped to [0, ClippingLimit] and multiplied by the weights
+     */
+    int32_t clippedDotProduct(const int16_t *values, const int8_t *weights)
+    {
+#if defined(__AVX2__)
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i limit = _mm256_set1_epi16(NeuralNetwork::ClippingLimit);
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i sum = zero;
+
+        for (size_t index = 0; index < HiddenSize; index += 32)
+        {
+            const __m256i first = _mm256_min_epi16(_mm256_max_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + index)), zero), limit);
+            const __m256i second = _mm256_min_epi16(_mm256_max_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + index + 16)), zero), limit);
+            // Packing works per 128 bit lane, so the 64 bit blocks have to be put back into order
+            const __m256i inputs = _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0b11'01'10'00);
+            const __m256i products = _mm256_maddubs_epi16(inputs, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + index)));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+        }
+
+        __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0b01'00'11'10));
+        sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0b10'11'00'01));
+        return _mm_cvtsi128_si32(sum128);
+#elif defined(__SSE4_1__)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i limit = _mm_set1_epi16(NeuralNetwork::ClippingLimit);
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i sum = zero;
+
+        for (size_t index = 0; index < HiddenSize; index += 16)
+        {
+            const __m128i first = _mm_min_epi16(_mm_max_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values + index)), zero), limit);
+            const __m128i second = _mm_min_epi16(_mm_max_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(values + index + 8)), zero), limit);
+            const __m128i inputs = _mm_packus_epi16(first, second);
+            const __m128i products = _mm_maddubs_epi16(inputs, _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + index)));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(products, ones));
+        }
+
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0b01'00'11'10));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0b10'11'00'01));
+        return _mm_cvtsi128_si32(sum);
+#else
+        int32_t sum = 0;
+
+        for (size_t index = 0; index < HiddenSize; ++index)
+        {
+            sum += std::clamp<int32_t>(values[index], 0, NeuralNetwork::ClippingLimit) * weights[index];
+        }
+
+        return sum;
+#endif
+    }
+
+    template<typename T>
+    void writeValue(std::vector<uint8_t> &memory, size_t offset, T value)
+    {
+        std::memcpy(memory.data() + offset, &value, sizeof(T));
+    }
+}
+
+namespace ModernChess
+{
+    NeuralNetwork::NeuralNetwork(std::shared_ptr<const uint8_t> memory, size_t sizeInBytes) :
+            m_memory(std::move(memory)),
+            m_sizeInBytes(sizeInBytes)
+    {
+        FileHeader header;
+
+        if (m_sizeInBytes != FileSize)
+        {
+            throw std::runtime_error("The network has " + std::to_string(m_sizeInBytes) + " bytes instead of " +
+                                     std::to_string(FileSize) + " bytes");
+        }
+
+        std::memcpy(&header, m_memory.get(), sizeof(FileHeader));
+
+        if (header.magic != Magic or header.version != Version)
+        {
+            throw std::runtime_error("The network has an unknown format");
+        }
+
+        if (header.numberOfFeatures != NumberOfFeatures or header.hiddenSize != HiddenSize)
+        {
+            throw std::runtime_error("The network has another architecture than 768 -> 2x64 -> 1");
+        }
+
+        m_featureBiases = reinterpret_cast<const int16_t *>(m_memory.get() + FeatureBiasesOffset);
+        m_featureWeights = reinterpret_cast<const int16_t *>(m_memory.get() + FeatureWeightsOffset);
+        m_outputWeights = reinterpret_cast<const int8_t *>(m_memory.get() + OutputWeightsOffset);
+        m_outputBias = header.outputBias;
+        m_outputScale = header.outputScale;
+    }
+
+    std::shared_ptr<const NeuralNetwork> NeuralNetwork::defaultNetwork()
+    {
+        /*
+         * Every perspective computes the material and positional score v of its side like the handcrafted
+         * evaluation. The clipped neuron k yields clamp(v - 127 * k, 0, 127), so the sum of 32 neurons is
+         * clamp(v, 0, 32 * 127). The other 32 neurons do the same for -v. The output is the difference.
+         */
+        constexpr size_t NumberOfNeuronsPerSign = HiddenSize / 2;
+
+        static const std::shared_ptr<const NeuralNetwork> network = [] {
+            // The material of the kings cancels out, so it is left out in order to keep the weights small
+            const auto scoreFromViewOfWhite = [](Figure figure, Square square) {
+                int32_t score = (figure == Figure::WhiteKing or figure == Figure::BlackKing) ? 0 : EvaluationParameters::materialScore[figure];
+                const Square mirroredSquare = Square(square ^ 56);
+
+                switch (figure)
+                {
+                    case Figure::WhitePawn: score += EvaluationParameters::pawnScore[square]; break;
+                    case Figure::WhiteKnight: score += EvaluationParameters::knightScore[square]; break;
+                    case Figure::WhiteBishop: score += EvaluationParameters::bishopScore[square]; break;
+                    case Figure::WhiteRook: score += EvaluationParameters::rookScore[square]; break;
+                    case Figure::WhiteKing: score += EvaluationParameters::kingScore[square]; break;
+                    case Figure::BlackPawn: score -= EvaluationParameters::pawnScore[mirroredSquare]; break;
+                    case Figure::BlackKnight: score -= EvaluationParameters::knightScore[mirroredSquare]; break;
+                    case Figure::BlackBishop: score -= EvaluationParameters::bishopScore[mirroredSquare]; break;
+                    case Figure::BlackRook: score -= EvaluationParameters::rookScore[mirroredSquare]; break;
+                    case Figure::BlackKing: score -= EvaluationParameters::kingScore[mirroredSquare]; break;
+                    default:
+                        // Queens have no positional score
+                        break;
+                }
+
+                return score;
+            };
+
+            auto memory = std::make_shared<std::vector<uint8_t>>(FileSize);
+
+            FileHeader header;
+            header.magic = Magic;
+            header.version = Version;
+            header.numberOfFeatures = NumberOfFeatures;
+            header.hiddenSize = HiddenSize;
+            header.outputBias = 0;
+            header.outputScale = OutputScaleDivisor;
+            std::memcpy(memory->data(), &header, sizeof(FileHeader));
+
+            for (size_t neuron = 0; neuron < NumberOfNeuronsPerSign; ++neuron)
+            {
+                const auto bias = int16_t(-ClippingLimit * int32_t(neuron));
+                writeValue(*memory, FeatureBiasesOffset + neuron * sizeof(int16_t), bias);
+                writeValue(*memory, FeatureBiasesOffset + (NumberOfNeuronsPerSign + neuron) * sizeof(int16_t), bias);
+
+                writeValue(*memory, OutputWeightsOffset + neuron, int8_t(1));
+                writeValue(*memory, OutputWeightsOffset + NumberOfNeuronsPerSign + neuron, int8_t(-1));
+            }
+
+            // The features are indexed from the view of white, see featureIndex()
+            for (Figure figure = Figure::WhitePawn; figure <= Figure::BlackKing; ++figure)
+            {
+                for (int32_t square = Square::a1; square <= Square::h8; ++square)
+                {
+                    const int32_t score = scoreFromViewOfWhite(figure, Square(square));
+                    const size_t featureOffset = FeatureWeightsOffset + featureIndex(Color::White, figure, Square(square)) * HiddenSize * sizeof(int16_t);
+
+                    for (size_t neuron = 0; neuron < NumberOfNeuronsPerSign; ++neuron)
+                    {
+                        writeValue(*memory, featureOffset + neuron * sizeof(int16_t), int16_t(score));
+                        writeValue(*memory, featureOffset + (NumberOfNeuronsPerSign + neuron) * sizeof(int16_t), int16_t(-score));
+                    }
+                }
+            }
+
+            return std::shared_ptr<const NeuralNetwork>(new NeuralNetwork({memory, memory->data()}, FileSize));
+        }();
+
+        return network;
+    }
+
+    std::shared_ptr<const NeuralNetwork> NeuralNetwork::load(const std::string &path)
+    {
+        size_t sizeInBytes = 0;
+        std::shared_ptr<const uint8_t> memory = MemoryAllocator::mapFile(path, sizeInBytes);
+
+        try
+        {
+            return std::shared_ptr<const NeuralNetwork>(new NeuralNetwork(std::move(memory), sizeInBytes));
+        }
+        catch (const std::runtime_error &error)
+        {
+            throw std::runtime_error(path + ": " + error.what());
+        }
+    }
+
+    void NeuralNetwork::save(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(m_memory.get()), std::streamsize(m_sizeInBytes));
+
+        if (not file)
+        {
+            throw std::runtime_error("Could not write " + path);
+        }
+    }
+
+    void NeuralNetwork::refresh(Accumulator &accumulator, const Board &board) const
+    {
+        accumulator.network = this;
+
+        for (auto &values : accumulator.values)
+        {
+            std::copy_n(m_featureBiases, HiddenSize, values.begin());
+        }
+
+        for (Figure figure = Figure::WhitePawn; figure <= Figure::BlackKing; ++figure)
+        {
+            for (BitBoardState bitboard = board.bitboards[figure]; bitboard != BoardState::empty; )
+            {
+                const Square square = BitBoardOperations::bitScanForward(bitboard);
+                addFigure(accumulator, figure, square);
+                bitboard = BitBoardOperations::eraseSquare(bitboard, square);
+            }
+        }
+    }
+
+    int32_t NeuralNetwork::evaluate(const Accumulator &accumulator, Color sideToMove) const
+    {
+        const Color opponent = (sideToMove == Color::White) ? Color::Black : Color::White;
+        const int32_t output = clippedDotProduct(accumulator.values[sideToMove].data(), m_outputWeights) +
+                               clippedDotProduct(accumulator.values[opponent].data(), m_outputWeights + HiddenSize);
+
+        return int32_t((int64_t(m_outputBias) + output) * m_outputScale / OutputScaleDivisor);
+    }
+
+    void NeuralNetwork::addFigure(Accumulator &accumulator, Figure figure, Square square) const
+    {
+        addWeights(accumulator.values[Color::White].data(), m_featureWeights + featureIndex(Color::White, figure, square) * HiddenSize);
+        addWeights(accumulator.values[Color::Black].data(), m_featureWeights + featureIndex(Color::Black, figure, square) * HiddenSize);
+    }
+
+    void NeuralNetwork::removeFigure(Accumulator &accumulator, Figure figure, Square square) const
+    {
+        subtractWeights(accumulator.values[Color::White].data(), m_featureWeights + featureIndex(Color::White, figure, square) * HiddenSize);
+        subtractWeights(accumulator.values[Color::Black].data(), m_featureWeights + featureIndex(Color::Black, figure, square) * HiddenSize);
+    }
+
+    size_t NeuralNetwork::featureIndex(Color perspective, Figure figure, Square square)
+    {
+        if (perspective == Color::White)
+        {
+            return size_t(figure) * NumberOfSquares + size_t(square);
+        }
+
+        // Black sees the board upside down and its figures as the own ones
+        constexpr uint8_t NumberOfFiguresPerColor = NumberOfFigureTypes / 2;
+        const auto swappedFigure = size_t((figure + NumberOfFiguresPerColor) % NumberOfFigureTypes);
+
+        return swappedFigure * NumberOfSquares + size_t(square ^ 56);
+    }
+}
\ No newline at end of file
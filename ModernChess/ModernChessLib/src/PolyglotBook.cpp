@@ -0,0 +1,237 @@
+#include "ModernChess/PolyglotBook.h"
+#include "ModernChess/BitBoardOperations.h"
+#include "ModernChess/MemoryAllocator.h"
+#include "ModernChess/MoveDecoder.h"
+#include "ModernChess/MoveExecution.h"
+#include "ModernChess/PolyglotHasher.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+    using namespace ModernChess;
+
+    // Offsets of the values in an entry
+    constexpr size_t MoveOffset = 8;
+    constexpr size_t WeightOffset = 10;
+    constexpr size_t LearnOffset = 12;
+
+    // Promoted figures in the order of the Polyglot encoding, which starts at 1
+    constexpr std::string_view PromotionCharacters = "nbrq";
+
+    template<typename T>
+    T readBigEndian(const uint8_t *memory)
+    {
+        T value = 0;
+
+        for (size_t byteIndex = 0; byteIndex < sizeof(T); ++byteIndex)
+        {
+            value = T(value << 8) | memory[byteIndex];
+        }
+
+        return value;
+    }
+
+    template<typename T>
+    void writeBigEndian(std::vector<uint8_t> &memory, size_t offset, T value)
+    {
+        for (size_t byteIndex = sizeof(T); byteIndex > 0; --byteIndex)
+        {
+            memory[offset + byteIndex - 1] = uint8_t(value & 0xFF);
+            value = T(value >> 8);
+        }
+    }
+
+    bool kingIsOnSquare(const Board &board, Square square)
+    {
+        const Figure king = (board.sideToMove == Color::White) ? Figure::WhiteKing : Figure::BlackKing;
+        return BitBoardOperations::isOccupied(board.bitboards[king], square);
+    }
+}
+
+namespace ModernChess
+{
+    PolyglotBook::PolyglotBook(std::shared_ptr<const uint8_t> memory, size_t numberOfEntries) :
+            m_memory(std::move(memory)),
+            m_numberOfEntries(numberOfEntries)
+    {}
+
+    std::shared_ptr<const PolyglotBook> PolyglotBook::load(const std::string &path)
+    {
+        size_t sizeInBytes = 0;
+        std::shared_ptr<const uint8_t> memory = MemoryAllocator::mapFile(path, sizeInBytes);
+
+        if (sizeInBytes % EntrySize != 0)
+        {
+            throw std::runtime_error(path + ": The book has " + std::to_string(sizeInBytes) +
+                                     " bytes, which is not a multiple of the entry size");
+        }
+
+        return std::shared_ptr<const PolyglotBook>(new PolyglotBook(std::move(memory), sizeInBytes / EntrySize));
+    }
+
+    void PolyglotBook::save(const std::string &path, std::vector<PolyglotEntry> entries)
+    {
+        std::stable_sort(entries.begin(), entries.end(), [](const PolyglotEntry &lhs, const PolyglotEntry &rhs) {
+            return lhs.key < rhs.key;
+        });
+
+        std::vector<uint8_t> memory(entries.size() * EntrySize);
+
+        for (size_t index = 0; index < entries.size(); ++index)
+        {
+            const size_t offset = index * EntrySize;
+            writeBigEndian(memory, offset, entries[index].key);
+            writeBigEndian(memory, offset + MoveOffset, entries[index].move);
+            writeBigEndian(memory, offset + WeightOffset, entries[index].weight);
+            writeBigEndian(memory, offset + LearnOffset, entries[index].learn);
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(memory.data()), std::streamsize(memory.size()));
+
+        if (not file)
+        {
+            throw std::runtime_error("Could not write " + path);
+        }
+    }
+
+    PolyglotEntry PolyglotBook::entry(size_t index) const
+    {
+        const uint8_t *memory = m_memory.get() + index * EntrySize;
+
+        return PolyglotEntry{readBigEndian<uint64_t>(memory),
+                             readBigEndian<uint16_t>(memory + MoveOffset),
+                             readBigEndian<uint16_t>(memory + WeightOffset),
+                             readBigEndian<uint32_t>(memory + LearnOffset)};
+    }
+
+    uint64_t PolyglotBook::keyAt(size_t index) const
+    {
+        return readBigEndian<uint64_t>(m_memory.get() + index * EntrySize);
+    }
+
+    std::vector<PolyglotEntry> PolyglotBook::findEntries(uint64_t key) const
+    {
+        // Lower bound: index of the first entry, whose key is not less than the searched one
+        size_t begin = 0;
+        size_t end = m_numberOfEntries;
+
+        while (begin < end)
+        {
+            const size_t middle = begin + (end - begin) / 2;
+
+            if (keyAt(middle) < key)
+            {
+                begin = middle + 1;
+            }
+            else
+            {
+                end = middle;
+            }
+        }
+
+        std::vector<PolyglotEntry> entries;
+
+        for (size_t index = begin; index < m_numberOfEntries and keyAt(index) == key; ++index)
+        {
+            entries.push_back(entry(index));
+        }
+
+        return entries;
+    }
+
+    Move PolyglotBook::chooseMove(const GameState &gameState, uint32_t randomNumber) const
+    {
+        std::vector<std::pair<Move, uint32_t>> weightedMoves;
+        uint32_t totalWeight = 0;
+
+        for (const PolyglotEntry &bookEntry : findEntries(PolyglotHasher::generateHash(gameState.board)))
+        {
+            const Move move = decodeMove(gameState, bookEntry.move);
+            GameState nextGameState = gameState;
+
+            // Keys can collide and books can be broken, so only legal moves are played
+            if (bookEntry.weight == 0 or move.isNullMove() or
+                not MoveExecution::executeMove(nextGameState, move, MoveType::AllMoves))
+            {
+                continue;
+            }
+
+            weightedMoves.emplace_back(move, bookEntry.weight);
+            totalWeight += bookEntry.weight;
+        }
+
+        if (totalWeight == 0)
+        {
+            return Move();
+        }
+
+        uint32_t selectedWeight = randomNumber % totalWeight;
+
+        for (const auto &[move, weight] : weightedMoves)
+        {
+            if (selectedWeight < weight)
+            {
+                return move;
+            }
+
+            selectedWeight -= weight;
+        }
+
+        return weightedMoves.back().first;
+    }
+
+    uint16_t PolyglotBook::encodeMove(Move move)
+    {
+        const Square from = move.getFrom();
+        Square to = move.getTo();
+
+        if (move.isCastlingMove())
+        {
+            // The king moves to the square of the rook
+            to = Square(to > from ? to + 1 : to - 2);
+        }
+
+        uint16_t promotion = 0;
+
+        if (move.getPromotedPiece() != Figure::None)
+        {
+            constexpr uint8_t NumberOfFiguresPerColor = NumberOfFigureTypes / 2;
+            // knight: 1, bishop: 2, rook: 3, queen: 4
+            promotion = move.getPromotedPiece() % NumberOfFiguresPerColor;
+        }
+
+        return uint16_t(to | (from << 6) | (promotion << 12));
+    }
+
+    Move PolyglotBook::decodeMove(const GameState &gameState, uint16_t polyglotMove)
+    {
+        const auto from = Square((polyglotMove >> 6) & 0x3F);
+        auto to = Square(polyglotMove & 0x3F);
+        const uint16_t promotion = (polyglotMove >> 12) & 0x7;
+
+        if (promotion > PromotionCharacters.size())
+        {
+            return Move();
+        }
+
+        // Castling is encoded as the king capturing its own rook
+        if ((from == Square::e1 and (to == Square::h1 or to == Square::a1)) or
+            (from == Square::e8 and (to == Square::h8 or to == Square::a8)))
+        {
+            if (kingIsOnSquare(gameState.board, from))
+            {
+                to = Square(to > from ? to - 1 : to + 2);
+            }
+        }
+
+        const char promotionCharacter = (promotion == 0) ? '\0' : PromotionCharacters[promotion - 1];
+
+        return MoveDecoder::decodeMove(gameState, UCIParser::UCIMove(from, to, promotion != 0, promotionCharacter));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,292 @@
+#include "ModernChess/SearchScheduler.h"
+#include "ModernChess/Evaluation.h"
+#include "ModernChess/SearchContext.h"
+
+#include <ucontext.h>
+
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+    // The search recurses at most MaxHalfMoves plies deep. The pages are only committed when they are used.
+    constexpr size_t StackSize = 1024 * 1024;
+
+    // makecontext() passes only int arguments, so the pointer to the function is split up.
+    // Pointers, which fit into an int, have no upper bits.
+    constexpr bool PointersHaveUpperBits = sizeof(uintptr_t) > sizeof(unsigned int);
+
+    unsigned int upperBitsOf(uintptr_t address)
+    {
+        if constexpr (PointersHaveUpperBits)
+        {
+            return static_cast<unsigned int>(address >> 32);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    void runCoroutine(unsigned int upperBits, unsigned int lowerBits)
+    {
+        uintptr_t address = uintptr_t(lowerBits);
+
+        if constexpr (PointersHaveUpperBits)
+        {
+            address |= uintptr_t(upperBits) << 32;
+        }
+
+        (*reinterpret_cast<std::function<void()> *>(address))();
+    }
+}
+
+namespace ModernChess {
+
+    struct SearchScheduler::Task {
+        GameState gameState;
+        SearchTaskLimits limits;
+        std::chrono::steady_clock::time_point submissionTime;
+        std::promise<SearchTaskResult> promise;
+        SearchTaskResult result{};
+        std::exception_ptr exception{};
+        bool stopRequested = false;
+        bool finished = false;
+        size_t slotIndex{};
+        ucontext_t context{};
+        std::function<void()> coroutine{};
+
+        void deliverResult()
+        {
+            result.latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - submissionTime);
+
+            if (exception)
+            {
+                promise.set_exception(exception);
+            }
+            else
+            {
+                promise.set_value(result);
+            }
+        }
+    };
+
+    struct SearchScheduler::Worker {
+        // Memory of one active task, which is reused by the following tasks
+        struct Slot {
+            explicit Slot(size_t hashSizeInMB) :
+                    searchContext(hashSizeInMB),
+                    stack(new char[StackSize])
+            {}
+
+            SearchContext searchContext;
+            std::unique_ptr<char[]> stack;
+        };
+
+        // The tasks always run on the thread of their worker, so they never migrate between threads
+        ucontext_t schedulerContext{};
+        std::deque<std::unique_ptr<Task>> activeTasks;
+        std::vector<std::unique_ptr<Slot>> slots;
+        std::vector<size_t> freeSlots;
+    };
+
+    SearchScheduler::SearchScheduler(uint32_t numberOfThreads,
+                                     uint64_t timeSliceInNodes,
+                                     uint32_t maxActiveTasksPerThread,
+                                     size_t hashSizePerTaskInMB) :
+            m_timeSliceInNodes(std::max<uint64_t>(timeSliceInNodes, 1)),
+            m_maxActiveTasksPerThread(std::max(maxActiveTasksPerThread, 1u)),
+            m_hashSizePerTaskInMB(hashSizePerTaskInMB)
+    {
+        numberOfThreads = std::max(numberOfThreads, 1u);
+
+        for (uint32_t thread = 0; thread < numberOfThreads; ++thread)
+        {
+            m_workers.push_back(std::make_unique<Worker>());
+        }
+
+        for (const std::unique_ptr<Worker> &worker : m_workers)
+        {
+            m_threads.emplace_back(&SearchScheduler::runWorker, this, std::ref(*worker));
+        }
+    }
+
+    SearchScheduler::~SearchScheduler()
+    {
+        std::deque<std::unique_ptr<Task>> pendingTasks;
+
+        {
+            const std::scoped_lock lock{m_mutex};
+            m_stopped = true;
+            pendingTasks.swap(m_pendingTasks);
+        }
+
+        m_taskHasBeenSubmitted.notify_all();
+
+        for (const std::unique_ptr<Task> &task : pendingTasks)
+        {
+            task->deliverResult();
+        }
+
+        for (std::thread &thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    std::future<SearchTaskResult> SearchScheduler::submit(const GameState &gameState, const SearchTaskLimits &limits)
+    {
+        auto task = std::make_unique<Task>();
+        task->gameState = gameState;
+        task->limits = limits;
+        task->submissionTime = std::chrono::steady_clock::now();
+
+        std::future<SearchTaskResult> future = task->promise.get_future();
+
+        {
+            const std::scoped_lock lock{m_mutex};
+
+            if (m_stopped)
+            {
+                task->deliverResult();
+                return future;
+            }
+
+            m_pendingTasks.push_back(std::move(task));
+        }
+
+        m_taskHasBeenSubmitted.notify_one();
+
+        return future;
+    }
+
+    size_t SearchScheduler::numberOfPendingTasks() const
+    {
+        const std::scoped_lock lock{m_mutex};
+        return m_pendingTasks.size();
+    }
+
+    void SearchScheduler::runWorker(Worker &worker)
+    {
+        const auto search = [this, &worker](Task &task, SearchContext &searchContext) {
+            const bool hasDeadline = task.limits.time > std::chrono::milliseconds(0);
+            const auto deadline = task.submissionTime + task.limits.time;
+            const auto deadlineIsOver = [hasDeadline, deadline] {
+                return hasDeadline and std::chrono::steady_clock::now() >= deadline;
+            };
+
+            if (deadlineIsOver())
+            {
+                return;
+            }
+
+            searchContext.clear();
+
+            Evaluation evaluation(searchContext, task.gameState, [&task] { return task.stopRequested; });
+            evaluation.setYieldFunction([&task, &worker, &deadlineIsOver](uint64_t numberOfNodes) {
+                if (numberOfNodes >= task.limits.nodes or deadlineIsOver())
+                {
+                    task.stopRequested = true;
+                }
+
+                swapcontext(&task.context, &worker.schedulerContext);
+            }, m_timeSliceInNodes);
+
+            const IterativeDeepeningResult result = evaluation.searchIteratively(task.limits.depth);
+
+            task.result.bestMove = result.bestMove();
+            task.result.score = result.score;
+            task.result.depth = result.depth;
+            task.result.numberOfNodes = result.numberOfNodes;
+            task.result.completed = result.completed;
+        };
+
+        while (true)
+        {
+            bool stopped{};
+
+            {
+                std::unique_lock lock{m_mutex};
+                m_taskHasBeenSubmitted.wait(lock, [this, &worker] {
+                    return m_stopped or not worker.activeTasks.empty() or not m_pendingTasks.empty();
+                });
+
+                // Admit new tasks as long as there are free slots
+                while (worker.activeTasks.size() < m_maxActiveTasksPerThread and not m_pendingTasks.empty())
+                {
+                    worker.activeTasks.push_back(std::move(m_pendingTasks.front()));
+                    m_pendingTasks.pop_front();
+
+                    Task &task = *worker.activeTasks.back();
+
+                    if (worker.freeSlots.empty())
+                    {
+                        worker.freeSlots.push_back(worker.slots.size());
+                        worker.slots.push_back(std::make_unique<Worker::Slot>(m_hashSizePerTaskInMB));
+                    }
+
+                    task.slotIndex = worker.freeSlots.back();
+                    worker.freeSlots.pop_back();
+
+                    Worker::Slot &slot = *worker.slots[task.slotIndex];
+
+                    task.coroutine = [&task, &slot, &search] {
+                        try
+                        {
+                            search(task, slot.searchContext);
+                        }
+                        catch (...)
+                        {
+                            task.exception = std::current_exception();
+                        }
+
+                        task.finished = true;
+                    };
+
+                    // After the coroutine has finished, the worker continues
+                    getcontext(&task.context);
+                    task.context.uc_stack.ss_sp = slot.stack.get();
+                    task.context.uc_stack.ss_size = StackSize;
+                    task.context.uc_link = &worker.schedulerContext;
+
+                    const auto address = reinterpret_cast<uintptr_t>(&task.coroutine);
+                    makecontext(&task.context, reinterpret_cast<void (*)()>(&runCoroutine), 2,
+                                upperBitsOf(address), static_cast<unsigned int>(address));
+                }
+
+                if (worker.activeTasks.empty())
+                {
+                    if (m_stopped)
+                    {
+                        return;
+                    }
+                    continue;
+                }
+
+                stopped = m_stopped;
+            }
+
+            std::unique_ptr<Task> task = std::move(worker.activeTasks.front());
+            worker.activeTasks.pop_front();
+
+            if (stopped)
+            {
+                task->stopRequested = true;
+            }
+
+            // Runs the task until it yields or finishes
+            swapcontext(&worker.schedulerContext, &task->context);
+
+            if (task->finished)
+            {
+                worker.freeSlots.push_back(task->slotIndex);
+                task->deliverResult();
+            }
+            else
+            {
+                worker.activeTasks.push_back(std::move(task));
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "ModernChess/SearchStatistics.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace ModernChess
+{
+    double SearchStatistics::firstMoveCutoffRate() const
+    {
+        return betaCutoffs == 0 ? 0.0 : 100.0 * double(firstMoveBetaCutoffs) / double(betaCutoffs);
+    }
+
+    double SearchStatistics::effectiveBranchingFactor(size_t depth) const
+    {
+        if (depth < 2 || depth >= nodesPerDepth.size() || nodesPerDepth[depth - 1] == 0)
+        {
+            return 0.0;
+        }
+
+        return double(nodesPerDepth[depth]) / double(nodesPerDepth[depth - 1]);
+    }
+
+    SearchStatistics &SearchStatistics::operator+=(const SearchStatistics &other)
+    {
+        transpositionTableProbes += other.transpositionTableProbes;
+        transpositionTableHits += other.transpositionTableHits;
+        transpositionTableCutoffs += other.transpositionTableCutoffs;
+        betaCutoffs += other.betaCutoffs;
+        firstMoveBetaCutoffs += other.firstMoveBetaCutoffs;
+        nullMoveAttempts += other.nullMoveAttempts;
+        nullMoveCutoffs += other.nullMoveCutoffs;
+        lateMoveReductions += other.lateMoveReductions;
+        lateMoveReductionReSearches += other.lateMoveReductionReSearches;
+        principalVariationReSearches += other.principalVariationReSearches;
+        mainNodes += other.mainNodes;
+        quiescenceNodes += other.quiescenceNodes;
+
+        nodesPerDepth.resize(std::max(nodesPerDepth.size(), other.nodesPerDepth.size()));
+
+        for (size_t depth = 0; depth < other.nodesPerDepth.size(); ++depth)
+        {
+            nodesPerDepth[depth] += other.nodesPerDepth[depth];
+        }
+
+        return *this;
+    }
+
+    void SearchStatistics::printAsInfoStrings(std::ostream &outputStream) const
+    {
+        const std::ios::fmtflags flags(outputStream.flags());
+        outputStream << std::fixed << std::setprecision(2);
+
+        outputStream << "info string tt probes " << transpositionTableProbes
+                     << " hits " << transpositionTableHits
+                     << " cutoffs " << transpositionTableCutoffs << "\n"
+                     << "info string beta cutoffs " << betaCutoffs
+                     << " first move " << firstMoveBetaCutoffs
+                     << " rate " << firstMoveCutoffRate() << "%\n"
+                     << "info string null move attempts " << nullMoveAttempts
+                     << " cutoffs " << nullMoveCutoffs << "\n"
+                     << "info string lmr " << lateMoveReductions
+                     << " re-searches " << lateMoveReductionReSearches
+                     << " pvs re-searches " << principalVariationReSearches << "\n"
+                     << "info string nodes main " << mainNodes
+                     << " quiescence " << quiescenceNodes << "\n"
+                     << "info string ebf";
+
+        for (size_t depth = 2; depth < nodesPerDepth.size(); ++depth)
+        {
+            outputStream << " " << depth << ":" << effectiveBranchingFactor(depth);
+        }
+
+        outputStream << "\n";
+        outputStream.flags(flags);
+    }
+
+    void SearchStatistics::writeJson(std::ostream &outputStream) const
+    {
+        outputStream << "{\n"
+                     << "  \"tt_probes\": " << transpositionTableProbes << ",\n"
+                     << "  \"tt_hits\": " << transpositionTableHits << ",\n"
+                     << "  \"tt_cutoffs\": " << transpositionTableCutoffs << ",\n"
+                     << "  \"beta_cutoffs\": " << betaCutoffs << ",\n"
+                     << "  \"first_move_beta_cutoffs\": " << firstMoveBetaCutoffs << ",\n"
+                     << "  \"first_move_cutoff_rate\": " << firstMoveCutoffRate() << ",\n"
+                     << "  \"null_move_attempts\": " << nullMoveAttempts << ",\n"
+                     << "  \"null_move_cutoffs\": " << nullMoveCutoffs << ",\n"
+                     << "  \"lmr\": " << lateMoveReductions << ",\n"
+                     << "  \"lmr_re_searches\": " << lateMoveReductionReSearches << ",\n"
+                     << "  \"pvs_re_searches\": " << principalVariationReSearches << ",\n"
+                     << "  \"main_nodes\": " << mainNodes << ",\n"
+                     << "  \"quiescence_nodes\": " << quiescenceNodes << ",\n"
+                     << "  \"nodes_per_depth\": [";
+
+        for (size_t depth = 1; depth < nodesPerDepth.size(); ++depth)
+        {
+            outputStream << (depth > 1 ? ", " : "") << nodesPerDepth[depth];
+        }
+
+        outputStream << "],\n  \"effective_branching_factors\": [";
+
+        for (size_t depth = 2; depth < nodesPerDepth.size(); ++depth)
+        {
+            outputStream << (depth > 2 ? ", " : "") << effectiveBranchingFactor(depth);
+        }
+
+        outputStream << "]\n}\n";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "ModernChess/SelfPlay.h"
+#include "ModernChess/BatchAnalysis.h"
+#include "ModernChess/BitBoardOperations.h"
+#include "ModernChess/CheckInfo.h"
+#include "ModernChess/Evaluation.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/MoveExecution.h"
+#include "ModernChess/PseudoMoveGeneration.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+    using namespace ModernChess;
+
+    // Enough for every node limit, which is reasonable for self-play
+    constexpr uint8_t MaxSearchDepth = 64;
+    constexpr int32_t FiftyMoveRuleNumberOfPlies = 100;
+    // Share of the remaining time, which is used for the next move
+    constexpr int64_t ExpectedNumberOfMovesToGo = 30;
+
+    using namespace std::chrono_literals;
+
+    bool isIrreversible(Move move)
+    {
+        return move.isCapture() or
+               move.getMovedFigure() == Figure::WhitePawn or
+               move.getMovedFigure() == Figure::BlackPawn;
+    }
+}
+
+namespace ModernChess
+{
+    std::ostream &operator<<(std::ostream &os, GameTermination termination)
+    {
+        switch (termination)
+        {
+            case GameTermination::Checkmate: return os << "checkmate";
+            case GameTermination::Stalemate: return os << "stalemate";
+            case GameTermination::FiftyMoveRule: return os << "fifty-move rule";
+            case GameTermination::ThreefoldRepetition: return os << "threefold repetition";
+            case GameTermination::InsufficientMaterial: return os << "insufficient material";
+            case GameTermination::MaximumLength: return os << "maximum length";
+            case GameTermination::AdjudicatedWin: return os << "adjudicated win";
+            case GameTermination::AdjudicatedDraw: return os << "adjudicated draw";
+            case GameTermination::TimeForfeit: return os << "time forfeit";
+        }
+
+        return os;
+    }
+
+    SelfPlayGame SelfPlay::playGame(const GameState &startPosition,
+                                    const EngineConfiguration &white,
+                                    const EngineConfiguration &black,
+                                    uint32_t maximumNumberOfPlies,
+                                    const std::optional<Adjudication> &adjudication)
+    {
+        SearchContext whiteSearchContext(white.hashSizeInMB);
+        SearchContext blackSearchContext(black.hashSizeInMB);
+        whiteSearchContext.setSearchParameters(white.searchParameters);
+        blackSearchContext.setSearchParameters(black.searchParameters);
+        whiteSearchContext.setNeuralNetwork(white.neuralNetwork);
+        blackSearchContext.setNeuralNetwork(black.neuralNetwork);
+
+        SelfPlayGame game;
+        GameState gameState = startPosition;
+        int32_t numberOfReversiblePlies = startPosition.halfMoveClock;
+        // hashes of the positions since the last irreversible move, which could be repeated
+        std::vector<uint64_t> positionHashes{gameState.gameStateHash};
+        std::chrono::milliseconds whiteRemainingTime = white.timeControl.baseTime;
+        std::chrono::milliseconds blackRemainingTime = black.timeControl.baseTime;
+        // plies in a row, in which the scores agreed on the adjudication
+        uint32_t whiteIsWinningPlies = 0;
+        uint32_t blackIsWinningPlies = 0;
+        uint32_t balancedPlies = 0;
+
+        const auto finishGame = [&game](GameResult result, GameTermination termination) {
+            game.result = result;
+            game.termination = termination;
+            return game;
+        };
+
+        while (true)
+        {
+            const bool whiteToMove = gameState.board.sideToMove == Color::White;
+            const std::vector<Move> legalMoves = generateLegalMoves(gameState);
+
+            if (legalMoves.empty())
+            {
+                if (CheckInfo(gameState.board).kingIsInCheck())
+                {
+                    return finishGame(whiteToMove ? GameResult::BlackWins : GameResult::WhiteWins, GameTermination::Checkmate);
+                }
+
+                return finishGame(GameResult::Draw, GameTermination::Stalemate);
+            }
+
+            if (numberOfReversiblePlies >= FiftyMoveRuleNumberOfPlies)
+            {
+                return finishGame(GameResult::Draw, GameTermination::FiftyMoveRule);
+            }
+
+            if (std::count(positionHashes.begin(), positionHashes.end(), gameState.gameStateHash) >= 3)
+            {
+                return finishGame(GameResult::Draw, GameTermination::ThreefoldRepetition);
+            }
+
+            if (hasInsufficientMaterial(gameState.board))
+            {
+                return finishGame(GameResult::Draw, GameTermination::InsufficientMaterial);
+            }
+
+            if (game.moves.size() >= maximumNumberOfPlies)
+            {
+                return finishGame(GameResult::Draw, GameTermination::MaximumLength);
+            }
+
+            const EngineConfiguration &engine = whiteToMove ? white : black;
+            SearchContext &searchContext = whiteToMove ? whiteSearchContext : blackSearchContext;
+            std::chrono::milliseconds &remainingTime = whiteToMove ? whiteRemainingTime : blackRemainingTime;
+
+            const auto begin = std::chrono::steady_clock::now();
+            const std::chrono::milliseconds timeLimit = engine.timeControl.isEnabled() ?
+                                                        allocateTime(remainingTime, engine.timeControl.increment) : 0ms;
+            SearchedMove searchedMove = searchMove(searchContext, gameState, engine.nodesPerMove, timeLimit);
+
+            if (engine.timeControl.isEnabled())
+            {
+                remainingTime -= std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+
+                if (remainingTime < 0ms)
+                {
+                    return finishGame(whiteToMove ? GameResult::BlackWins : GameResult::WhiteWins, GameTermination::TimeForfeit);
+                }
+
+                remainingTime += engine.timeControl.increment;
+            }
+
+            if (std::find(legalMoves.begin(), legalMoves.end(), searchedMove.move) == legalMoves.end())
+            {
+                searchedMove = SearchedMove{legalMoves.front(), 0};
+            }
+
+            static_cast<void>(MoveExecution::executeMove(gameState, searchedMove.move, MoveType::AllMoves));
+            game.moves.push_back(searchedMove.move);
+
+            if (isIrreversible(searchedMove.move))
+            {
+                numberOfReversiblePlies = 0;
+                positionHashes.clear();
+            }
+            else
+            {
+                ++numberOfReversiblePlies;
+            }
+
+            positionHashes.push_back(gameState.gameStateHash);
+
+            if (not adjudication)
+            {
+                continue;
+            }
+
+            const int32_t whiteScore = whiteToMove ? searchedMove.score : -searchedMove.score;
+            whiteIsWinningPlies = (whiteScore >= adjudication->winScore) ? whiteIsWinningPlies + 1 : 0;
+            blackIsWinningPlies = (whiteScore <= -adjudication->winScore) ? blackIsWinningPlies + 1 : 0;
+            balancedPlies = (std::abs(whiteScore) <= adjudication->drawScore) ? balancedPlies + 1 : 0;
+
+            if (whiteIsWinningPlies >= adjudication->winNumberOfPlies)
+            {
+                return finishGame(GameResult::WhiteWins, GameTermination::AdjudicatedWin);
+            }
+
+            if (blackIsWinningPlies >= adjudication->winNumberOfPlies)
+            {
+                return finishGame(GameResult::BlackWins, GameTermination::AdjudicatedWin);
+            }
+
+            if (balancedPlies >= adjudication->drawNumberOfPlies and
+                game.moves.size() >= adjudication->drawMinimumNumberOfPlies)
+            {
+                return finishGame(GameResult::Draw, GameTermination::AdjudicatedDraw);
+            }
+        }
+    }
+
+    SearchedMove SelfPlay::searchMove(SearchContext &searchContext,
+                                      const GameState &gameState,
+                                      uint64_t numberOfNodes,
+                                      std::chrono::milliseconds timeLimit)
+    {
+        // The search uses the half move clock as ply, which must not overflow in long games
+        GameState rootGameState = gameState;
+        rootGameState.halfMoveClock = 0;
+
+        const auto begin = std::chrono::steady_clock::now();
+        const bool hasTimeLimit = timeLimit > 0ms;
+        const auto timeIsUp = [hasTimeLimit, deadline = begin + timeLimit] {
+            return hasTimeLimit and std::chrono::steady_clock::now() >= deadline;
+        };
+
+        Evaluation evaluation(searchContext, rootGameState, timeIsUp);
+        evaluation.setNodeLimit(numberOfNodes);
+
+        const IterativeDeepeningResult result = evaluation.searchIteratively(MaxSearchDepth, {
+            .stopBeforeNextIteration = [hasTimeLimit, begin, timeLimit] {
+                // The next iteration takes longer than all previous ones together
+                return hasTimeLimit and std::chrono::steady_clock::now() - begin >= timeLimit / 2;
+            }
+        });
+
+        return result.pv.empty() ? SearchedMove{} : SearchedMove{result.bestMove(), result.score};
+    }
+
+    std::chrono::milliseconds SelfPlay::allocateTime(std::chrono::milliseconds remainingTime,
+                                                     std::chrono::milliseconds increment)
+    {
+        // Never more than half of the remaining time, so the clock cannot run out
+        return std::max(std::min(remainingTime / ExpectedNumberOfMovesToGo + increment * 3 / 4, remainingTime / 2), 1ms);
+    }
+
+    std::vector<GameState> SelfPlay::readOpenings(std::istream &inputStream)
+    {
+        std::vector<GameState> openings;
+        size_t lineNumber = 0;
+
+        for (std::string line; std::getline(inputStream, line);)
+        {
+            ++lineNumber;
+
+            if (line.find_first_not_of(" \t\r") == std::string::npos)
+            {
+                continue;
+            }
+
+            const BatchAnalysisPosition position = BatchAnalysisPosition::fromLine(line, openings.size(), lineNumber);
+            openings.push_back(FenParsing::FenParser(position.fen).parse());
+        }
+
+        return openings;
+    }
+
+    std::vector<Move> SelfPlay::generateLegalMoves(const GameState &gameState)
+    {
+        std::vector<Move> legalMoves;
+
+        for (const Move move : PseudoMoveGeneration::generateMoves(gameState))
+        {
+            GameState nextGameState = gameState;
+
+            if (MoveExecution::executeMove(nextGameState, move, MoveType::AllMoves))
+            {
+                legalMoves.push_back(move);
+            }
+        }
+
+        return legalMoves;
+    }
+
+    bool SelfPlay::hasInsufficientMaterial(const Board &board)
+    {
+        for (const Figure figure : {Figure::WhitePawn, Figure::WhiteRook, Figure::WhiteQueen,
+                                    Figure::BlackPawn, Figure::BlackRook, Figure::BlackQueen})
+        {
+            if (board.bitboards[figure] != BoardState::empty)
+            {
+                return false;
+            }
+        }
+
+        // A single knight or bishop cannot checkmate
+        const BitBoardState minorFigures = board.bitboards[Figure::WhiteKnight] | board.bitboards[Figure::WhiteBishop] |
+                                           board.bitboards[Figure::BlackKnight] | board.bitboards[Figure::BlackBishop];
+
+        return BitBoardOperations::countBits(minorFigures) <= 1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "ModernChess/SpsaTuner.h"
+#include "ModernChess/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+    using namespace ModernChess;
+
+    // Exponents of the decay of the step size and of the perturbation, which are recommended by Spall
+    constexpr double StepSizeDecay = 0.602;
+    constexpr double PerturbationDecay = 0.101;
+    // The step size decays slower in the first iterations, if this fraction of the iterations is added
+    constexpr double StabilityFraction = 0.1;
+
+    double points(GameResult result, bool firstPlaysWhite)
+    {
+        if (result == GameResult::Draw)
+        {
+            return 0.5;
+        }
+
+        return ((result == GameResult::WhiteWins) == firstPlaysWhite) ? 1.0 : 0.0;
+    }
+}
+
+namespace ModernChess
+{
+    SpsaTuner::SpsaTuner(Settings settings, std::vector<GameState> openings) :
+            m_settings(settings),
+            m_openings(std::move(openings)),
+            m_threadPool(std::make_unique<ThreadPool>(settings.numberOfThreads))
+    {
+        if (m_openings.empty())
+        {
+            throw std::invalid_argument("SPSA needs at least one opening");
+        }
+    }
+
+    SpsaTuner::~SpsaTuner() = default;
+
+    SearchParameters SpsaTuner::tune(const SearchParameters &initialParameters, std::ostream &logStream)
+    {
+        std::mt19937_64 randomGenerator(m_settings.seed);
+        std::bernoulli_distribution coinFlip(0.5);
+
+        Values values = toValues(initialParameters);
+        const double stability = StabilityFraction * m_settings.numberOfIterations;
+
+        for (uint32_t iteration = 0; iteration < m_settings.numberOfIterations; ++iteration)
+        {
+            const double perturbationScale = 1.0 / std::pow(iteration + 1.0, PerturbationDecay);
+            const double stepSizeScale = std::pow((1.0 + stability) / (iteration + 1.0 + stability), StepSizeDecay);
+
+            Values directions{};
+            Values increasedValues = values;
+            Values decreasedValues = values;
+
+            for (size_t index = 0; index < values.size(); ++index)
+            {
+                directions[index] = coinFlip(randomGenerator) ? 1.0 : -1.0;
+                const double perturbation = TunableSearchParameters[index].perturbation * perturbationScale * directions[index];
+                increasedValues[index] += perturbation;
+                decreasedValues[index] -= perturbation;
+            }
+
+            const double result = playGamePairs(toSearchParameters(increasedValues), toSearchParameters(decreasedValues));
+
+            for (size_t index = 0; index < values.size(); ++index)
+            {
+                const TunableSearchParameter &parameter = TunableSearchParameters[index];
+                values[index] += m_settings.learningRate * stepSizeScale * parameter.perturbation * directions[index] * result;
+                values[index] = std::clamp(values[index], double(parameter.minimum), double(parameter.maximum));
+            }
+
+            if ((iteration + 1) % 10 == 0 or iteration + 1 == m_settings.numberOfIterations)
+            {
+                logStream << "iteration " << iteration + 1;
+
+                for (size_t index = 0; index < values.size(); ++index)
+                {
+                    logStream << " " << TunableSearchParameters[index].name << "=" << values[index];
+                }
+
+                logStream << std::endl;
+            }
+        }
+
+        return toSearchParameters(values);
+    }
+
+    SearchParameters SpsaTuner::toSearchParameters(const Values &values)
+    {
+        SearchParameters searchParameters;
+
+        for (size_t index = 0; index < values.size(); ++index)
+        {
+            const TunableSearchParameter &parameter = TunableSearchParameters[index];
+            searchParameters.*parameter.value = std::clamp(int32_t(std::lround(values[index])), parameter.minimum, parameter.maximum);
+        }
+
+        return searchParameters;
+    }
+
+    SpsaTuner::Values SpsaTuner::toValues(const SearchParameters &searchParameters)
+    {
+        Values values{};
+
+        for (size_t index = 0; index < values.size(); ++index)
+        {
+            values[index] = searchParameters.*TunableSearchParameters[index].value;
+        }
+
+        return values;
+    }
+
+    double SpsaTuner::playGamePairs(const SearchParameters &first, const SearchParameters &second)
+    {
+        EngineConfiguration firstEngine{.searchParameters = first, .nodesPerMove = m_settings.nodesPerMove};
+        EngineConfiguration secondEngine{.searchParameters = second, .nodesPerMove = m_settings.nodesPerMove};
+
+        const size_t numberOfGames = 2 * size_t(m_settings.numberOfGamePairsPerIteration);
+        std::vector<double> pointsOfFirst(numberOfGames);
+        const size_t firstOpening = m_nextOpening;
+        m_nextOpening = (m_nextOpening + m_settings.numberOfGamePairsPerIteration) % m_openings.size();
+
+        m_threadPool->parallelFor(0, numberOfGames, [&](size_t gameIndex) {
+            const GameState &opening = m_openings[(firstOpening + gameIndex / 2) % m_openings.size()];
+            const bool firstPlaysWhite = gameIndex % 2 == 0;
+
+            const SelfPlayGame game = firstPlaysWhite ?
+                    SelfPlay::playGame(opening, firstEngine, secondEngine, m_settings.maximumNumberOfPlies) :
+                    SelfPlay::playGame(opening, secondEngine, firstEngine, m_settings.maximumNumberOfPlies);
+
+            pointsOfFirst[gameIndex] = points(game.result, firstPlaysWhite);
+        });
+
+        double sum = 0;
+
+        for (const double gamePoints : pointsOfFirst)
+        {
+            sum += gamePoints;
+        }
+
+        // The points of both sides of a game sum up to 1
+        return (2 * sum - double(numberOfGames)) / double(numberOfGames);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,651 @@
+#include "ModernChess/TexelTuner.h"
+#include "ModernChess/EvaluationParameters.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/MoveExecution.h"
+#include "ModernChess/PseudoMoveGeneration.h"
+#include "ModernChess/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    using namespace ModernChess;
+
+    using Gradient = std::array<double, TexelParameters::NumberOfParameters>;
+
+    // The captures of a position are resolved at most up to this number of plies
+    constexpr uint32_t MaxQuiescencePly = 16;
+    constexpr size_t NumberOfLinesPerBatch = 1 << 16;
+    constexpr uint8_t NumberOfFiguresPerColor = NumberOfFigureTypes / 2;
+
+    constexpr std::array<std::string_view, NumberOfFiguresPerColor> FigureNames{
+        "pawn", "knight", "bishop", "rook", "queen", "king"
+    };
+    constexpr std::array<std::string_view, TexelParameters::NumberOfPositionalTables> PositionalTableNames{
+        "pawn", "knight", "bishop", "rook", "king"
+    };
+
+    bool isWhiteFigure(Figure figure)
+    {
+        return figure < NumberOfFiguresPerColor;
+    }
+
+    Square mirror(Square square)
+    {
+        return Square(square ^ 56);
+    }
+
+    /**
+     * @brief Calls visitor(parameter index, +1 or -1) for every parameter, which contributes to the evaluation
+     *        of the figure from the view of white
+     */
+    template<typename Visitor>
+    void forEachParameter(Figure figure, Square square, Visitor &&visitor)
+    {
+        const bool isWhite = isWhiteFigure(figure);
+        const double sign = isWhite ? 1.0 : -1.0;
+
+        if (const size_t index = TexelParameters::materialIndex(figure);
+            index != TexelParameters::NoParameter)
+        {
+            visitor(index, sign);
+        }
+
+        if (const size_t index = TexelParameters::positionalIndex(figure, isWhite ? square : mirror(square));
+            index != TexelParameters::NoParameter)
+        {
+            visitor(index, sign);
+        }
+    }
+
+    void addTo(double &sum, double value)
+    {
+        sum += value;
+    }
+
+    void addTo(Gradient &sum, const Gradient &value)
+    {
+        std::transform(sum.begin(), sum.end(), value.begin(), sum.begin(), std::plus<>());
+    }
+
+    double sigmoid(double evaluation, double scalingConstant)
+    {
+        return 1.0 / (1.0 + std::pow(10.0, -scalingConstant * evaluation / 400.0));
+    }
+
+    /**
+     * @brief Searches the captures with alpha-beta
+     * @param leaf the quiet position at the end of the principal variation
+     * @return score from the view of the side to move
+     */
+    double resolveQuiescence(const GameState &gameState, const TexelParameters &parameters,
+                             double alpha, double beta, uint32_t ply, GameState &leaf)
+    {
+        const double sign = (gameState.board.sideToMove == Color::White) ? 1.0 : -1.0;
+        const double standPat = sign * parameters.evaluate(gameState.board);
+        leaf = gameState;
+
+        if (standPat >= beta or ply >= MaxQuiescencePly)
+        {
+            return standPat;
+        }
+
+        alpha = std::max(alpha, standPat);
+
+        for (const Move move : PseudoMoveGeneration::generateMoves(gameState))
+        {
+            GameState nextGameState = gameState;
+
+            if (not move.isCapture() or not MoveExecution::executeMove(nextGameState, move, MoveType::CapturesOnly))
+            {
+                continue;
+            }
+
+            GameState nextLeaf;
+            const double score = -resolveQuiescence(nextGameState, parameters, -beta, -alpha, ply + 1, nextLeaf);
+
+            if (score > alpha)
+            {
+                alpha = score;
+                leaf = nextLeaf;
+
+                if (score >= beta)
+                {
+                    break;
+                }
+            }
+        }
+
+        return alpha;
+    }
+
+    /**
+     * @return the FEN of a line like "<FEN> [0.5]" and the rest of the line. The move counters are optional as in EPD.
+     */
+    std::optional<std::pair<std::string, std::string_view>> splitFen(std::string_view line)
+    {
+        std::array<std::string_view, 6> fields;
+        size_t numberOfFields = 0;
+        size_t position = 0;
+
+        while (numberOfFields < fields.size())
+        {
+            const size_t begin = line.find_first_not_of(" \t", position);
+
+            if (begin == std::string_view::npos)
+            {
+                break;
+            }
+
+            position = std::min(line.find_first_of(" \t", begin), line.size());
+            fields[numberOfFields++] = line.substr(begin, position - begin);
+        }
+
+        if (numberOfFields < 4)
+        {
+            return std::nullopt;
+        }
+
+        const auto isNumber = [](std::string_view field) {
+            return std::all_of(field.begin(), field.end(), [](char c) { return c >= '0' and c <= '9'; });
+        };
+
+        std::string fen = std::string(fields[0]) + " " + std::string(fields[1]) + " " + std::string(fields[2]) + " " + std::string(fields[3]);
+
+        if (numberOfFields == 6 and isNumber(fields[4]) and isNumber(fields[5]))
+        {
+            return std::pair{fen + " " + std::string(fields[4]) + " " + std::string(fields[5]), line.substr(position)};
+        }
+
+        const size_t endOfFen = fields[3].data() + fields[3].size() - line.data();
+
+        return std::pair{fen + " 0 1", line.substr(endOfFen)};
+    }
+}
+
+namespace ModernChess
+{
+    TexelParameters TexelParameters::fromEvaluation()
+    {
+        TexelParameters parameters;
+
+        for (Figure figure = Figure::WhitePawn; figure < Figure::WhiteKing; ++figure)
+        {
+            parameters[materialIndex(figure)] = EvaluationParameters::materialScore[figure];
+        }
+
+        constexpr std::array<Figure, NumberOfPositionalTables> FiguresWithPositionalScore{
+            Figure::WhitePawn, Figure::WhiteKnight, Figure::WhiteBishop, Figure::WhiteRook, Figure::WhiteKing
+        };
+        const std::array<const std::array<int32_t, NumberOfSquares> *, NumberOfPositionalTables> positionalScores{
+            &EvaluationParameters::pawnScore, &EvaluationParameters::knightScore, &EvaluationParameters::bishopScore,
+            &EvaluationParameters::rookScore, &EvaluationParameters::kingScore
+        };
+
+        for (size_t table = 0; table < NumberOfPositionalTables; ++table)
+        {
+            for (int32_t square = Square::a1; square <= Square::h8; ++square)
+            {
+                parameters[positionalIndex(FiguresWithPositionalScore[table], Square(square))] = (*positionalScores[table])[square];
+            }
+        }
+
+        return parameters;
+    }
+
+    size_t TexelParameters::materialIndex(Figure figure)
+    {
+        const auto figureType = uint8_t(figure % NumberOfFiguresPerColor);
+
+        return (figureType < NumberOfMaterialScores) ? figureType : NoParameter;
+    }
+
+    size_t TexelParameters::positionalIndex(Figure figure, Square square)
+    {
+        size_t table = 0;
+
+        switch (Figure(figure % NumberOfFiguresPerColor))
+        {
+            case Figure::WhitePawn: table = 0; break;
+            case Figure::WhiteKnight: table = 1; break;
+            case Figure::WhiteBishop: table = 2; break;
+            case Figure::WhiteRook: table = 3; break;
+            case Figure::WhiteKing: table = 4; break;
+            default:
+                return NoParameter;
+        }
+
+        return NumberOfMaterialScores + table * NumberOfSquares + size_t(square);
+    }
+
+    double TexelParameters::evaluate(const Board &board) const
+    {
+        double score = 0;
+
+        for (Figure figure = Figure::WhitePawn; figure <= Figure::BlackKing; ++figure)
+        {
+            for (BitBoardState bitboard = board.bitboards[figure]; bitboard != BoardState::empty; )
+            {
+                const Square square = BitBoardOperations::bitScanForward(bitboard);
+                forEachParameter(figure, square, [&](size_t index, double sign) { score += sign * m_values[index]; });
+                bitboard = BitBoardOperations::eraseSquare(bitboard, square);
+            }
+        }
+
+        return score;
+    }
+
+    void TexelParameters::writeHeader(std::ostream &outputStream) const
+    {
+        constexpr int32_t KingScore = EvaluationParameters::materialScore[Figure::WhiteKing];
+
+        std::array<int32_t, NumberOfFiguresPerColor> materialScores{};
+
+        for (Figure figure = Figure::WhitePawn; figure < Figure::WhiteKing; ++figure)
+        {
+            materialScores[figure] = int32_t(std::lround(m_values[materialIndex(figure)]));
+        }
+        materialScores[Figure::WhiteKing] = KingScore;
+
+        outputStream << "#pragma once\n\n"
+                     << "#include \"GlobalConstants.h\"\n\n"
+                     << "#include <array>\n"
+                     << "#include <cinttypes>\n\n"
+                     << "/*\n"
+                     << " * Parameters of the handcrafted evaluation, see Evaluation::evaluatePosition().\n"
+                     << " * The positional scores are seen from white and indexed by square, i.e. a1 comes first.\n"
+                     << " * This file is generated by texel-tuning, see TexelTuner.\n"
+                     << " */\n"
+                     << "namespace ModernChess::EvaluationParameters\n{\n"
+                     << "    // The material of the kings is not tuned, because both sides always have one\n"
+                     << "    constexpr std::array<int32_t, NumberOfFigureTypes> materialScore {\n";
+
+        for (const auto &[color, sign] : {std::pair{"white", 1}, std::pair{"black", -1}})
+        {
+            for (size_t figureType = 0; figureType < NumberOfFiguresPerColor; ++figureType)
+            {
+                outputStream << "        " << sign * materialScores[figureType] << ", // " << color << " " << FigureNames[figureType] << "\n";
+            }
+        }
+
+        outputStream << "    };\n";
+
+        for (size_t table = 0; table < NumberOfPositionalTables; ++table)
+        {
+            outputStream << "\n    // " << PositionalTableNames[table] << " positional score\n"
+                         << "    constexpr std::array<int32_t, NumberOfSquares> " << PositionalTableNames[table] << "Score {\n";
+
+            for (size_t rank = 0; rank < 8; ++rank)
+            {
+                outputStream << "       ";
+
+                for (size_t file = 0; file < 8; ++file)
+                {
+                    const size_t index = NumberOfMaterialScores + table * NumberOfSquares + rank * 8 + file;
+                    outputStream << std::setw(4) << std::lround(m_values[index]) << ",";
+                }
+
+                outputStream << "\n";
+            }
+
+            outputStream << "    };\n";
+        }
+
+        // The more valuable the victim, the higher the score. The same victim is captured by the cheapest attacker first.
+        std::array<size_t, NumberOfFiguresPerColor> figureTypesByValue{};
+        std::iota(figureTypesByValue.begin(), figureTypesByValue.end(), 0);
+        std::stable_sort(figureTypesByValue.begin(), figureTypesByValue.end(), [&](size_t first, size_t second) {
+            return materialScores[first] < materialScores[second];
+        });
+
+        std::array<int32_t, NumberOfFiguresPerColor> rankByValue{};
+
+        for (size_t rank = 0; rank < figureTypesByValue.size(); ++rank)
+        {
+            rankByValue[figureTypesByValue[rank]] = int32_t(rank);
+        }
+
+        outputStream << "\n    /*\n"
+                     << "     * Most valuable victim & least valuable attacker [attacker][victim], see https://www.chessprogramming.org/MVV-LVA\n"
+                     << "     * The victims are ranked by their material score and the attackers in reverse order.\n"
+                     << "     */\n"
+                     << "    constexpr std::array<std::array<int32_t, NumberOfFigureTypes>, NumberOfFigureTypes> mvvLva {{\n";
+
+        for (uint8_t attacker = 0; attacker < NumberOfFigureTypes; ++attacker)
+        {
+            outputStream << "        {";
+
+            for (uint8_t victim = 0; victim < NumberOfFigureTypes; ++victim)
+            {
+                const int32_t score = 100 * (rankByValue[victim % NumberOfFiguresPerColor] + 1) +
+                                      int32_t(NumberOfFiguresPerColor) - 1 - rankByValue[attacker % NumberOfFiguresPerColor];
+                outputStream << score << ((victim + 1 == NumberOfFiguresPerColor) ? ",  " : (victim + 1 < NumberOfFigureTypes) ? ", " : "");
+            }
+
+            outputStream << "}" << ((attacker + 1 < NumberOfFigureTypes) ? "," : "") << "\n";
+        }
+
+        outputStream << "    }};\n}";
+    }
+
+    std::optional<PackedPosition> PackedPosition::pack(const Board &board, uint8_t result)
+    {
+        PackedPosition position;
+        position.occupancy = board.occupancies[Color::Both];
+        position.result = result;
+
+        if (BitBoardOperations::countBits(position.occupancy) > MaxNumberOfFigures)
+        {
+            return std::nullopt;
+        }
+
+        size_t figureIndex = 0;
+
+        for (BitBoardState bitboard = position.occupancy; bitboard != BoardState::empty; ++figureIndex)
+        {
+            const Square square = BitBoardOperations::bitScanForward(bitboard);
+            bitboard = BitBoardOperations::eraseSquare(bitboard, square);
+
+            for (Figure figure = Figure::WhitePawn; figure <= Figure::BlackKing; ++figure)
+            {
+                if (BitBoardOperations::isOccupied(board.bitboards[figure], square))
+                {
+                    position.figures[figureIndex / 2] |= uint8_t(figure << (4 * (figureIndex % 2)));
+                    break;
+                }
+            }
+        }
+
+        return position;
+    }
+
+    Board PackedPosition::unpack() const
+    {
+        Board board;
+
+        forEachFigure([&board](Figure figure, Square square) {
+            const Color color = isWhiteFigure(figure) ? Color::White : Color::Black;
+            board.bitboards[figure] = BitBoardOperations::occupySquare(board.bitboards[figure], square);
+            board.occupancies[color] = BitBoardOperations::occupySquare(board.occupancies[color], square);
+            board.occupancies[Color::Both] = BitBoardOperations::occupySquare(board.occupancies[Color::Both], square);
+        });
+
+        return board;
+    }
+
+    TexelTuner::TexelTuner(Settings settings) :
+            m_settings(settings),
+            m_threadPool(std::make_unique<ThreadPool>(settings.numberOfThreads))
+    {}
+
+    TexelTuner::~TexelTuner() = default;
+
+    size_t TexelTuner::loadPositions(std::istream &inputStream)
+    {
+        const size_t numberOfPositionsBefore = m_positions.size();
+        const TexelParameters parameters = TexelParameters::fromEvaluation();
+
+        std::vector<std::string> lines;
+        lines.reserve(NumberOfLinesPerBatch);
+
+        const auto addBatch = [&] {
+            std::vector<std::optional<PackedPosition>> positions(lines.size());
+
+            // Parsing and resolving the captures is expensive, so it runs on all cores
+            m_threadPool->parallelFor(0, lines.size(), [&](size_t index) {
+                const std::optional<std::pair<std::string, uint8_t>> parsedLine = parseLine(lines[index]);
+
+                if (not parsedLine)
+                {
+                    return;
+                }
+
+                try
+                {
+                    GameState gameState = FenParsing::FenParser(parsedLine->first).parse();
+
+                    if (m_settings.resolveQuiescence)
+                    {
+                        GameState leaf;
+                        static_cast<void>(resolveQuiescence(gameState, parameters, -std::numeric_limits<double>::infinity(),
+                                                            std::numeric_limits<double>::infinity(), 0, leaf));
+                        gameState = leaf;
+                    }
+
+                    positions[index] = PackedPosition::pack(gameState.board, parsedLine->second);
+                }
+                catch (const std::exception &)
+                {
+                    // invalid FEN: the line is skipped
+                }
+            }, 64);
+
+            for (const std::optional<PackedPosition> &position : positions)
+            {
+                if (position)
+                {
+                    m_positions.push_back(*position);
+                }
+                else
+                {
+                    ++m_numberOfSkippedLines;
+                }
+            }
+
+            lines.clear();
+        };
+
+        for (std::string line; std::getline(inputStream, line);)
+        {
+            if (line.empty() or line.starts_with('#'))
+            {
+                continue;
+            }
+
+            lines.push_back(std::move(line));
+
+            if (lines.size() == NumberOfLinesPerBatch)
+            {
+                addBatch();
+            }
+        }
+
+        addBatch();
+        m_positions.shrink_to_fit();
+
+        return m_positions.size() - numberOfPositionsBefore;
+    }
+
+    size_t TexelTuner::numberOfPositions() const
+    {
+        return m_positions.size();
+    }
+
+    size_t TexelTuner::numberOfSkippedLines() const
+    {
+        return m_numberOfSkippedLines;
+    }
+
+    double TexelTuner::findScalingConstant(const TexelParameters &parameters) const
+    {
+        // The error is convex in K, so a ternary search finds the minimum
+        double lowerBound = 0.0;
+        double upperBound = 4.0;
+
+        for (uint32_t iteration = 0; iteration < 50; ++iteration)
+        {
+            const double first = lowerBound + (upperBound - lowerBound) / 3;
+            const double second = upperBound - (upperBound - lowerBound) / 3;
+
+            if (meanSquaredError(parameters, first) < meanSquaredError(parameters, second))
+            {
+                upperBound = second;
+            }
+            else
+            {
+                lowerBound = first;
+            }
+        }
+
+        return (lowerBound + upperBound) / 2;
+    }
+
+    double TexelTuner::meanSquaredError(const TexelParameters &parameters, double scalingConstant) const
+    {
+        if (m_positions.empty())
+        {
+            return 0;
+        }
+
+        const auto sumOfSquaredErrors = sumOverPositions<double>([&](const PackedPosition &position, double &sum) {
+            const double error = position.score() - sigmoid(parameters.evaluate(position.unpack()), scalingConstant);
+            sum += error * error;
+        });
+
+        return sumOfSquaredErrors / double(m_positions.size());
+    }
+
+    TexelParameters TexelTuner::tune(const TexelParameters &initialParameters, std::ostream &logStream) const
+    {
+        constexpr double FirstMomentDecay = 0.9;
+        constexpr double SecondMomentDecay = 0.999;
+        constexpr double Epsilon = 1e-8;
+
+        TexelParameters parameters = initialParameters;
+
+        if (m_positions.empty())
+        {
+            return parameters;
+        }
+
+        const double scalingConstant = findScalingConstant(initialParameters);
+        const double sigmoidScale = scalingConstant * std::log(10.0) / 400.0;
+
+        logStream << "K = " << scalingConstant << ", initial error = " << meanSquaredError(parameters, scalingConstant) << std::endl;
+
+        Gradient firstMoments{};
+        Gradient secondMoments{};
+
+        for (uint32_t epoch = 1; epoch <= m_settings.numberOfEpochs; ++epoch)
+        {
+            const auto gradient = sumOverPositions<Gradient>([&](const PackedPosition &position, Gradient &sum) {
+                // The error is linear in the parameters, so every figure contributes its sign
+                double evaluation = 0;
+                position.forEachFigure([&](Figure figure, Square square) {
+                    forEachParameter(figure, square, [&](size_t index, double sign) { evaluation += sign * parameters[index]; });
+                });
+
+                const double expectedResult = sigmoid(evaluation, scalingConstant);
+                const double derivative = -2.0 * (position.score() - expectedResult) * expectedResult * (1.0 - expectedResult) * sigmoidScale;
+
+                position.forEachFigure([&](Figure figure, Square square) {
+                    forEachParameter(figure, square, [&](size_t index, double sign) { sum[index] += sign * derivative; });
+                });
+            });
+
+            // Adam, see https://arxiv.org/abs/1412.6980
+            const double firstMomentCorrection = 1.0 - std::pow(FirstMomentDecay, epoch);
+            const double secondMomentCorrection = 1.0 - std::pow(SecondMomentDecay, epoch);
+
+            for (size_t index = 0; index < TexelParameters::NumberOfParameters; ++index)
+            {
+                const double meanGradient = gradient[index] / double(m_positions.size());
+                firstMoments[index] = FirstMomentDecay * firstMoments[index] + (1.0 - FirstMomentDecay) * meanGradient;
+                secondMoments[index] = SecondMomentDecay * secondMoments[index] + (1.0 - SecondMomentDecay) * meanGradient * meanGradient;
+
+                parameters[index] -= m_settings.learningRate * (firstMoments[index] / firstMomentCorrection) /
+                                     (std::sqrt(secondMoments[index] / secondMomentCorrection) + Epsilon);
+            }
+
+            if (epoch % 10 == 0 or epoch == m_settings.numberOfEpochs)
+            {
+                logStream << "epoch " << epoch << ", error = " << meanSquaredError(parameters, scalingConstant) << std::endl;
+            }
+        }
+
+        return parameters;
+    }
+
+    std::optional<std::pair<std::string, uint8_t>> TexelTuner::parseLine(std::string_view line)
+    {
+        const auto fenAndRest = splitFen(line);
+
+        if (not fenAndRest)
+        {
+            return std::nullopt;
+        }
+
+        // Only the rest is searched, because the move counters of the FEN could look like a result
+        const std::string_view rest = fenAndRest->second;
+        std::optional<uint8_t> result;
+
+        if (rest.find("1/2-1/2") != std::string_view::npos)
+        {
+            result = 1;
+        }
+        else if (rest.find("1-0") != std::string_view::npos)
+        {
+            result = 2;
+        }
+        else if (rest.find("0-1") != std::string_view::npos)
+        {
+            result = 0;
+        }
+        else if (const size_t begin = rest.rfind('['); begin != std::string_view::npos)
+        {
+            const std::string_view value = rest.substr(begin + 1, rest.find(']', begin) - begin - 1);
+
+            if (value == "1" or value == "1.0")
+            {
+                result = 2;
+            }
+            else if (value == "0.5")
+            {
+                result = 1;
+            }
+            else if (value == "0" or value == "0.0")
+            {
+                result = 0;
+            }
+        }
+
+        if (not result)
+        {
+            return std::nullopt;
+        }
+
+        return std::pair{fenAndRest->first, *result};
+    }
+
+    template<typename Result, typename Function>
+    Result TexelTuner::sumOverPositions(Function &&function) const
+    {
+        // More chunks than threads, so the threads are busy until the end
+        const size_t numberOfChunks = std::min(m_positions.size(), 8 * size_t(m_threadPool->numberOfThreads()));
+        std::vector<Result> partialSums(numberOfChunks, Result{});
+
+        m_threadPool->parallelFor(0, numberOfChunks, [&](size_t chunk) {
+            const size_t begin = chunk * m_positions.size() / numberOfChunks;
+            const size_t end = (chunk + 1) * m_positions.size() / numberOfChunks;
+
+            for (size_t index = begin; index < end; ++index)
+            {
+                function(m_positions[index], partialSums[chunk]);
+            }
+        });
+
+        Result sum{};
+
+        for (const Result &partialSum : partialSums)
+        {
+            addTo(sum, partialSum);
+        }
+
+        return sum;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,224 @@
+#include "ModernChess/ThreadPool.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+    // Identifies the worker, which executes the current thread
+    thread_local const ModernChess::ThreadPool *currentThreadPool = nullptr;
+    thread_local uint32_t currentWorkerIndexOfThread = ModernChess::ThreadPool::NoWorker;
+
+    void pinThreadToCpu([[maybe_unused]] std::thread &thread, [[maybe_unused]] uint32_t cpuIndex)
+    {
+#ifdef __linux__
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpuIndex % std::max(std::thread::hardware_concurrency(), 1u), &cpuSet);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet);
+#endif
+    }
+}
+
+namespace ModernChess
+{
+    ThreadPool::ThreadPool(uint32_t numberOfThreads, bool pinThreads)
+    {
+        numberOfThreads = std::max(numberOfThreads, 1u);
+
+        for (uint32_t workerIndex = 0; workerIndex < numberOfThreads; ++workerIndex)
+        {
+            m_queues.push_back(std::make_unique<WorkQueue>());
+        }
+
+        for (uint32_t workerIndex = 0; workerIndex < numberOfThreads; ++workerIndex)
+        {
+            m_threads.emplace_back(&ThreadPool::runWorker, this, workerIndex);
+
+            if (pinThreads)
+            {
+                pinThreadToCpu(m_threads.back(), workerIndex);
+            }
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            const std::scoped_lock lock{m_sleepMutex};
+            m_stopped = true;
+        }
+
+        m_taskHasBeenSubmitted.notify_all();
+
+        for (std::thread &thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        uint32_t queueIndex = currentWorkerIndex();
+
+        if (queueIndex == NoWorker)
+        {
+            queueIndex = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % uint32_t(m_queues.size());
+        }
+
+        {
+            WorkQueue &queue = *m_queues[queueIndex];
+            const std::scoped_lock lock{queue.mutex};
+            queue.tasks.push_back(std::move(task));
+        }
+
+        ++m_numberOfQueuedTasks;
+
+        // Taking the lock prevents a lost wake-up of a worker, which has just checked the number of tasks
+        {
+            const std::scoped_lock lock{m_sleepMutex};
+        }
+        m_taskHasBeenSubmitted.notify_one();
+    }
+
+    uint32_t ThreadPool::numberOfThreads() const
+    {
+        return uint32_t(m_threads.size());
+    }
+
+    uint32_t ThreadPool::currentWorkerIndex() const
+    {
+        return (currentThreadPool == this) ? currentWorkerIndexOfThread : NoWorker;
+    }
+
+    void ThreadPool::runWorker(uint32_t workerIndex)
+    {
+        currentThreadPool = this;
+        currentWorkerIndexOfThread = workerIndex;
+
+        while (true)
+        {
+            if (runPendingTask(workerIndex))
+            {
+                continue;
+            }
+
+            std::unique_lock lock{m_sleepMutex};
+            m_taskHasBeenSubmitted.wait(lock, [this] {
+                return m_numberOfQueuedTasks > 0 or m_stopped;
+            });
+
+            // Tasks may submit further tasks, so the pool is stopped only after all tasks have been executed
+            if (m_stopped and m_numberOfQueuedTasks == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    bool ThreadPool::runPendingTask(uint32_t workerIndex)
+    {
+        std::function<void()> task;
+
+        {
+            WorkQueue &ownQueue = *m_queues[workerIndex];
+            const std::scoped_lock lock{ownQueue.mutex};
+
+            if (not ownQueue.tasks.empty())
+            {
+                task = std::move(ownQueue.tasks.back());
+                ownQueue.tasks.pop_back();
+            }
+        }
+
+        for (size_t offset = 1; not task and offset < m_queues.size(); ++offset)
+        {
+            WorkQueue &otherQueue = *m_queues[(workerIndex + offset) % m_queues.size()];
+            const std::scoped_lock lock{otherQueue.mutex};
+
+            if (not otherQueue.tasks.empty())
+            {
+                task = std::move(otherQueue.tasks.front());
+                otherQueue.tasks.pop_front();
+            }
+        }
+
+        if (not task)
+        {
+            return false;
+        }
+
+        --m_numberOfQueuedTasks;
+        task();
+
+        return true;
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        waitForPendingTasks();
+    }
+
+    void TaskGroup::run(std::function<void()> task)
+    {
+        ++m_numberOfPendingTasks;
+
+        m_threadPool.submit([this, task = std::move(task)] {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                const std::scoped_lock lock{m_mutex};
+
+                if (not m_exception)
+                {
+                    m_exception = std::current_exception();
+                }
+            }
+
+            // The lock prevents that the group is destroyed before it has been notified
+            const std::scoped_lock lock{m_mutex};
+
+            if (--m_numberOfPendingTasks == 0)
+            {
+                m_allTasksAreDone.notify_all();
+            }
+        });
+    }
+
+    void TaskGroup::wait()
+    {
+        waitForPendingTasks();
+
+        const std::scoped_lock lock{m_mutex};
+
+        if (m_exception)
+        {
+            std::rethrow_exception(std::exchange(m_exception, nullptr));
+        }
+    }
+
+    void TaskGroup::waitForPendingTasks()
+    {
+        const uint32_t workerIndex = m_threadPool.currentWorkerIndex();
+
+        if (workerIndex != ThreadPool::NoWorker)
+        {
+            // A blocked worker could deadlock nested groups, therefore it helps
+            while (m_numberOfPendingTasks > 0)
+            {
+                if (not m_threadPool.runPendingTask(workerIndex))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        std::unique_lock lock{m_mutex};
+        m_allTasksAreDone.wait(lock, [this] { return m_numberOfPendingTasks == 0; });
+    }
+}
\ No newline at end of file
@@ -1,61 +1,134 @@
 #include "ModernChess/TranspositionTable.h"
 #include "ModernChess/MemoryAllocator.h"
 
+#include <algorithm>
 #include <cstring>
 
 namespace ModernChess {
 
-    TranspositionTable::TranspositionTable()
+    TranspositionTable::TranspositionTable(size_t mbSize)
     {
-        resize(16); // Default: 16 MB
+        resize(mbSize);
+    }
+
+    void TranspositionTable::newSearch()
+    {
+        // Wraps around, so the entries of the search 256 searches ago are taken as current ones
+        ++m_generation;
     }
 
     void TranspositionTable::addEntry(uint64_t hash, HashFlag flag, int32_t score, uint8_t depth)
     {
-        const TTEntry entry(hash, flag, score, depth);
-        const size_t index = hash % m_numberEntries;
-        m_table[index] = entry;
+        const TTEntry entry(hash, flag, score, depth, m_generation);
+        TTBucket &bucket = m_table[hash % m_numberOfBuckets];
+
+        if (bucket.depthPreferred.generation != m_generation or depth >= bucket.depthPreferred.depth)
+        {
+            bucket.depthPreferred = entry;
+        }
+        else
+        {
+            bucket.alwaysReplaced = entry;
+        }
     }
 
     int32_t TranspositionTable::getScore(uint64_t hash, int32_t alpha, int32_t beta, uint8_t depth) const
     {
-        const size_t index = hash % m_numberEntries;
-        const TTEntry &entry = m_table[index];
+        const TTBucket &bucket = m_table[hash % m_numberOfBuckets];
 
-        if (entry.hash == hash)
+        if (bucket.depthPreferred.hash == hash)
         {
-            /* The depth tells how accurate or reasonable a scoring is.
-             * I.e. the scoring of 10-ply search is more accurate/reliable than from a 3-ply search.
-             */
-            if (entry.depth >= depth)
+            if (const int32_t score = scoreOfEntry(bucket.depthPreferred, alpha, beta, depth); score != NoHashEntryFound)
+            {
+                return score;
+            }
+        }
+
+        if (bucket.alwaysReplaced.hash == hash)
+        {
+            return scoreOfEntry(bucket.alwaysReplaced, alpha, beta, depth);
+        }
+
+        return NoHashEntryFound;
+    }
+
+    int32_t TranspositionTable::scoreOfEntry(const TTEntry &entry, int32_t alpha, int32_t beta, uint8_t depth)
+    {
+        /* The depth tells how accurate or reasonable a scoring is.
+         * I.e. the scoring of 10-ply search is more accurate/reliable than from a 3-ply search.
+         */
+        if (entry.depth >= depth)
+        {
+            // PV node score
+            if (entry.hashFlag == HashFlag::Exact)
+            {
+                return entry.score;
+            }
+            if (entry.hashFlag == HashFlag::Alpha and entry.score <= alpha)
+            {
+                return alpha;
+            }
+            if (entry.hashFlag == HashFlag::Beta and entry.score >= beta)
             {
-                // PV node score
-                if (entry.hashFlag == HashFlag::Exact)
-                {
-                    return entry.score;
-                }
-                if (entry.hashFlag == HashFlag::Alpha and entry.score <= alpha)
-                {
-                    return alpha;
-                }
-                if (entry.hashFlag == HashFlag::Beta and entry.score >= beta)
-                {
-                    return beta;
-                }
+                return beta;
             }
         }
 
         return NoHashEntryFound;
     }
 
-    void TranspositionTable::resize(size_t mbSize)
+    bool TranspositionTable::contains(uint64_t hash) const
+    {
+        const TTBucket &bucket = m_table[hash % m_numberOfBuckets];
+        return bucket.depthPreferred.hash == hash or bucket.alwaysReplaced.hash == hash;
+    }
+
+    uint32_t TranspositionTable::hashfull() const
+    {
+        const size_t numberOfSamples = std::min<size_t>(1000, m_numberOfBuckets);
+        uint32_t occupiedEntries = 0;
+
+        for (size_t index = 0; index < numberOfSamples; ++index)
+        {
+            if (m_table[index].depthPreferred.hash != 0 and m_table[index].depthPreferred.generation == m_generation)
+            {
+                ++occupiedEntries;
+            }
+        }
+
+        return uint32_t(occupiedEntries * 1000 / numberOfSamples);
+    }
+
+    bool TranspositionTable::resize(size_t mbSize)
+    {
+        const size_t previousNumberOfBuckets = std::max<size_t>(m_numberOfBuckets, 1);
+
+        // Free the old table first, so both tables are not allocated at the same time
+        m_table.reset();
+        m_numberOfBuckets = std::max<size_t>(mbSize * 1024 * 1024 / sizeof(TTBucket), 1);
+        m_table = MemoryAllocator::tryAlignedArray<TTBucket>(m_numberOfBuckets * sizeof(TTBucket));
+
+        const bool resized = (m_table != nullptr);
+
+        if (not resized)
+        {
+            // The memory of the previous table has just been freed, so it is available again
+            m_numberOfBuckets = previousNumberOfBuckets;
+            m_table = MemoryAllocator::alignedArray<TTBucket>(m_numberOfBuckets * sizeof(TTBucket));
+        }
+
+        clear();
+
+        return resized;
+    }
+
+    size_t TranspositionTable::sizeInMB() const
     {
-        m_numberEntries = mbSize * 1024 * 1024 / sizeof(TTEntry);
-        m_table = MemoryAllocator::alignedArray<TTEntry>(m_numberEntries * sizeof(TTEntry));
+        return m_numberOfBuckets * sizeof(TTBucket) / (1024 * 1024);
     }
 
     void TranspositionTable::clear()
     {
-        std::memset(m_table.get(), 0, m_numberEntries * sizeof(TTEntry));
+        std::memset(m_table.get(), 0, m_numberOfBuckets * sizeof(TTBucket));
     }
 }
\ No newline at end of file
@@ -1,21 +1,54 @@
 #include "ModernChess/UCICommunication.h"
 #include "ModernChess/MoveExecution.h"
-#include "ModernChess/PseudoMoveGeneration.h"
+#include "ModernChess/MoveDecoder.h"
 #include "ModernChess/UCIParser.h"
 #include "ModernChess/FenParsing.h"
 #include "ModernChess/Evaluation.h"
+#include "ModernChess/Bench.h"
 
+#include <algorithm>
 #include <string>
 
 using ModernChess::FenParsing::FenParser;
 using namespace std::chrono_literals;
 
+namespace
+{
+    std::string_view trimWhiteSpaces(std::string_view text)
+    {
+        constexpr std::string_view whiteSpaces = " \t\r\n";
+        const size_t begin = text.find_first_not_of(whiteSpaces);
+
+        if (begin == std::string_view::npos)
+        {
+            return {};
+        }
+
+        return text.substr(begin, text.find_last_not_of(whiteSpaces) - begin + 1);
+    }
+
+    /**
+     * @return true, if all moves of the old sequence are the first moves of the new one
+     */
+    bool extendsMoveSequence(std::string_view moves, std::string_view oldMoves)
+    {
+        return moves.starts_with(oldMoves) and
+               (oldMoves.empty() or moves.size() == oldMoves.size() or moves[oldMoves.size()] == ' ');
+    }
+}
+
 namespace ModernChess
 {
-    UCICommunication::UCICommunication(std::istream &inputStream, std::ostream &outputStream, std::ostream &errorStream) :
+    UCICommunication::UCICommunication(std::istream &inputStream,
+                                       std::ostream &outputStream,
+                                       std::ostream &errorStream,
+                                       SearchContext &searchContext) :
             m_inputStream(inputStream),
             m_outputStream(outputStream),
             m_errorStream(errorStream),
+            m_searchContext(searchContext),
+            // "go" without "position" searches the starting position instead of an empty board
+            m_searchRequest(FenParser(FenParsing::startPosition).parse()),
             m_searchThread(&UCICommunication::searchBestMove, this)
     {}
 
@@ -39,6 +72,11 @@ namespace ModernChess
         {
             if (uiCommand.empty())
             {
+                if (m_quitAtEndOfInput && m_inputStream.eof())
+                {
+                    quitGame();
+                    break;
+                }
                 continue;
             }
             // make sure uiCommand is available
@@ -70,10 +108,29 @@ namespace ModernChess
             {
                 executeGoCommand(parser);
             }
+            else if (parser.uiHasSentPonderHit())
+            {
+                ponderHit();
+            }
             else if (parser.uiHasSentStopCommand())
             {
                 stopSearch();
             }
+            else if (parser.uiHasSentSetOption())
+            {
+                setOption(parser);
+            }
+            else if (parser.uiHasSentBenchCommand())
+            {
+                runBench(parser);
+            }
+            else if (parser.uiHasSentDebugCommand())
+            {
+                const bool debug = parser.uiHasSentOnValue();
+
+                const std::lock_guard lock(m_mutex);
+                m_debug = debug;
+            }
             else if (parser.uiRequestsUCIMode())
             {
                 registerToUI();
@@ -90,15 +147,46 @@ namespace ModernChess
         }
     }
 
+    void UCICommunication::setMaxHashSize(size_t mbSize)
+    {
+        m_maxHashSizeInMB = std::clamp(mbSize, size_t(1), TranspositionTable::MaxSizeInMB);
+    }
+
+    void UCICommunication::setQuitAtEndOfInput(bool quitAtEndOfInput)
+    {
+        m_quitAtEndOfInput = quitAtEndOfInput;
+    }
+
     void UCICommunication::registerToUI()
     {
         m_outputStream << "id name Modern Chess\n"
                        << "id author Stefano Di Martino\n"
-                       << "uciok\n" << std::flush;
+                       << "option name Ponder type check default false\n"
+                       << "option name MultiPV type spin default 1 min 1 max " << MaxNumberOfPVs << "\n"
+                       << "option name Deterministic type check default false\n"
+                       << "option name Hash type spin default " << m_searchContext.transpositionTable().sizeInMB()
+                       << " min 1 max " << m_maxHashSizeInMB << "\n"
+                       << "option name Clear Hash type button\n"
+                       << "option name Threads type spin default 1 min 1 max " << MaxNumberOfThreads << "\n"
+                       << "option name UseNNUE type check default false\n"
+                       << "option name EvalFile type string default " << BuiltInEvalFile << "\n"
+                       << "option name OwnBook type check default false\n"
+                       << "option name BookFile type string default " << NoBookFile << "\n";
+
+        const SearchParameters &searchParameters = m_searchContext.searchParameters();
+
+        for (const TunableSearchParameter &parameter : TunableSearchParameters)
+        {
+            m_outputStream << "option name " << parameter.name << " type spin default " << searchParameters.*parameter.value
+                           << " min " << parameter.minimum << " max " << parameter.maximum << "\n";
+        }
+
+        m_outputStream << "uciok\n" << std::flush;
     }
 
     void UCICommunication::sendAcknowledgeToUI()
     {
+        const std::lock_guard lock(m_outputMutex);
         m_outputStream << "readyok\n" << std::flush;
     }
 
@@ -110,77 +198,71 @@ namespace ModernChess
 
     void UCICommunication::parsePosition(UCIParser &parser)
     {
-        if (parser.uiHasSentStartingPosition())
-        {
-            createNewGame();
-        }
-        else if (parser.uiHasSentFENPosition())
-        {
-            FenParser fenParser(parser.currentStringView());
-            setGameState(fenParser.parse());
+        constexpr std::string_view movesCommand = "moves";
+
+        const std::string_view positionCommand = parser.currentStringView();
+        const size_t movesPosition = positionCommand.find(movesCommand);
+        const std::string_view position = trimWhiteSpaces(positionCommand.substr(0, movesPosition));
+        const std::string_view moves = (movesPosition == std::string_view::npos) ?
+                                       std::string_view{} :
+                                       trimWhiteSpaces(positionCommand.substr(movesPosition + movesCommand.size()));
+
+        std::string_view newMoves = moves;
 
-            // There might be consecutive move commands. So continue with parsing...
-            parser = UCIParser(fenParser.currentStringView());
+        if (position == m_positionCache.position and extendsMoveSequence(moves, m_positionCache.moves))
+        {
+            newMoves = moves.substr(m_positionCache.moves.size());
         }
         else
         {
-            throw std::runtime_error("Missing position after position command: " +
-                                      std::string(parser.completeStringView()));
+            m_positionCache.gameState = parseStartPosition(position);
+            m_positionCache.position = position;
         }
 
-        if (parser.uiHasSentMoves())
+        GameState &gameState = m_positionCache.gameState;
+        UCIParser movesParser(trimWhiteSpaces(newMoves));
+
+        while (movesParser.hasNextCharacter())
         {
-            const std::string_view moveCommand = parser.currentStringView();
-            const std::lock_guard lock(m_mutex); // Add mutex for game state change
+            const Move move = MoveDecoder::decodeMove(gameState, movesParser.parseMove());
+            const GameState gameStateCopy = gameState;
 
-            while (parser.hasNextCharacter())
+            if (move.isNullMove() or not MoveExecution::executeMove(gameState, move, MoveType::AllMoves))
             {
-                const Move move = executeMoves(parser);
-
-                if (not move.isNullMove())
-                {
-                    MoveExecution::executeMove(m_searchRequest.gameState, move, MoveType::AllMoves);
-                }
-                else
-                {
-                    m_errorStream << "Illegal move detected: " << moveCommand << std::endl;
-                    break;
-                }
+                gameState = gameStateCopy;
+                m_errorStream << "Illegal move detected: " << moves << std::endl;
+                // The cached moves do not match the game state anymore
+                m_positionCache.position.clear();
+                break;
             }
         }
-    }
 
-    void UCICommunication::createNewGame()
-    {
-        setGameState(FenParser(FenParsing::startPosition).parse());
+        m_positionCache.moves = moves;
+        setGameState(gameState);
     }
 
-    Move UCICommunication::executeMoves(UCIParser &parser) const
+    GameState UCICommunication::parseStartPosition(std::string_view position)
     {
-        const UCIParser::UCIMove uciMove = parser.parseMove();
-        const std::vector<Move> possibleMovesFromCurrentSate = PseudoMoveGeneration::generateMoves(m_searchRequest.gameState);
+        UCIParser parser(position);
 
-        for (const Move move : possibleMovesFromCurrentSate)
+        if (parser.uiHasSentStartingPosition())
         {
-            if (move.getFrom() == uciMove.sourceSquare and
-                move.getTo() == uciMove.targetSquare)
-            {
-                if (const Figure promotedPiece = move.getPromotedPiece();
-                        promotedPiece != Figure::None)
-                {
-                    if (uciMove.legalPromotionCharacter)
-                    {
-                        return move;
-                    }
-                    // Illegal Move --> Return Null Move
-                    return {};
-                }
-                return move;
-            }
+            return FenParser(FenParsing::startPosition).parse();
+        }
+
+        if (parser.uiHasSentFENPosition())
+        {
+            return FenParser(parser.currentStringView()).parse();
         }
 
-        // Illegal Move --> Return Null Move
-        return {};
+        throw std::runtime_error("Missing position after position command: " + std::string(position));
+    }
+
+    void UCICommunication::createNewGame()
+    {
+        setGameState(FenParser(FenParsing::startPosition).parse());
+        // Positions of the previous game are not needed anymore
+        changeSearchContext([this]{ m_searchContext.clear(); });
     }
 
     void UCICommunication::executeGoCommand(UCIParser &parser)
@@ -188,13 +270,22 @@ namespace ModernChess
         std::chrono::milliseconds timeToSearch = -1ms;
         std::chrono::milliseconds timeIncrement = 0ms;
         int64_t movesToGo = 1;
+        uint64_t nodes = std::numeric_limits<uint64_t>::max();
+        bool ponder = false;
+        bool infinite = false;
 
         while (parser.hasNextCharacter())
         {
+            if (parser.uiHasSentPonder())
+            {
+                // search on the opponent's time: the position already contains the predicted move
+                ponder = true;
+            }
             if (parser.uiHasSentSearchDepth())
             {
                 const std::lock_guard lock(m_mutex);
-                m_searchRequest.depth = parser.parseNumber<uint8_t>();
+                // uint8_t would be parsed as character
+                m_searchRequest.depth = uint8_t(std::clamp(parser.parseNumber<uint32_t>(), uint32_t(1), uint32_t(MaxHalfMoves / 2)));
             }
             if (parser.uiHasSentMovesTime())
             {
@@ -251,11 +342,22 @@ namespace ModernChess
             if (parser.uiHasSentInfiniteTime())
             {
                 timeToSearch = InfiniteTime;
+                infinite = true;
+            }
+            if (parser.uiHasSentNodes())
+            {
+                nodes = parser.parseNumber<uint64_t>();
             }
 
             parser.skipWhiteSpaces();
         }
 
+        // Pondering and analysis wait for "stop", so the best move must not be sent immediately
+        if ((not ponder) and (not infinite) and sendBookMove())
+        {
+            return;
+        }
+
         if (timeToSearch == -1ms)
         {
             // Time has not been set. Set infinite time
@@ -269,12 +371,201 @@ namespace ModernChess
         {
             const std::lock_guard lock(m_mutex);
             m_stopped = false;
-            m_searchRequest.timePointToStopSearch = std::chrono::steady_clock::now() + timeToSearch;
+            m_pondering = ponder;
+            m_timeToSearchAfterPonderHit = timeToSearch;
+            m_searchRequest.nodes = nodes;
+            m_searchRequest.timePointToStopSearch = std::chrono::steady_clock::now() + (ponder ? InfiniteTime : timeToSearch);
         }
 
         m_waitForSearchRequest.notifyOne();
     }
 
+    bool UCICommunication::sendBookMove()
+    {
+        Move bookMove;
+
+        {
+            const std::lock_guard lock(m_mutex);
+
+            if ((not m_useBook) or m_book == nullptr or searchIsRunning())
+            {
+                return false;
+            }
+
+            const uint32_t randomNumber = m_deterministic ? 0 : uint32_t(m_bookRandomGenerator());
+            bookMove = m_book->chooseMove(m_searchRequest.gameState, randomNumber);
+        }
+
+        if (bookMove.isNullMove())
+        {
+            return false;
+        }
+
+        const std::lock_guard lock(m_outputMutex);
+        m_outputStream << "bestmove " << bookMove << "\n" << std::flush;
+
+        return true;
+    }
+
+    void UCICommunication::ponderHit()
+    {
+        {
+            const std::lock_guard lock(m_mutex);
+
+            if (not m_pondering)
+            {
+                return;
+            }
+
+            // The opponent played the predicted move. The running search continues as a timed search
+            // with everything it has already found.
+            m_pondering = false;
+            m_searchRequest.timePointToStopSearch = std::chrono::steady_clock::now() + m_timeToSearchAfterPonderHit;
+        }
+
+        m_waitForSearchRequest.notifyOne();
+    }
+
+    void UCICommunication::waitUntilPonderingHasFinished()
+    {
+        std::unique_lock lock(m_mutex);
+        m_waitForSearchRequest.wait(lock, [this]{
+            return (not m_pondering) or m_stopped or m_quit;
+        });
+        m_pondering = false;
+    }
+
+    void UCICommunication::setOption(UCIParser &parser)
+    {
+        if (not parser.uiHasSentOptionName())
+        {
+            m_errorStream << "Missing option name: " << parser.completeStringView() << std::endl;
+            return;
+        }
+
+        if (parser.uiHasSentMultiPVOption() && parser.uiHasSentOptionValue())
+        {
+            const uint32_t numberOfPVs = std::clamp(parser.parseNumber<uint32_t>(), uint32_t(1), MaxNumberOfPVs);
+
+            const std::lock_guard lock(m_mutex);
+            m_numberOfPVs = numberOfPVs;
+        }
+        else if (parser.uiHasSentPonderOption())
+        {
+            // Nothing to do: The UI tells the engine with "go ponder", when it is allowed to ponder
+        }
+        else if (parser.uiHasSentDeterministicOption() && parser.uiHasSentOptionValue())
+        {
+            const bool deterministic = parser.uiHasSentTrueValue();
+
+            const std::lock_guard lock(m_mutex);
+            m_deterministic = deterministic;
+        }
+        else if (parser.uiHasSentThreadsOption())
+        {
+            // Nothing to do: The search is single-threaded, so the only valid value is MaxNumberOfThreads
+        }
+        else if (parser.uiHasSentHashOption() && parser.uiHasSentOptionValue())
+        {
+            const size_t mbSize = std::clamp(parser.parseNumber<size_t>(), size_t(1), m_maxHashSizeInMB);
+            changeSearchContext([this, mbSize]{
+                TranspositionTable &transpositionTable = m_searchContext.transpositionTable();
+
+                if (not transpositionTable.resize(mbSize))
+                {
+                    m_errorStream << "Could not allocate " << mbSize << " MB for the hash table. It keeps its size of "
+                                  << transpositionTable.sizeInMB() << " MB" << std::endl;
+                }
+            });
+        }
+        else if (parser.uiHasSentClearHashOption())
+        {
+            changeSearchContext([this]{ m_searchContext.transpositionTable().clear(); });
+        }
+        else if (parser.uiHasSentUseNNUEOption() && parser.uiHasSentOptionValue())
+        {
+            const bool useNeuralNetwork = parser.uiHasSentTrueValue();
+
+            changeSearchContext([this, useNeuralNetwork]{
+                m_useNeuralNetwork = useNeuralNetwork;
+                updateNeuralNetwork();
+            });
+        }
+        else if (parser.uiHasSentEvalFileOption() && parser.uiHasSentOptionValue())
+        {
+            const std::string evalFile(parser.currentStringView());
+
+            changeSearchContext([this, &evalFile]{
+                try
+                {
+                    m_evalFileNetwork = (evalFile == BuiltInEvalFile) ? nullptr : NeuralNetwork::load(evalFile);
+                    updateNeuralNetwork();
+                }
+                catch (const std::exception &exception)
+                {
+                    m_errorStream << exception.what() << std::endl;
+                }
+            });
+        }
+        else if (parser.uiHasSentOwnBookOption() && parser.uiHasSentOptionValue())
+        {
+            const bool useBook = parser.uiHasSentTrueValue();
+
+            const std::lock_guard lock(m_mutex);
+            m_useBook = useBook;
+        }
+        else if (parser.uiHasSentBookFileOption() && parser.uiHasSentOptionValue())
+        {
+            const std::string bookFile(parser.currentStringView());
+
+            try
+            {
+                // The book is loaded without the lock, so a running search is not blocked
+                std::shared_ptr<const PolyglotBook> book = (bookFile == NoBookFile) ? nullptr : PolyglotBook::load(bookFile);
+
+                const std::lock_guard lock(m_mutex);
+                m_book = std::move(book);
+            }
+            catch (const std::exception &exception)
+            {
+                m_errorStream << exception.what() << std::endl;
+            }
+        }
+        else if (const TunableSearchParameter *parameter = parser.uiHasSentSearchParameterOption();
+                 parameter != nullptr && parser.uiHasSentOptionValue())
+        {
+            const int32_t value = std::clamp(parser.parseNumber<int32_t>(), parameter->minimum, parameter->maximum);
+
+            changeSearchContext([this, parameter, value]{
+                SearchParameters searchParameters = m_searchContext.searchParameters();
+                searchParameters.*parameter->value = value;
+                m_searchContext.setSearchParameters(searchParameters);
+            });
+        }
+        else
+        {
+            m_errorStream << "Unknown option: " << parser.completeStringView() << std::endl;
+        }
+    }
+
+    void UCICommunication::runBench(UCIParser &parser)
+    {
+        const uint32_t depth = parser.isAtEndOfString() ? Bench::DefaultDepth
+                                                        : std::clamp(parser.parseNumber<uint32_t>(), uint32_t(1), uint32_t(MaxHalfMoves / 2));
+
+        {
+            const std::lock_guard lock(m_mutex);
+
+            if (searchIsRunning())
+            {
+                m_errorStream << "bench is not possible while searching" << std::endl;
+                return;
+            }
+        }
+
+        Bench::run(m_outputStream, uint8_t(depth));
+    }
+
     void UCICommunication::searchBestMove()
     {
         auto stopCondition = [this] { return searchHasBeenStopped(); };
@@ -286,37 +577,154 @@ namespace ModernChess
                 m_waitForSearchRequest.wait(lock, [this]{
                     return (not m_stopped) or m_quit;
                 });
+                m_searchThreadIsBusy = not m_quit;
             }
 
-            Evaluation evaluation(getGameState(), stopCondition);
-            EvaluationResult evalResult;
+            Evaluation evaluation(m_searchContext, getGameState(), stopCondition);
+            IterativeDeepeningResult result;
 
             uint8_t depth;
+            uint32_t numberOfPVs;
+            bool debug;
+            bool deterministic;
 
             {
                 const std::lock_guard lock(m_mutex);
                 depth = m_searchRequest.depth;
+                numberOfPVs = m_numberOfPVs;
+                debug = m_debug;
+                deterministic = m_deterministic;
+                evaluation.setNodeLimit(m_searchRequest.nodes);
+            }
+
+            const auto searchProgress = std::make_shared<SearchProgress>();
+            evaluation.setSearchProgress(searchProgress);
+            m_timeSinceSearchStarted.start();
+
+            {
+                PeriodicTask searchProgressReporter(SearchProgressReportPeriod,
+                                                    &UCICommunication::sendSearchProgress,
+                                                    this,
+                                                    std::cref(*searchProgress));
+                // The periodic report would make the output depend on the timing
+                if (not deterministic)
+                {
+                    searchProgressReporter.start();
+                }
+
+                // Nothing is searched, if the engine has been quit
+                if (not searchHasBeenStopped())
+                {
+                    result = evaluation.searchIteratively(depth, {
+                        .numberOfPVs = numberOfPVs,
+                        .onIterationFinished = [this](const std::vector<EvaluationResult> &evaluationResults) {
+                            const std::lock_guard lock(m_outputMutex);
+
+                            for (const EvaluationResult &evaluationResult : evaluationResults)
+                            {
+                                m_outputStream << evaluationResult;
+                            }
+                            m_outputStream << std::flush;
+                        }
+                    });
+                }
+                // The reporter is joined here, so it does not report after the best move
+            }
+
+            const bool hasBeenSearched = result.depth > 0;
+
+            if (debug && hasBeenSearched)
+            {
+                evaluation.statistics().printAsInfoStrings(m_outputStream);
             }
 
-            for (uint8_t currentDepth = 1; currentDepth <= depth && (not searchHasBeenStopped()); ++currentDepth)
+            waitUntilPonderingHasFinished();
+
+            if (hasBeenSearched)
             {
-                evalResult = evaluation.getBestMove(currentDepth);
-                m_outputStream << evalResult << std::flush;
+                const std::lock_guard lock(m_outputMutex);
+                m_outputStream << "bestmove " << result.bestMove();
+
+                // The opponent's expected reply is the move to ponder on
+                if (result.pv.size() > 1)
+                {
+                    m_outputStream << " ponder " << result.pv[1];
+                }
+
+                m_outputStream << "\n" << std::flush;
             }
 
-            if (evalResult.pvTable != nullptr)
             {
-                m_outputStream << "bestmove " << evalResult.bestMove() << "\n" << std::flush;
+                const std::lock_guard lock(m_mutex);
+                m_searchThreadIsBusy = false;
             }
 
             stopSearch();
         }
     }
 
-    void UCICommunication::stopSearch()
+    bool UCICommunication::searchIsRunning() const
+    {
+        return (not m_stopped) or m_searchThreadIsBusy;
+    }
+
+    void UCICommunication::changeSearchContext(const std::function<void()> &change)
     {
+        // Keep the lock, so no search can be started while changing the table
         const std::lock_guard lock(m_mutex);
-        m_stopped = true;
+
+        if (searchIsRunning())
+        {
+            m_errorStream << "The option cannot be changed while searching" << std::endl;
+            return;
+        }
+
+        change();
+    }
+
+    void UCICommunication::updateNeuralNetwork()
+    {
+        if (not m_useNeuralNetwork)
+        {
+            m_searchContext.setNeuralNetwork(nullptr);
+        }
+        else
+        {
+            m_searchContext.setNeuralNetwork(m_evalFileNetwork ? m_evalFileNetwork : NeuralNetwork::defaultNetwork());
+        }
+    }
+
+    void UCICommunication::sendSearchProgress(const SearchProgress &searchProgress)
+    {
+        const auto elapsedTime = m_timeSinceSearchStarted.duration();
+        const uint64_t numberOfNodes = searchProgress.numberOfNodes.load(std::memory_order_relaxed);
+        const uint64_t nodesPerSecond = numberOfNodes * 1000 / uint64_t(std::max<int64_t>(elapsedTime.count(), 1));
+        const Move currentMove = searchProgress.currentMove.load(std::memory_order_relaxed);
+
+        const std::lock_guard lock(m_outputMutex);
+
+        m_outputStream << "info depth " << searchProgress.depth.load(std::memory_order_relaxed)
+                       << " nodes " << numberOfNodes
+                       << " nps " << nodesPerSecond
+                       << " time " << elapsedTime.count()
+                       << " hashfull " << searchProgress.hashfull.load(std::memory_order_relaxed);
+
+        if (not currentMove.isNullMove())
+        {
+            m_outputStream << " currmove " << currentMove
+                           << " currmovenumber " << searchProgress.currentMoveNumber.load(std::memory_order_relaxed);
+        }
+
+        m_outputStream << "\n" << std::flush;
+    }
+
+    void UCICommunication::stopSearch()
+    {
+        {
+            const std::lock_guard lock(m_mutex);
+            m_stopped = true;
+        }
+        m_waitForSearchRequest.notifyOne();
     }
 
     void UCICommunication::quitGame()
@@ -332,7 +740,8 @@ namespace ModernChess
     bool UCICommunication::searchHasBeenStopped() const
     {
         const std::lock_guard lock(m_mutex);
-        return m_stopped or (m_searchRequest.timePointToStopSearch < std::chrono::steady_clock::now());
+        return m_stopped or
+               ((not m_deterministic) && m_searchRequest.timePointToStopSearch < std::chrono::steady_clock::now());
     }
 
     bool UCICommunication::gameHasBeenQuit() const
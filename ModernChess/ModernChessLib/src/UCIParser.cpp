@@ -1,5 +1,8 @@
 #include "ModernChess/UCIParser.h"
 
+#include <algorithm>
+#include <cctype>
+
 namespace ModernChess
 {
     UCIParser::UCIParser(std::string_view uiCommand) : BasicParser(uiCommand)
@@ -95,6 +98,119 @@ namespace ModernChess
         return uiHasSentCommand("infinite");
     }
 
+    bool UCIParser::uiHasSentNodes()
+    {
+        return uiHasSentCommand("nodes");
+    }
+
+    bool UCIParser::uiHasSentPonder()
+    {
+        return uiHasSentCommand("ponder");
+    }
+
+    bool UCIParser::uiHasSentPonderHit()
+    {
+        return uiHasSentCommand("ponderhit");
+    }
+
+    bool UCIParser::uiHasSentSetOption()
+    {
+        return uiHasSentCommand("setoption");
+    }
+
+    bool UCIParser::uiHasSentOptionName()
+    {
+        return uiHasSentCommand("name");
+    }
+
+    bool UCIParser::uiHasSentOptionValue()
+    {
+        return uiHasSentCommand("value");
+    }
+
+    bool UCIParser::uiHasSentMultiPVOption()
+    {
+        return uiHasSentOption("MultiPV");
+    }
+
+    bool UCIParser::uiHasSentPonderOption()
+    {
+        return uiHasSentOption("Ponder");
+    }
+
+    bool UCIParser::uiHasSentDeterministicOption()
+    {
+        return uiHasSentOption("Deterministic");
+    }
+
+    bool UCIParser::uiHasSentHashOption()
+    {
+        return uiHasSentOption("Hash");
+    }
+
+    bool UCIParser::uiHasSentThreadsOption()
+    {
+        return uiHasSentOption("Threads");
+    }
+
+    bool UCIParser::uiHasSentClearHashOption()
+    {
+        return uiHasSentOption("Clear Hash");
+    }
+
+    bool UCIParser::uiHasSentUseNNUEOption()
+    {
+        return uiHasSentOption("UseNNUE");
+    }
+
+    bool UCIParser::uiHasSentEvalFileOption()
+    {
+        return uiHasSentOption("EvalFile");
+    }
+
+    bool UCIParser::uiHasSentOwnBookOption()
+    {
+        return uiHasSentOption("OwnBook");
+    }
+
+    bool UCIParser::uiHasSentBookFileOption()
+    {
+        return uiHasSentOption("BookFile");
+    }
+
+    const TunableSearchParameter *UCIParser::uiHasSentSearchParameterOption()
+    {
+        for (const TunableSearchParameter &parameter : TunableSearchParameters)
+        {
+            if (uiHasSentOption(parameter.name))
+            {
+                return &parameter;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool UCIParser::uiHasSentTrueValue()
+    {
+        return uiHasSentCommand("true");
+    }
+
+    bool UCIParser::uiHasSentDebugCommand()
+    {
+        return uiHasSentCommand("debug");
+    }
+
+    bool UCIParser::uiHasSentOnValue()
+    {
+        return uiHasSentCommand("on");
+    }
+
+    bool UCIParser::uiHasSentBenchCommand()
+    {
+        return uiHasSentCommand("bench");
+    }
+
     bool UCIParser::uiHasSentCommand(std::string_view command)
     {
         if (currentStringView().starts_with(command))
@@ -106,6 +222,30 @@ namespace ModernChess
         return false;
     }
 
+    bool UCIParser::uiHasSentOption(std::string_view optionName)
+    {
+        const std::string_view remainingCommand = currentStringView();
+
+        if (remainingCommand.size() < optionName.size())
+        {
+            return false;
+        }
+
+        const bool nameMatches = std::equal(optionName.begin(), optionName.end(), remainingCommand.begin(), [](char lhs, char rhs) {
+            return std::tolower(static_cast<unsigned char>(lhs)) == std::tolower(static_cast<unsigned char>(rhs));
+        });
+        const bool nameEnds = remainingCommand.size() == optionName.size() or
+                              std::isspace(static_cast<unsigned char>(remainingCommand[optionName.size()]));
+
+        if (nameMatches and nameEnds)
+        {
+            m_currentPos += optionName.length();
+            skipWhiteSpaces();
+            return true;
+        }
+        return false;
+    }
+
     UCIParser::UCIMove UCIParser::parseMove()
     {
         // Uses long algebraic notation, i.e.
@@ -115,11 +255,12 @@ namespace ModernChess
         const Square targetSquare = parseSquare();
 
         bool uiSentLegalPromotion = false;
+        char promotionCharacter = '\0';
 
         if (not isAtEndOfString() and
             currentCharacter() != ' ')
         {
-            const char promotionCharacter = currentCharacter();
+            promotionCharacter = currentCharacter();
 
             uiSentLegalPromotion = promotionCharacter == 'q' or
                                    promotionCharacter == 'r' or
@@ -136,6 +277,6 @@ namespace ModernChess
         // move iterator to next position
         nextPosition();
 
-        return UCIMove{sourceSquare, targetSquare, uiSentLegalPromotion};
+        return UCIMove{sourceSquare, targetSquare, uiSentLegalPromotion, promotionCharacter};
     }
 }
\ No newline at end of file
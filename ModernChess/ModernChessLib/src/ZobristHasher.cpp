@@ -12,6 +12,10 @@ namespace ModernChess {
     std::array<uint64_t, 16> ZobristHasher::castleKeys = {};
     uint64_t ZobristHasher::sideKey = {};
 
+    // The keys are generated once at start-up and never changed afterwards, so all engines of a process share them.
+    // They are generated here, because this translation unit is linked whenever a hash is computed.
+    const ZobristHasher keyGenerator{};
+
     ZobristHasher::ZobristHasher()
     {
         PseudoRandomGenerator randomGenerator;
@@ -21,25 +25,25 @@ namespace ModernChess {
             // loop over board squares
             for (Square square = Square::a1; square <= Square::h8; ++square)
             {    // init random figure keys
-                pieceKeys[figure][square] = randomGenerator.getRandomU64Number();
+                pieceKeys[figure][square] = randomGenerator.getRandomU64NumberXorShiftStar();
             }
         }
 
         // loop over board squares
         for (Square square = Square::a1; square <= Square::h8; ++square)
         {    // init random en passant keys
-            enpassantKeys[square] = randomGenerator.getRandomU64Number();
+            enpassantKeys[square] = randomGenerator.getRandomU64NumberXorShiftStar();
         }
 
         // loop over castling keys (see CastlingRights.h)
         for (uint8_t index = 0; index < 16; ++index)
         {
             // init castling keys
-            castleKeys[index] = randomGenerator.getRandomU64Number();
+            castleKeys[index] = randomGenerator.getRandomU64NumberXorShiftStar();
         }
 
         // init random side key
-        sideKey = randomGenerator.getRandomU64Number();
+        sideKey = randomGenerator.getRandomU64NumberXorShiftStar();
     }
 
     uint64_t ZobristHasher::generateHash(const Board &board)
@@ -1,25 +1,169 @@
 #include "ModernChess/PerftLib/PerformanceTest.h"
+#include "ModernChess/PerftLib/PerftSuite.h"
 
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <string_view>
 
 using namespace ModernChess::Perft;
 
+namespace
+{
+    /**
+     * @brief Runs all positions of an EPD file, e.g.
+     *        ./perft --suite perftsuite.epd --depth 5 --threads 8 --bulk --json report.json
+     * @return exit code: 0, if all numbers of nodes are as expected
+     */
+    int runSuite(int argc, char *argv[])
+    {
+        int maxDepth = std::numeric_limits<int>::max();
+        uint32_t numberOfThreads = 1;
+        bool bulkCounting = false;
+        size_t cacheSizeMb = 0;
+        std::string jsonReportPath;
+        std::string csvReportPath;
+
+        for (int argIndex = 3; argIndex < argc; ++argIndex)
+        {
+            const std::string_view argument = argv[argIndex];
+
+            if (argument == "--bulk")
+            {
+                bulkCounting = true;
+            }
+            else if (argIndex + 1 >= argc)
+            {
+                std::cout << "Missing value of option " << argument << std::endl;
+                return 2;
+            }
+            else if (argument == "--depth")
+            {
+                maxDepth = std::stoi(argv[++argIndex]);
+            }
+            else if (argument == "--threads")
+            {
+                numberOfThreads = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else if (argument == "--hash")
+            {
+                cacheSizeMb = std::stoul(argv[++argIndex]);
+            }
+            else if (argument == "--json")
+            {
+                jsonReportPath = argv[++argIndex];
+            }
+            else if (argument == "--csv")
+            {
+                csvReportPath = argv[++argIndex];
+            }
+            else
+            {
+                std::cout << "Unknown option " << argument << std::endl;
+                return 2;
+            }
+        }
+
+        std::ifstream epdFile(argv[2]);
+
+        if (not epdFile)
+        {
+            std::cout << "Could not open " << argv[2] << std::endl;
+            return 2;
+        }
+
+        PerftSuite suite(epdFile);
+        suite.setMaxDepth(maxDepth);
+        suite.setNumberOfThreads(numberOfThreads);
+        suite.setBulkCounting(bulkCounting);
+        suite.setCacheSize(cacheSizeMb);
+
+        for (const PerftSuiteResult &result : suite.run())
+        {
+            std::cout << (result.passed() ? "ok    " : "FAILED") << " #" << result.positionIndex
+                      << " depth " << result.depth << " nodes " << result.nodes;
+
+            if (not result.passed())
+            {
+                std::cout << " (expected " << result.expectedNodes << ")";
+            }
+
+            std::cout << " " << result.elapsedMs << " ms " << result.nodesPerSecond << " nodes/s  " << result.fen << std::endl;
+        }
+
+        if (not jsonReportPath.empty())
+        {
+            std::ofstream jsonReport(jsonReportPath);
+            suite.writeJsonReport(jsonReport);
+        }
+
+        if (not csvReportPath.empty())
+        {
+            std::ofstream csvReport(csvReportPath);
+            suite.writeCsvReport(csvReport);
+        }
+
+        std::cout << (suite.allPassed() ? "All positions passed" : "Some positions FAILED") << std::endl;
+
+        return suite.allPassed() ? 0 : 1;
+    }
+}
+
 int main(int argc, char *argv[])
 {
-    if (argc != 3)
+    if (argc >= 3 && std::string_view(argv[1]) == "--suite")
     {
-        std::cout << "Pass depth and FEN string as argument. Example:" << std::endl;
-        std::cout << "./perft 5 \"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1\"" << std::endl;
+        try
+        {
+            return runSuite(argc, argv);
+        }
+        catch (const std::exception &ex)
+        {
+            std::cout << ex.what() << std::endl;
+            return 2;
+        }
+    }
+
+    if (argc < 3)
+    {
+        std::cout << "Pass depth, FEN string and optionally the number of threads as argument." << std::endl;
+        std::cout << "Options: --bulk (bulk counting at depth 1), --hash <MB> (cache for transpositions). Example:" << std::endl;
+        std::cout << "./perft 5 \"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1\" 4 --bulk --hash 64" << std::endl;
+        std::cout << "Suite mode with EPD lines like \"<FEN> ;D1 20 ;D2 400\" and optional JSON/CSV report:" << std::endl;
+        std::cout << "./perft --suite perftsuite.epd [--depth 5] [--threads 8] [--bulk] [--hash 64] [--json report.json] [--csv report.csv]" << std::endl;
         return 0;
     }
 
     const int depth = std::stoi(argv[1]);
     const std::string fenString = argv[2];
+    uint32_t numberOfThreads = 1;
+    bool bulkCounting = false;
+    size_t cacheSizeMb = 0;
+
+    for (int argIndex = 3; argIndex < argc; ++argIndex)
+    {
+        const std::string_view argument = argv[argIndex];
+
+        if (argument == "--bulk")
+        {
+            bulkCounting = true;
+        }
+        else if (argument == "--hash" && argIndex + 1 < argc)
+        {
+            cacheSizeMb = std::stoul(argv[++argIndex]);
+        }
+        else
+        {
+            numberOfThreads = uint32_t(std::stoul(argv[argIndex]));
+        }
+    }
 
     try
     {
         PerformanceTest performanceTest(fenString);
-        performanceTest.executePerformanceTest(depth);
+        performanceTest.setBulkCounting(bulkCounting);
+        performanceTest.setCacheSize(cacheSizeMb);
+        performanceTest.executeParallelPerformanceTest(depth, numberOfThreads);
     }
     catch (const std::exception &ex)
     {
@@ -2,11 +2,17 @@
 #include "ModernChess/MoveExecution.h"
 #include "ModernChess/PseudoMoveGeneration.h"
 #include "ModernChess/FenParsing.h"
+#include "ModernChess/CheckInfo.h"
+#include "ModernChess/ThreadPool.h"
+#include "ModernChess/PerftLib/PerftCache.h"
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 #include <chrono>
 #include <string_view>
+#include <atomic>
+#include <utility>
 
 using namespace ModernChess;
 using namespace ModernChess::MoveGenerations;
@@ -23,10 +29,29 @@ namespace ModernChess::Perft {
             std::cout << m_gameState << std::endl;
         }
 
+        /**
+         * @brief Bulk counting: At depth 1, the number of legal moves is returned without recursing into the leaves.
+         */
+        void setBulkCounting(bool enabled)
+        {
+            m_bulkCounting = enabled;
+        }
+
+        /**
+         * @brief Caches the number of nodes of subtrees, so transpositions are counted only once.
+         * @param mbSize size of the cache in MB. 0 disables the cache.
+         */
+        void setCacheSize(size_t mbSize)
+        {
+            m_cache = (mbSize == 0) ? nullptr : std::make_shared<PerftCache>(mbSize);
+        }
+
         uint64_t executePerformanceTest(int depth)
         {
             std::cout << "\n     Performance test\n\n";
 
+            m_divide.clear();
+
             // create move list instance
             std::vector<Move> moveList;
             moveList.reserve(256);
@@ -54,6 +79,7 @@ namespace ModernChess::Perft {
                 // old nodes
                 const uint64_t numberOfNotes = perftDriver(depth - 1);
                 accumulatedNodes += numberOfNotes;
+                m_divide.emplace_back(move, numberOfNotes);
                 // take back
                 m_gameState = gameStateCopy;
 
@@ -81,8 +107,125 @@ namespace ModernChess::Perft {
             return accumulatedNodes;
         }
 
+        /**
+         * @brief Same result as executePerformanceTest(), but the subtrees are counted by a work-stealing thread pool.
+         *        The upper plies are split recursively into tasks, see countNodesInParallel().
+         *        Every task has its own copy of the game state.
+         */
+        uint64_t executeParallelPerformanceTest(int depth, uint32_t numberOfThreads)
+        {
+            if (numberOfThreads <= 1 || depth < 2)
+            {
+                return executePerformanceTest(depth);
+            }
+
+            std::cout << "\n     Parallel performance test with " << numberOfThreads << " threads\n\n";
+
+            auto begin = std::chrono::high_resolution_clock::now();
+
+            const std::vector<Move> rootMoves = legalMoves(m_gameState);
+            std::vector<std::atomic<uint64_t>> nodesPerRootMove(rootMoves.size());
+
+            ThreadPool threadPool(numberOfThreads);
+            threadPool.parallelFor(0, rootMoves.size(), [this, &threadPool, &rootMoves, &nodesPerRootMove, depth](size_t index){
+                GameState gameStateAfterRootMove = m_gameState;
+                MoveExecution::executeMove(gameStateAfterRootMove, rootMoves[index], MoveType::AllMoves);
+                countNodesInParallel(threadPool, gameStateAfterRootMove, depth - 1, nodesPerRootMove[index]);
+            });
+
+            auto end = std::chrono::high_resolution_clock::now();
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+
+            m_divide.clear();
+            uint64_t accumulatedNodes = 0;
+
+            for (size_t index = 0; index < rootMoves.size(); ++index)
+            {
+                m_divide.emplace_back(rootMoves[index], nodesPerRootMove[index].load());
+                accumulatedNodes += nodesPerRootMove[index];
+
+                std::cout << rootMoves[index] << "\t nodes: " << nodesPerRootMove[index] << std::endl;
+            }
+
+            // print results
+            std::cout << "\n    Depth: " << depth << std::endl;
+            std::cout << "    Nodes: " << accumulatedNodes << std::endl;
+            std::cout << "Elapsed time: " << elapsed << " ms" << std::endl;
+            std::cout << "  Nodes/s: " << (accumulatedNodes * 1000) / uint64_t(std::max<int64_t>(elapsed, 1)) << std::endl;
+
+            return accumulatedNodes;
+        }
+
+        /**
+         * @brief Counts the nodes up to the given depth without any output, e.g. for test suites.
+         */
+        static uint64_t countNodes(const GameState &gameState, int depth, bool bulkCounting = false,
+                                   std::shared_ptr<PerftCache> cache = nullptr)
+        {
+            PerformanceTest worker(gameState, bulkCounting, std::move(cache));
+            return worker.perftDriver(depth);
+        }
+
+        /**
+         * @return number of nodes per legal root move of the last performance test ("divide")
+         */
+        [[nodiscard]] const std::vector<std::pair<Move, uint64_t>> &divide() const
+        {
+            return m_divide;
+        }
+
     private:
+        static constexpr int MinDepthForSplitting = 4;
+
         GameState m_gameState;
+        std::vector<std::pair<Move, uint64_t>> m_divide;
+        bool m_bulkCounting = false;
+        std::shared_ptr<PerftCache> m_cache{};
+
+        // Used by the worker threads. Does not print the game state.
+        explicit PerformanceTest(const GameState &gameState, bool bulkCounting, std::shared_ptr<PerftCache> cache) :
+                m_gameState(gameState),
+                m_bulkCounting(bulkCounting),
+                m_cache(std::move(cache))
+        {}
+
+        static std::vector<Move> legalMoves(const GameState &gameState)
+        {
+            std::vector<Move> moves = PseudoMoveGeneration::generateMoves(gameState);
+
+            std::erase_if(moves, [&gameState](const Move move){
+                GameState gameStateCopy = gameState;
+                return not MoveExecution::executeMove(gameStateCopy, move, MoveType::AllMoves);
+            });
+
+            return moves;
+        }
+
+        /**
+         * @brief Recursive splitting: Every move of the upper plies is a task, which can be stolen by an idle worker.
+         *        The subtrees of the lower plies are too small for tasks and are counted sequentially.
+         */
+        void countNodesInParallel(ThreadPool &threadPool,
+                                  const GameState &gameState,
+                                  int depth,
+                                  std::atomic<uint64_t> &numberOfNodes) const
+        {
+            if (depth < MinDepthForSplitting)
+            {
+                // the cache is shared by all tasks
+                PerformanceTest worker(gameState, m_bulkCounting, m_cache);
+                numberOfNodes += worker.perftDriver(depth);
+                return;
+            }
+
+            const std::vector<Move> moves = legalMoves(gameState);
+
+            threadPool.parallelFor(0, moves.size(), [this, &threadPool, &gameState, &moves, &numberOfNodes, depth](size_t index){
+                GameState gameStateAfterMove = gameState;
+                MoveExecution::executeMove(gameStateAfterMove, moves[index], MoveType::AllMoves);
+                countNodesInParallel(threadPool, gameStateAfterMove, depth - 1, numberOfNodes);
+            });
+        }
 
         bool makeMove(Move move, MoveType moveType)
         {
@@ -117,6 +260,20 @@ namespace ModernChess::Perft {
                 return numberNodes;
             }
 
+            if (m_bulkCounting && depth == 1)
+            {
+                return countLegalMoves();
+            }
+
+            if (m_cache)
+            {
+                if (const uint64_t cachedNodes = m_cache->getNodes(m_gameState.gameStateHash, depth);
+                    cachedNodes != PerftCache::NoEntryFound)
+                {
+                    return cachedNodes;
+                }
+            }
+
             std::vector<Move> move_list;
             move_list.reserve(256);
 
@@ -124,8 +281,8 @@ namespace ModernChess::Perft {
 
             for (const Move move : move_list)
             {
-                // preserve board state
-                const Board boardCopy = m_gameState.board;
+                // preserve board state. The hash has to be restored, too, in order to get valid cache keys.
+                const GameState gameStateCopy = m_gameState;
 
                 if (const bool kingIsNotInCheck = makeMove(move, MoveType::AllMoves);
                     not kingIsNotInCheck)
@@ -138,10 +295,47 @@ namespace ModernChess::Perft {
                 numberNodes += perftDriver(depth - 1);
 
                 // take back
-                m_gameState.board = boardCopy;
+                m_gameState = gameStateCopy;
+            }
+
+            if (m_cache)
+            {
+                m_cache->addEntry(m_gameState.gameStateHash, depth, numberNodes);
             }
 
             return numberNodes;
         }
+
+        uint64_t countLegalMoves()
+        {
+            std::vector<Move> move_list;
+            move_list.reserve(256);
+
+            generateMoves(move_list);
+
+            const CheckInfo checkInfo(m_gameState.board);
+            uint64_t numberOfLegalMoves = 0;
+
+            for (const Move move : move_list)
+            {
+                // Most moves are legal for sure. Only the remaining ones have to be executed.
+                if (checkInfo.moveIsKnownToBeLegal(move))
+                {
+                    ++numberOfLegalMoves;
+                    continue;
+                }
+
+                const GameState gameStateCopy = m_gameState;
+
+                if (makeMove(move, MoveType::AllMoves))
+                {
+                    ++numberOfLegalMoves;
+                }
+
+                m_gameState = gameStateCopy;
+            }
+
+            return numberOfLegalMoves;
+        }
     };
 }
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ModernChess/MemoryAllocator.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+
+namespace ModernChess::Perft {
+
+    /**
+     * @brief Caches the number of nodes of already counted subtrees, keyed by the hash of the position and the
+     *        remaining depth. Can be shared by several threads: An entry is stored as (key ^ data, data), so a torn
+     *        write by another thread is detected as a miss ("lockless hashing").
+     * @see https://www.chessprogramming.org/Perft#Hashing
+     * @see https://www.chessprogramming.org/Shared_Hash_Table#Lockless
+     */
+    class PerftCache {
+    public:
+        static constexpr uint64_t NoEntryFound = std::numeric_limits<uint64_t>::max();
+
+        explicit PerftCache(size_t mbSize) :
+                m_numberEntries(std::max<size_t>(mbSize * 1024 * 1024 / sizeof(CacheEntry), 1)),
+                m_table(MemoryAllocator::alignedArray<CacheEntry>(m_numberEntries * sizeof(CacheEntry)))
+        {
+            std::memset(m_table.get(), 0, m_numberEntries * sizeof(CacheEntry));
+        }
+
+        [[nodiscard]] uint64_t getNodes(uint64_t hash, int depth) const
+        {
+            CacheEntry &entry = m_table[index(hash, depth)];
+
+            const uint64_t data = std::atomic_ref(entry.data).load(std::memory_order_relaxed);
+            const uint64_t key = std::atomic_ref(entry.keyXorData).load(std::memory_order_relaxed) ^ data;
+
+            if (key == hash && int(data & DepthMask) == depth)
+            {
+                return data >> DepthBits;
+            }
+
+            return NoEntryFound;
+        }
+
+        void addEntry(uint64_t hash, int depth, uint64_t nodes)
+        {
+            CacheEntry &entry = m_table[index(hash, depth)];
+            const uint64_t data = (nodes << DepthBits) | uint64_t(depth);
+
+            std::atomic_ref(entry.keyXorData).store(hash ^ data, std::memory_order_relaxed);
+            std::atomic_ref(entry.data).store(data, std::memory_order_relaxed);
+        }
+
+    private:
+        // The lowest bits of the data store the depth, the remaining bits the number of nodes
+        static constexpr uint64_t DepthBits = 8;
+        static constexpr uint64_t DepthMask = (uint64_t(1) << DepthBits) - 1;
+
+        struct CacheEntry {
+            alignas(8) uint64_t keyXorData;
+            alignas(8) uint64_t data;
+        };
+
+        size_t m_numberEntries{};
+        std::unique_ptr<CacheEntry[], std::function<void(CacheEntry*)>> m_table;
+
+        [[nodiscard]] size_t index(uint64_t hash, int depth) const
+        {
+            // Different depths of the same position don't compete for the same slot
+            return (hash ^ (uint64_t(depth) * 0x9E3779B97F4A7C15ULL)) % m_numberEntries;
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ModernChess/PerftLib/PerftCache.h"
+
+#include <cinttypes>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ModernChess::Perft {
+
+    /**
+     * @brief Position of a perft suite with the expected number of nodes per depth.
+     *        An EPD line looks like "<FEN> ;D1 20 ;D2 400 ;D3 8902", like in the well known "perftsuite.epd".
+     */
+    struct PerftSuiteEntry {
+        std::string fen;
+        std::vector<std::pair<int, uint64_t>> expectedNodes;
+
+        /**
+         * @brief The half move clock and the move number may be missing in the FEN part of the line.
+         * @throws std::runtime_error if the line does not contain any expected number of nodes
+         */
+        static PerftSuiteEntry fromEpd(std::string_view epdLine);
+    };
+
+    struct PerftSuiteResult {
+        size_t positionIndex{};
+        std::string fen;
+        int depth{};
+        uint64_t expectedNodes{};
+        uint64_t nodes{};
+        int64_t elapsedMs{};
+        uint64_t nodesPerSecond{};
+
+        [[nodiscard]] bool passed() const
+        {
+            return nodes == expectedNodes;
+        }
+    };
+
+    /**
+     * @brief Runs all positions of an EPD file and compares the number of nodes with the expected ones.
+     *        With several threads, the positions are distributed to the threads and every position
+     *        is counted by one thread.
+     * @see https://www.chessprogramming.org/Perft#Perft_Suites
+     */
+    class PerftSuite {
+    public:
+        /**
+         * @brief Reads the positions from the stream. Empty lines and lines beginning with '#' are skipped.
+         */
+        explicit PerftSuite(std::istream &epdStream);
+
+        /**
+         * @brief Expected numbers of nodes of deeper depths are ignored. Default: all depths are tested.
+         */
+        void setMaxDepth(int maxDepth);
+
+        void setNumberOfThreads(uint32_t numberOfThreads);
+
+        void setBulkCounting(bool enabled);
+
+        /**
+         * @param mbSize size of the cache in MB shared by all positions. 0 disables the cache.
+         */
+        void setCacheSize(size_t mbSize);
+
+        /**
+         * @return one result per position and depth in the order of the EPD file
+         */
+        const std::vector<PerftSuiteResult> &run();
+
+        [[nodiscard]] bool allPassed() const;
+
+        [[nodiscard]] const std::vector<PerftSuiteEntry> &entries() const;
+
+        [[nodiscard]] const std::vector<PerftSuiteResult> &results() const;
+
+        void writeJsonReport(std::ostream &outputStream) const;
+
+        void writeCsvReport(std::ostream &outputStream) const;
+
+    private:
+        std::vector<PerftSuiteEntry> m_entries;
+        std::vector<PerftSuiteResult> m_results;
+        int m_maxDepth = std::numeric_limits<int>::max();
+        uint32_t m_numberOfThreads = 1;
+        bool m_bulkCounting = false;
+        std::shared_ptr<PerftCache> m_cache{};
+
+        [[nodiscard]] std::vector<PerftSuiteResult> runEntry(size_t positionIndex) const;
+    };
+}
\ No newline at end of file
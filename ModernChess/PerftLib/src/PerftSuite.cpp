@@ -0,0 +1,239 @@
+#include "ModernChess/PerftLib/PerftSuite.h"
+#include "ModernChess/PerftLib/PerformanceTest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace ModernChess::Perft {
+
+    PerftSuiteEntry PerftSuiteEntry::fromEpd(std::string_view epdLine)
+    {
+        PerftSuiteEntry entry;
+
+        const size_t fenEnd = epdLine.find(';');
+        std::istringstream fenStream(std::string(epdLine.substr(0, fenEnd)));
+
+        std::vector<std::string> fenFields;
+        for (std::string field; fenStream >> field; )
+        {
+            fenFields.push_back(field);
+        }
+
+        if (fenFields.size() < 4)
+        {
+            throw std::runtime_error("Could not parse FEN of EPD line: " + std::string(epdLine));
+        }
+
+        // EPD positions don't need the half move clock and the move number
+        for (size_t fieldIndex = fenFields.size(); fieldIndex < 6; ++fieldIndex)
+        {
+            fenFields.emplace_back(fieldIndex == 4 ? "0" : "1");
+        }
+
+        for (const std::string &field : fenFields)
+        {
+            if (not entry.fen.empty())
+            {
+                entry.fen += ' ';
+            }
+            entry.fen += field;
+        }
+
+        // operations look like ";D1 20"
+        for (size_t operationBegin = fenEnd; operationBegin != std::string_view::npos; )
+        {
+            const size_t operationEnd = epdLine.find(';', operationBegin + 1);
+            std::istringstream operation(std::string(epdLine.substr(operationBegin + 1, operationEnd - operationBegin - 1)));
+
+            std::string opcode;
+            uint64_t nodes = 0;
+
+            if (operation >> opcode >> nodes and opcode.size() > 1 and opcode.front() == 'D')
+            {
+                entry.expectedNodes.emplace_back(std::stoi(opcode.substr(1)), nodes);
+            }
+
+            operationBegin = operationEnd;
+        }
+
+        if (entry.expectedNodes.empty())
+        {
+            throw std::runtime_error("Missing expected number of nodes in EPD line: " + std::string(epdLine));
+        }
+
+        return entry;
+    }
+
+    PerftSuite::PerftSuite(std::istream &epdStream)
+    {
+        for (std::string line; std::getline(epdStream, line); )
+        {
+            if (line.find_first_not_of(" \t\r") == std::string::npos or line.front() == '#')
+            {
+                continue;
+            }
+
+            m_entries.push_back(PerftSuiteEntry::fromEpd(line));
+        }
+    }
+
+    void PerftSuite::setMaxDepth(int maxDepth)
+    {
+        m_maxDepth = maxDepth;
+    }
+
+    void PerftSuite::setNumberOfThreads(uint32_t numberOfThreads)
+    {
+        m_numberOfThreads = std::max(numberOfThreads, uint32_t(1));
+    }
+
+    void PerftSuite::setBulkCounting(bool enabled)
+    {
+        m_bulkCounting = enabled;
+    }
+
+    void PerftSuite::setCacheSize(size_t mbSize)
+    {
+        m_cache = (mbSize == 0) ? nullptr : std::make_shared<PerftCache>(mbSize);
+    }
+
+    const std::vector<PerftSuiteResult> &PerftSuite::run()
+    {
+        std::vector<std::vector<PerftSuiteResult>> resultsPerPosition(m_entries.size());
+        std::atomic<size_t> nextPosition{0};
+
+        auto worker = [this, &resultsPerPosition, &nextPosition]{
+            for (size_t positionIndex = nextPosition++; positionIndex < m_entries.size(); positionIndex = nextPosition++)
+            {
+                resultsPerPosition[positionIndex] = runEntry(positionIndex);
+            }
+        };
+
+        std::vector<std::thread> workers;
+
+        for (uint32_t thread = 1; thread < m_numberOfThreads; ++thread)
+        {
+            workers.emplace_back(worker);
+        }
+
+        worker();
+
+        for (std::thread &thread : workers)
+        {
+            thread.join();
+        }
+
+        m_results.clear();
+
+        for (std::vector<PerftSuiteResult> &results : resultsPerPosition)
+        {
+            std::move(results.begin(), results.end(), std::back_inserter(m_results));
+        }
+
+        return m_results;
+    }
+
+    std::vector<PerftSuiteResult> PerftSuite::runEntry(size_t positionIndex) const
+    {
+        const PerftSuiteEntry &entry = m_entries[positionIndex];
+        const GameState gameState = FenParsing::FenParser(entry.fen).parse();
+
+        std::vector<PerftSuiteResult> results;
+
+        for (const auto &[depth, expectedNodes] : entry.expectedNodes)
+        {
+            if (depth > m_maxDepth)
+            {
+                continue;
+            }
+
+            const auto begin = std::chrono::steady_clock::now();
+            const uint64_t nodes = PerformanceTest::countNodes(gameState, depth, m_bulkCounting, m_cache);
+            const auto end = std::chrono::steady_clock::now();
+
+            const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+            results.push_back(PerftSuiteResult{
+                .positionIndex = positionIndex,
+                .fen = entry.fen,
+                .depth = depth,
+                .expectedNodes = expectedNodes,
+                .nodes = nodes,
+                .elapsedMs = elapsedUs / 1000,
+                .nodesPerSecond = (nodes * 1'000'000) / uint64_t(std::max<int64_t>(elapsedUs, 1))
+            });
+        }
+
+        return results;
+    }
+
+    bool PerftSuite::allPassed() const
+    {
+        return std::ranges::all_of(m_results, [](const PerftSuiteResult &result){ return result.passed(); });
+    }
+
+    const std::vector<PerftSuiteEntry> &PerftSuite::entries() const
+    {
+        return m_entries;
+    }
+
+    const std::vector<PerftSuiteResult> &PerftSuite::results() const
+    {
+        return m_results;
+    }
+
+    void PerftSuite::writeJsonReport(std::ostream &outputStream) const
+    {
+        uint64_t totalNodes = 0;
+        int64_t totalElapsedMs = 0;
+
+        outputStream << "{\n  \"results\": [\n";
+
+        for (size_t index = 0; index < m_results.size(); ++index)
+        {
+            const PerftSuiteResult &result = m_results[index];
+            totalNodes += result.nodes;
+            totalElapsedMs += result.elapsedMs;
+
+            // FEN strings don't contain characters which have to be escaped
+            outputStream << "    {\"position\": " << result.positionIndex
+                         << ", \"fen\": \"" << result.fen << "\""
+                         << ", \"depth\": " << result.depth
+                         << ", \"expected\": " << result.expectedNodes
+                         << ", \"nodes\": " << result.nodes
+                         << ", \"time_ms\": " << result.elapsedMs
+                         << ", \"nps\": " << result.nodesPerSecond
+                         << ", \"passed\": " << (result.passed() ? "true" : "false") << "}"
+                         << (index + 1 < m_results.size() ? ",\n" : "\n");
+        }
+
+        outputStream << "  ],\n"
+                     << "  \"threads\": " << m_numberOfThreads << ",\n"
+                     << "  \"bulk_counting\": " << (m_bulkCounting ? "true" : "false") << ",\n"
+                     << "  \"hash\": " << (m_cache ? "true" : "false") << ",\n"
+                     << "  \"total_nodes\": " << totalNodes << ",\n"
+                     << "  \"total_time_ms\": " << totalElapsedMs << ",\n"
+                     << "  \"passed\": " << (allPassed() ? "true" : "false") << "\n"
+                     << "}\n";
+    }
+
+    void PerftSuite::writeCsvReport(std::ostream &outputStream) const
+    {
+        outputStream << "position,fen,depth,expected,nodes,time_ms,nps,passed\n";
+
+        for (const PerftSuiteResult &result : m_results)
+        {
+            outputStream << result.positionIndex << ",\"" << result.fen << "\","
+                         << result.depth << ","
+                         << result.expectedNodes << ","
+                         << result.nodes << ","
+                         << result.elapsedMs << ","
+                         << result.nodesPerSecond << ","
+                         << (result.passed() ? "true" : "false") << "\n";
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "ModernChess/TexelTuner.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace ModernChess;
+
+namespace
+{
+    /**
+     * @brief Tunes the handcrafted evaluation with a file of positions and game results, e.g.
+     *        ./texel-tuning quiet-labeled.epd --epochs 1000 --threads 8 --output EvaluationParameters.h
+     * @return exit code
+     */
+    int runTuning(int argc, char *argv[])
+    {
+        TexelTuner::Settings settings;
+        settings.numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        std::string outputPath = "EvaluationParameters.h";
+
+        for (int argIndex = 2; argIndex < argc; ++argIndex)
+        {
+            const std::string_view argument = argv[argIndex];
+
+            if (argument == "--no-quiescence")
+            {
+                settings.resolveQuiescence = false;
+            }
+            else if (argIndex + 1 >= argc)
+            {
+                std::cout << "Missing value of option " << argument << std::endl;
+                return 2;
+            }
+            else if (argument == "--epochs")
+            {
+                settings.numberOfEpochs = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else if (argument == "--learning-rate")
+            {
+                settings.learningRate = std::stod(argv[++argIndex]);
+            }
+            else if (argument == "--threads")
+            {
+                settings.numberOfThreads = uint32_t(std::stoul(argv[++argIndex]));
+            }
+            else if (argument == "--output")
+            {
+                outputPath = argv[++argIndex];
+            }
+            else
+            {
+                std::cout << "Unknown option " << argument << std::endl;
+                return 2;
+            }
+        }
+
+        std::ifstream positionsFile(argv[1]);
+
+        if (not positionsFile)
+        {
+            std::cout << "Could not open " << argv[1] << std::endl;
+            return 2;
+        }
+
+        TexelTuner tuner(settings);
+        tuner.loadPositions(positionsFile);
+        std::cout << "Loaded " << tuner.numberOfPositions() << " positions, skipped "
+                  << tuner.numberOfSkippedLines() << " lines" << std::endl;
+
+        const TexelParameters parameters = tuner.tune(TexelParameters::fromEvaluation(), std::cout);
+
+        std::ofstream outputFile(outputPath);
+
+        if (not outputFile)
+        {
+            std::cout << "Could not write " << outputPath << std::endl;
+            return 2;
+        }
+
+        parameters.writeHeader(outputFile);
+        std::cout << "Wrote " << outputPath << std::endl;
+
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        std::cout << "Pass a file with lines like \"<FEN> [0.5]\", \"<FEN> [1-0]\" or \"<FEN> c9 \\\"0-1\\\";\" as argument." << std::endl;
+        std::cout << "The tuned parameters replace ModernChessLib/include/ModernChess/EvaluationParameters.h. Example:" << std::endl;
+        std::cout << "./texel-tuning positions.epd [--epochs 500] [--learning-rate 1.0] [--threads 8] [--no-quiescence] [--output EvaluationParameters.h]" << std::endl;
+        return 0;
+    }
+
+    try
+    {
+        return runTuning(argc, argv);
+    }
+    catch (const std::exception &ex)
+    {
+        std::cout << ex.what() << std::endl;
+        return 2;
+    }
+}
\ No newline at end of file
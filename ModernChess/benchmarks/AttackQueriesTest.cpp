@@ -0,0 +1,61 @@
+#include "BenchmarkPositions.h"
+
+#include "ModernChess/AttackQueries.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace ModernChess;
+
+namespace {
+
+    void SquareIsAttacked(benchmark::State &state)
+    {
+        const std::vector<GameState> gameStates = BenchmarkPositions::gameStates();
+
+        for (auto _: state)
+        {
+            for (const GameState &gameState : gameStates)
+            {
+                for (Square square = Square::a1; square <= Square::h8; ++square)
+                {
+                    const bool attackedByWhite = AttackQueries::squareIsAttackedByWhite(gameState.board, square);
+                    const bool attackedByBlack = AttackQueries::squareIsAttackedByBlack(gameState.board, square);
+                    benchmark::DoNotOptimize(attackedByWhite);
+                    benchmark::DoNotOptimize(attackedByBlack);
+                }
+            }
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(gameStates.size()) * 64 * 2);
+    }
+    BENCHMARK(SquareIsAttacked);
+
+    template<typename SliderAttacks>
+    void SliderGetAttacks(benchmark::State &state, const SliderAttacks &sliderAttacks)
+    {
+        // sparse occupancies like in real positions
+        std::vector<uint64_t> occupancies = BenchmarkPositions::randomNumbers(1024);
+        const std::vector<uint64_t> sparseBits = BenchmarkPositions::randomNumbers(1024);
+
+        for (size_t index = 0; index < occupancies.size(); ++index)
+        {
+            occupancies[index] &= sparseBits[index];
+        }
+
+        for (auto _: state)
+        {
+            for (size_t index = 0; index < occupancies.size(); ++index)
+            {
+                const auto square = Square(index % 64);
+                const BitBoardState attacks = sliderAttacks.getAttacks(square, BitBoardState(occupancies[index]));
+                benchmark::DoNotOptimize(attacks);
+            }
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(occupancies.size()));
+    }
+    BENCHMARK_CAPTURE(SliderGetAttacks, Bishop, AttackQueries::bishopAttacks);
+    BENCHMARK_CAPTURE(SliderGetAttacks, Rook, AttackQueries::rookAttacks);
+
+    BENCHMARK_MAIN();
+}
\ No newline at end of file
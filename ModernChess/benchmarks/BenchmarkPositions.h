@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/GameState.h"
+
+#include <array>
+#include <cinttypes>
+#include <random>
+#include <vector>
+
+namespace ModernChess::BenchmarkPositions {
+    // Fixed seed, so the results of different runs are comparable
+    constexpr uint64_t Seed = 0x1234'5678'9abc'def0ULL;
+
+    // Opening, middle game and end game positions. Mostly from https://www.chessprogramming.org/Perft_Results
+    constexpr std::array Positions {
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+            "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+            "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+            "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+            "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R b KQ - 3 8",
+            "2r3k1/5pp1/1p2p2p/p2pP3/P2P1P2/1P4P1/5K1P/2R5 w - - 0 32",
+            "8/8/4k3/8/2p5/8/B2K4/8 w - - 0 1",
+            "6k1/5ppp/8/8/8/8/5PPP/3R2K1 b - - 0 1"
+    };
+
+    inline std::vector<GameState> gameStates()
+    {
+        std::vector<GameState> gameStates;
+
+        for (const auto fen : Positions)
+        {
+            gameStates.push_back(FenParsing::FenParser(fen).parse());
+        }
+
+        return gameStates;
+    }
+
+    /**
+     * @return always the same sequence of random numbers
+     */
+    inline std::vector<uint64_t> randomNumbers(size_t count)
+    {
+        std::mt19937_64 generator(Seed);
+        std::vector<uint64_t> numbers(count);
+
+        for (uint64_t &number : numbers)
+        {
+            number = generator();
+        }
+
+        return numbers;
+    }
+}
\ No newline at end of file
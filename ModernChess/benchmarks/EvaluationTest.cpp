@@ -0,0 +1,46 @@
+#include "BenchmarkPositions.h"
+
+#include "ModernChess/Evaluation.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace ModernChess;
+
+namespace {
+
+    class ExtendedEvaluation : public Evaluation
+    {
+    public:
+        explicit ExtendedEvaluation(SearchContext &searchContext, GameState gameState) :
+                Evaluation(searchContext, gameState)
+        {}
+
+        using ModernChess::Evaluation::evaluatePosition;
+    };
+
+    void EvaluatePosition(benchmark::State &state)
+    {
+        // Only the static evaluation is measured, so all evaluations share one context
+        SearchContext searchContext;
+        std::vector<ExtendedEvaluation> evaluations;
+
+        for (const GameState &gameState : BenchmarkPositions::gameStates())
+        {
+            evaluations.emplace_back(searchContext, gameState);
+        }
+
+        for (auto _: state)
+        {
+            for (const ExtendedEvaluation &evaluation : evaluations)
+            {
+                const int32_t score = evaluation.evaluatePosition();
+                benchmark::DoNotOptimize(score);
+            }
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(evaluations.size()));
+    }
+    BENCHMARK(EvaluatePosition);
+
+    BENCHMARK_MAIN();
+}
\ No newline at end of file
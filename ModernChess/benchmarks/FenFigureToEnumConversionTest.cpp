@@ -9,8 +9,8 @@ using namespace ModernChess;
 
 namespace {
 
-    std::random_device dev;
-    std::mt19937 rng(dev());
+    // Fixed seed, so the results of different runs are comparable
+    std::mt19937 rng(42);
     std::uniform_int_distribution<std::mt19937::result_type> dist(0,11);
 
     int getRandomNumber()
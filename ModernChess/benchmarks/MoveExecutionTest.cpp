@@ -0,0 +1,49 @@
+#include "BenchmarkPositions.h"
+
+#include "ModernChess/MoveExecution.h"
+#include "ModernChess/PseudoMoveGeneration.h"
+
+#include <benchmark/benchmark.h>
+
+#include <utility>
+
+using namespace ModernChess;
+
+namespace {
+
+    // Executes all pseudo legal moves of the positions. The moves are taken back by restoring a copy of the game state.
+    void ExecuteMoveAndTakeBack(benchmark::State &state)
+    {
+        std::vector<std::pair<GameState, std::vector<Move>>> positions;
+
+        for (const GameState &gameState : BenchmarkPositions::gameStates())
+        {
+            positions.emplace_back(gameState, PseudoMoveGeneration::generateMoves(gameState));
+        }
+
+        int64_t numberOfMoves = 0;
+
+        for (auto _: state)
+        {
+            for (auto &[gameState, moves] : positions)
+            {
+                for (const Move move : moves)
+                {
+                    const GameState gameStateCopy = gameState;
+
+                    const bool moveIsLegal = MoveExecution::executeMove(gameState, move, MoveType::AllMoves);
+                    benchmark::DoNotOptimize(moveIsLegal);
+
+                    gameState = gameStateCopy;
+                }
+
+                numberOfMoves += int64_t(moves.size());
+            }
+        }
+
+        state.SetItemsProcessed(numberOfMoves);
+    }
+    BENCHMARK(ExecuteMoveAndTakeBack);
+
+    BENCHMARK_MAIN();
+}
\ No newline at end of file
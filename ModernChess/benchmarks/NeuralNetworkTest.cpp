@@ -0,0 +1,94 @@
+#include "BenchmarkPositions.h"
+
+#include "ModernChess/Evaluation.h"
+#include "ModernChess/NeuralNetwork.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace ModernChess;
+
+namespace {
+
+    class ExtendedEvaluation : public Evaluation
+    {
+    public:
+        explicit ExtendedEvaluation(SearchContext &searchContext, GameState gameState) :
+                Evaluation(searchContext, gameState)
+        {}
+
+        using ModernChess::Evaluation::evaluatePosition;
+    };
+
+    // Counterpart of EvaluatePosition: the output layer of the network for an up-to-date accumulator
+    void EvaluatePositionWithNeuralNetwork(benchmark::State &state)
+    {
+        SearchContext searchContext(1);
+        searchContext.setNeuralNetwork(NeuralNetwork::defaultNetwork());
+        std::vector<std::unique_ptr<ExtendedEvaluation>> evaluations;
+
+        for (const GameState &gameState : BenchmarkPositions::gameStates())
+        {
+            evaluations.push_back(std::make_unique<ExtendedEvaluation>(searchContext, gameState));
+        }
+
+        for (auto _: state)
+        {
+            for (const std::unique_ptr<ExtendedEvaluation> &evaluation : evaluations)
+            {
+                const int32_t score = evaluation->evaluatePosition();
+                benchmark::DoNotOptimize(score);
+            }
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(evaluations.size()));
+    }
+    BENCHMARK(EvaluatePositionWithNeuralNetwork);
+
+    // A quiet move updates the accumulator twice: the figure is removed from one square and added to another one
+    void UpdateAccumulator(benchmark::State &state)
+    {
+        const GameState gameState = BenchmarkPositions::gameStates().front();
+        Accumulator accumulator;
+        NeuralNetwork::defaultNetwork()->refresh(accumulator, gameState.board);
+
+        for (auto _: state)
+        {
+            accumulator.removeFigure(Figure::WhiteKnight, Square::g1);
+            accumulator.addFigure(Figure::WhiteKnight, Square::f3);
+            accumulator.removeFigure(Figure::WhiteKnight, Square::f3);
+            accumulator.addFigure(Figure::WhiteKnight, Square::g1);
+            benchmark::DoNotOptimize(accumulator.values);
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * 2);
+    }
+    BENCHMARK(UpdateAccumulator);
+
+    // Nodes per second of the search with the handcrafted evaluation (0) and the neural network (1).
+    // The default network evaluates like the handcrafted evaluation, so both search the same tree.
+    void SearchNodesPerSecond(benchmark::State &state)
+    {
+        constexpr uint8_t Depth = 5;
+        SearchContext searchContext(16);
+
+        if (state.range(0) != 0)
+        {
+            searchContext.setNeuralNetwork(NeuralNetwork::defaultNetwork());
+        }
+
+        const std::vector<GameState> gameStates = BenchmarkPositions::gameStates();
+        uint64_t numberOfNodes = 0;
+
+        for (auto _: state)
+        {
+            for (const GameState &gameState : gameStates)
+            {
+                searchContext.clear();
+                numberOfNodes += Evaluation(searchContext, gameState).getBestMove(Depth).numberOfNodes;
+            }
+        }
+
+        state.SetItemsProcessed(int64_t(numberOfNodes));
+    }
+    BENCHMARK(SearchNodesPerSecond)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "BenchmarkPositions.h"
+
+#include "ModernChess/PseudoMoveGeneration.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace ModernChess;
+
+namespace {
+
+    void GenerateMoves(benchmark::State &state)
+    {
+        const std::vector<GameState> gameStates = BenchmarkPositions::gameStates();
+
+        for (auto _: state)
+        {
+            for (const GameState &gameState : gameStates)
+            {
+                const std::vector<Move> moves = PseudoMoveGeneration::generateMoves(gameState);
+                benchmark::DoNotOptimize(moves.data());
+            }
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(gameStates.size()));
+    }
+    BENCHMARK(GenerateMoves);
+
+    BENCHMARK_MAIN();
+}
\ No newline at end of file
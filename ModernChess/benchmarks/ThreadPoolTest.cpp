@@ -0,0 +1,78 @@
+#include "ModernChess/ThreadPool.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace ModernChess;
+
+namespace {
+
+    constexpr size_t NumberOfTasks = 1024;
+
+    // Overhead of spawning and joining empty tasks from a thread outside of the pool.
+    // The argument is the number of workers.
+    void ThreadPoolSpawnAndJoin(benchmark::State &state)
+    {
+        ThreadPool threadPool(uint32_t(state.range(0)));
+
+        for (auto _: state)
+        {
+            TaskGroup taskGroup(threadPool);
+
+            for (size_t taskIndex = 0; taskIndex < NumberOfTasks; ++taskIndex)
+            {
+                taskGroup.run([] {});
+            }
+
+            taskGroup.wait();
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(NumberOfTasks));
+    }
+    BENCHMARK(ThreadPoolSpawnAndJoin)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+    // Every index is its own task, so this measures splitting and stealing of almost empty ranges
+    void ThreadPoolParallelFor(benchmark::State &state)
+    {
+        ThreadPool threadPool(uint32_t(state.range(0)));
+        std::vector<uint64_t> values(NumberOfTasks);
+
+        for (auto _: state)
+        {
+            threadPool.parallelFor(0, values.size(), [&](size_t index) { values[index] += index; });
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(NumberOfTasks));
+    }
+    BENCHMARK(ThreadPoolParallelFor)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+    void spawnTree(ThreadPool &threadPool, uint32_t depth)
+    {
+        if (depth == 0)
+        {
+            return;
+        }
+
+        TaskGroup taskGroup(threadPool);
+        taskGroup.run([&threadPool, depth] { spawnTree(threadPool, depth - 1); });
+        spawnTree(threadPool, depth - 1);
+        taskGroup.wait();
+    }
+
+    // Recursive fork-join like perft: All tasks are spawned by workers, the others have to steal them
+    void ThreadPoolSteal(benchmark::State &state)
+    {
+        constexpr uint32_t Depth = 10;
+        ThreadPool threadPool(uint32_t(state.range(0)));
+
+        for (auto _: state)
+        {
+            TaskGroup taskGroup(threadPool);
+            taskGroup.run([&threadPool] { spawnTree(threadPool, Depth); });
+            taskGroup.wait();
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(1u << Depth));
+    }
+    BENCHMARK(ThreadPoolSteal)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+}
\ No newline at end of file
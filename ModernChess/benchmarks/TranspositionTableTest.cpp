@@ -0,0 +1,61 @@
+#include "BenchmarkPositions.h"
+
+#include "ModernChess/TranspositionTable.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace ModernChess;
+
+namespace {
+
+    constexpr size_t NumberOfHashes = 1 << 16;
+
+    // The argument is the size of the table in MB. Large tables don't fit into the caches.
+    void TranspositionTableStore(benchmark::State &state)
+    {
+        TranspositionTable transpositionTable;
+        transpositionTable.resize(size_t(state.range(0)));
+
+        const std::vector<uint64_t> hashes = BenchmarkPositions::randomNumbers(NumberOfHashes);
+
+        for (auto _: state)
+        {
+            for (const uint64_t hash : hashes)
+            {
+                transpositionTable.addEntry(hash, HashFlag::Exact, int32_t(hash & 0xff), uint8_t(hash >> 60));
+            }
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(hashes.size()));
+    }
+    BENCHMARK(TranspositionTableStore)->Arg(1)->Arg(16)->Arg(256);
+
+    // Half of the probes are hits
+    void TranspositionTableProbe(benchmark::State &state)
+    {
+        TranspositionTable transpositionTable;
+        transpositionTable.resize(size_t(state.range(0)));
+
+        const std::vector<uint64_t> hashes = BenchmarkPositions::randomNumbers(NumberOfHashes);
+
+        for (size_t index = 0; index < hashes.size(); index += 2)
+        {
+            transpositionTable.addEntry(hashes[index], HashFlag::Exact, int32_t(index), 8);
+        }
+
+        for (auto _: state)
+        {
+            for (const uint64_t hash : hashes)
+            {
+                const int32_t score = transpositionTable.getScore(hash, -1000, 1000, 4);
+                benchmark::DoNotOptimize(score);
+            }
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(hashes.size()));
+    }
+    BENCHMARK(TranspositionTableProbe)->Arg(1)->Arg(16)->Arg(256);
+
+    BENCHMARK_MAIN();
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "BenchmarkPositions.h"
+
+#include "ModernChess/ZobristHasher.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace ModernChess;
+
+namespace {
+
+    void GenerateHash(benchmark::State &state)
+    {
+        const std::vector<GameState> gameStates = BenchmarkPositions::gameStates();
+
+        for (auto _: state)
+        {
+            for (const GameState &gameState : gameStates)
+            {
+                const uint64_t hash = ZobristHasher::generateHash(gameState.board);
+                benchmark::DoNotOptimize(hash);
+            }
+        }
+
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(gameStates.size()));
+    }
+    BENCHMARK(GenerateHash);
+
+    BENCHMARK_MAIN();
+}
\ No newline at end of file
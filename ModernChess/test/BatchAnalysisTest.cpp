@@ -0,0 +1,123 @@
+#include "TestingPositions.h"
+#include "ModernChess/BatchAnalysis.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace ModernChess;
+
+namespace
+{
+    std::vector<std::string> lines(const std::string &text)
+    {
+        std::vector<std::string> result;
+        std::istringstream stream(text);
+
+        for (std::string line; std::getline(stream, line);)
+        {
+            result.push_back(line);
+        }
+
+        return result;
+    }
+
+    TEST(BatchAnalysisTest, ParseFenAndEpdLines)
+    {
+        const BatchAnalysisPosition fen = BatchAnalysisPosition::fromLine(TestingPositions::Position3, 0, 1);
+        EXPECT_EQ(fen.fen, TestingPositions::Position3);
+        EXPECT_EQ(fen.id, "1");
+
+        const BatchAnalysisPosition epd = BatchAnalysisPosition::fromLine(
+                "2rr3k/pp3pp1/1nnqbN1p/3pN3/2pP4/2P3Q1/PPB4P/R4RK1 w - - bm Qg6; id \"WAC.001\";", 3, 7);
+        EXPECT_EQ(epd.fen, "2rr3k/pp3pp1/1nnqbN1p/3pN3/2pP4/2P3Q1/PPB4P/R4RK1 w - - 0 1");
+        EXPECT_EQ(epd.id, "WAC.001");
+        EXPECT_EQ(epd.index, 3);
+
+        EXPECT_THROW(static_cast<void>(BatchAnalysisPosition::fromLine("8/8/8 w", 0, 1)), std::runtime_error);
+    }
+
+    TEST(BatchAnalysisTest, ResultsAreWrittenInInputOrder)
+    {
+        const std::string input = std::string("# comment\n") +
+                                  TestingPositions::Position2 + "\n" +
+                                  "\n" +
+                                  "6k1/5ppp/8/8/8/8/5PPP/R5K1 w - - id \"mate\";\n" +
+                                  "invalid\n" +
+                                  TestingPositions::Position4 + "\n";
+
+        BatchAnalysisLimits limits;
+        limits.depth = 4;
+
+        BatchAnalysis batchAnalysis(3, 1);
+        batchAnalysis.setLimits(limits);
+
+        std::istringstream inputStream(input);
+        std::ostringstream outputStream;
+        const BatchAnalysisSummary summary = batchAnalysis.run(inputStream, outputStream);
+
+        EXPECT_EQ(summary.numberOfPositions, 4);
+        EXPECT_EQ(summary.numberOfErrors, 1);
+        EXPECT_GT(summary.numberOfNodes, 0);
+
+        const std::vector<std::string> results = lines(outputStream.str());
+        ASSERT_EQ(results.size(), 4);
+
+        EXPECT_TRUE(results[0].starts_with("id 2 bestmove ")) << results[0];
+        EXPECT_TRUE(results[1].starts_with("id mate bestmove a1a8 ")) << results[1];
+        EXPECT_TRUE(results[2].starts_with("id 5 error ")) << results[2];
+        EXPECT_TRUE(results[3].starts_with("id 6 bestmove ")) << results[3];
+        EXPECT_NE(results[3].find(" depth 4 "), std::string::npos) << results[3];
+    }
+
+    TEST(BatchAnalysisTest, ResultsDoNotDependOnNumberOfThreads)
+    {
+        const std::string input = std::string(TestingPositions::Position2) + "\n" +
+                                  TestingPositions::Position3 + "\n" +
+                                  TestingPositions::Position4 + "\n" +
+                                  TestingPositions::Position5 + "\n" +
+                                  TestingPositions::Position6 + "\n";
+
+        BatchAnalysisLimits limits;
+        limits.depth = 4;
+
+        const auto analyze = [&input, &limits](uint32_t numberOfThreads) {
+            BatchAnalysis batchAnalysis(numberOfThreads, 1);
+            batchAnalysis.setLimits(limits);
+
+            std::istringstream inputStream(input);
+            std::ostringstream outputStream;
+            static_cast<void>(batchAnalysis.run(inputStream, outputStream));
+
+            // The time differs from run to run
+            std::vector<std::string> results = lines(outputStream.str());
+            for (std::string &result : results)
+            {
+                const size_t time = result.find(" time ");
+                result.erase(time, result.find(" pv") - time);
+            }
+
+            return results;
+        };
+
+        EXPECT_EQ(analyze(1), analyze(4));
+    }
+
+    TEST(BatchAnalysisTest, NodeLimitStopsTheSearch)
+    {
+        BatchAnalysisLimits limits;
+        limits.depth = 30;
+        limits.nodes = 20'000;
+
+        BatchAnalysis batchAnalysis(1, 1);
+        batchAnalysis.setLimits(limits);
+
+        std::istringstream inputStream(TestingPositions::Position2);
+        std::ostringstream outputStream;
+        const BatchAnalysisSummary summary = batchAnalysis.run(inputStream, outputStream);
+
+        EXPECT_EQ(summary.numberOfPositions, 1);
+        EXPECT_LT(summary.numberOfNodes, 21'000);
+        EXPECT_NE(outputStream.str().find(" bestmove "), std::string::npos);
+    }
+}
\ No newline at end of file
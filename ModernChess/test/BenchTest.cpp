@@ -0,0 +1,25 @@
+#include "ModernChess/Bench.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace
+{
+    using namespace ModernChess;
+
+    TEST(BenchTest, NodeSignatureIsDeterministic)
+    {
+        std::ostringstream firstOutput;
+        const BenchResult firstResult = Bench::run(firstOutput, 3);
+
+        std::ostringstream secondOutput;
+        const BenchResult secondResult = Bench::run(secondOutput, 3);
+
+        EXPECT_GT(firstResult.numberOfNodes, Bench::Positions.size());
+        EXPECT_EQ(firstResult.numberOfNodes, secondResult.numberOfNodes);
+        // Changes of the search have to update the signature, see "modern-chess bench 3"
+        EXPECT_EQ(firstResult.numberOfNodes, 51837);
+        EXPECT_NE(firstOutput.str().find("Nodes searched  : " + std::to_string(firstResult.numberOfNodes)), std::string::npos);
+    }
+}
\ No newline at end of file
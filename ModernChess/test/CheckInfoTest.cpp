@@ -0,0 +1,125 @@
+#include "TestingPositions.h"
+
+#include "ModernChess/CheckInfo.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/MoveExecution.h"
+#include "ModernChess/PseudoMoveGeneration.h"
+
+#include <gtest/gtest.h>
+
+using namespace ModernChess;
+
+namespace
+{
+    bool opponentIsInCheck(const GameState &gameState)
+    {
+        // The side to move has already been switched to the opponent
+        const CheckInfo checkInfo(gameState.board);
+        return checkInfo.kingIsInCheck();
+    }
+
+    /**
+     * @brief Compares the predictions of CheckInfo with the result of actually executing every move
+     * @return number of compared moves
+     */
+    uint64_t verifyCheckInfo(const GameState &gameState, uint32_t depth)
+    {
+        if (depth == 0)
+        {
+            return 0;
+        }
+
+        const CheckInfo checkInfo(gameState.board);
+        uint64_t numberOfMoves = 0;
+
+        for (const Move move : PseudoMoveGeneration::generateMoves(gameState))
+        {
+            GameState nextGameState = gameState;
+
+            if (not MoveExecution::executeMove(nextGameState, move, MoveType::AllMoves))
+            {
+                EXPECT_FALSE(checkInfo.moveIsKnownToBeLegal(move)) << move;
+                continue;
+            }
+
+            EXPECT_EQ(checkInfo.givesCheck(move), opponentIsInCheck(nextGameState)) << gameState << move;
+
+            numberOfMoves += 1 + verifyCheckInfo(nextGameState, depth - 1);
+        }
+
+        return numberOfMoves;
+    }
+
+    TEST(CheckInfoTest, CheckersOfKnightCheck)
+    {
+        /*
+         * 8 . . . . ♔ . . .
+         * 7 . . . . . . . .
+         * 6 . . . ♞ . . . .
+         * 5 . . . . . . . .
+         * 4 . . . . . . . .
+         * 3 . . . . . . . .
+         * 2 . . . . . . . .
+         * 1 . . . . ♚ . . .
+         *
+         *   a b c d e f g h
+         */
+        FenParsing::FenParser fenParser("4k3/8/3N4/8/8/8/8/4K3 b - - 0 1");
+        const GameState gameState = fenParser.parse();
+
+        const CheckInfo checkInfo(gameState.board);
+
+        EXPECT_TRUE(checkInfo.kingIsInCheck());
+        EXPECT_EQ(checkInfo.checkers, BitBoardOperations::occupySquare(BoardState::empty, Square::d6));
+    }
+
+    TEST(CheckInfoTest, PinnedAndDiscoveredCheckCandidates)
+    {
+        /*
+         * 8 . . . . ♔ . . .
+         * 7 . . . . ♗ . . .
+         * 6 . . . . . . . .
+         * 5 . . . . . . . .
+         * 4 . ♗ . . . . . .
+         * 3 . . . . . . . .
+         * 2 . . . ♞ . . . .
+         * 1 . . . . ♚ . . ♛
+         *
+         *   a b c d e f g h
+         */
+        FenParsing::FenParser fenParser("4k3/4b3/8/8/1b6/8/3N4/4K2Q w - - 0 1");
+        const GameState gameState = fenParser.parse();
+
+        const CheckInfo checkInfo(gameState.board);
+
+        EXPECT_FALSE(checkInfo.kingIsInCheck());
+        EXPECT_EQ(checkInfo.pinned, BitBoardOperations::occupySquare(BoardState::empty, Square::d2));
+        EXPECT_EQ(checkInfo.discoveredCheckCandidates, BoardState::empty);
+
+        // knight is pinned, hence the king safety check is still required
+        const Move pinnedKnightMove(Square::d2, Square::f3, Figure::WhiteKnight, Figure::None, false, false, false, false);
+        EXPECT_FALSE(checkInfo.moveIsKnownToBeLegal(pinnedKnightMove));
+
+        // Qh5+ gives check, Qh3 does not
+        const Move queenCheck(Square::h1, Square::h5, Figure::WhiteQueen, Figure::None, false, false, false, false);
+        const Move queenMove(Square::h1, Square::h3, Figure::WhiteQueen, Figure::None, false, false, false, false);
+        EXPECT_TRUE(checkInfo.givesCheck(queenCheck));
+        EXPECT_FALSE(checkInfo.givesCheck(queenMove));
+        EXPECT_TRUE(checkInfo.moveIsKnownToBeLegal(queenMove));
+    }
+
+    TEST(CheckInfoTest, GivesCheckMatchesMoveExecution)
+    {
+        for (const auto fen : {TestingPositions::Position2,
+                               TestingPositions::Position3,
+                               TestingPositions::Position4,
+                               TestingPositions::Position5,
+                               TestingPositions::Position6})
+        {
+            FenParsing::FenParser fenParser(fen);
+            const GameState gameState = fenParser.parse();
+
+            EXPECT_GT(verifyCheckInfo(gameState, 3), 0) << fen;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "ModernChess/EngineServer.h"
+#include "ModernChess/LocalSocket.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unistd.h>
+
+using namespace ModernChess;
+
+namespace
+{
+    class TestClient
+    {
+    public:
+        explicit TestClient(std::string_view address) :
+                m_socket(LocalSocket::connectTo(address)),
+                m_inputBuffer(m_socket),
+                m_outputBuffer(m_socket),
+                m_inputStream(&m_inputBuffer),
+                m_outputStream(&m_outputBuffer)
+        {}
+
+        ~TestClient()
+        {
+            LocalSocket::closeSocket(m_socket);
+        }
+
+        void send(std::string_view command)
+        {
+            m_outputStream << command << std::endl;
+        }
+
+        /**
+         * @return all lines up to the first line beginning with the prefix or up to the end of the connection
+         */
+        std::string readUntil(std::string_view prefix)
+        {
+            std::string lines;
+
+            for (std::string line; std::getline(m_inputStream, line);)
+            {
+                lines += line + "\n";
+
+                if (line.starts_with(prefix))
+                {
+                    break;
+                }
+            }
+
+            return lines;
+        }
+
+    private:
+        int m_socket;
+        LocalSocket::SocketStreamBuffer m_inputBuffer;
+        LocalSocket::SocketStreamBuffer m_outputBuffer;
+        std::istream m_inputStream;
+        std::ostream m_outputStream;
+    };
+
+    std::string temporarySocketPath()
+    {
+        return "/tmp/modern-chess-test-" + std::to_string(::getpid()) + ".sock";
+    }
+
+    TEST(EngineServerTest, TcpAndUnixAddresses)
+    {
+        EXPECT_TRUE(LocalSocket::isTcpAddress("5000"));
+        EXPECT_TRUE(LocalSocket::isTcpAddress("localhost:5000"));
+        EXPECT_FALSE(LocalSocket::isTcpAddress("/tmp/modern-chess.sock"));
+        EXPECT_FALSE(LocalSocket::isTcpAddress("modern-chess.sock"));
+    }
+
+    TEST(EngineServerTest, SessionsSearchInParallel)
+    {
+        const std::string address = temporarySocketPath();
+        EngineServer engineServer(address, 8, 2);
+        engineServer.start();
+
+        EXPECT_EQ(engineServer.hashSizePerSessionInMB(), 4);
+
+        TestClient firstClient(address);
+        TestClient secondClient(address);
+
+        firstClient.send("uci");
+        secondClient.send("uci");
+
+        // Every session gets a slice of the hash budget
+        const std::string uciAnswer = firstClient.readUntil("uciok");
+        EXPECT_NE(uciAnswer.find("option name Hash type spin default 4 min 1 max 4"), std::string::npos);
+        EXPECT_NE(secondClient.readUntil("uciok").find("uciok"), std::string::npos);
+
+        EXPECT_EQ(engineServer.numberOfSessions(), 2);
+
+        firstClient.send("position startpos moves e2e4");
+        firstClient.send("go depth 4");
+        secondClient.send("position startpos");
+        secondClient.send("go depth 4");
+
+        EXPECT_NE(firstClient.readUntil("bestmove").find("bestmove"), std::string::npos);
+        EXPECT_NE(secondClient.readUntil("bestmove").find("bestmove"), std::string::npos);
+
+        // The server closes the connection after "quit"
+        firstClient.send("quit");
+        EXPECT_EQ(firstClient.readUntil("bestmove"), "");
+    }
+
+    TEST(EngineServerTest, ConnectionsBeyondTheMaximumAreRejected)
+    {
+        const std::string address = temporarySocketPath();
+        EngineServer engineServer(address, 8, 1);
+        engineServer.start();
+
+        TestClient firstClient(address);
+        firstClient.send("isready");
+        EXPECT_NE(firstClient.readUntil("readyok").find("readyok"), std::string::npos);
+
+        TestClient secondClient(address);
+        EXPECT_NE(secondClient.readUntil("info string").find("busy"), std::string::npos);
+
+        // Closing the connection ends the session
+        engineServer.stop();
+        EXPECT_EQ(firstClient.readUntil("readyok"), "");
+        EXPECT_EQ(engineServer.numberOfSessions(), 0);
+    }
+
+    TEST(EngineServerTest, OnlyStaleSocketFilesAreReplaced)
+    {
+        const std::string address = temporarySocketPath();
+
+        {
+            std::ofstream regularFile(address);
+            regularFile << "no socket";
+        }
+
+        EXPECT_THROW(LocalSocket::closeSocket(LocalSocket::listenOn(address, 1)), std::runtime_error);
+        EXPECT_EQ(::access(address.c_str(), F_OK), 0);
+        ::unlink(address.c_str());
+
+        // A running server keeps its socket
+        const int listeningSocket = LocalSocket::listenOn(address, 1);
+        EXPECT_THROW(LocalSocket::closeSocket(LocalSocket::listenOn(address, 1)), std::runtime_error);
+        LocalSocket::closeSocket(listeningSocket);
+
+        // The socket file of a server, which is not running anymore, is replaced
+        const int newListeningSocket = LocalSocket::listenOn(address, 1);
+        LocalSocket::closeSocket(newListeningSocket);
+        ::unlink(address.c_str());
+
+        EXPECT_THROW(LocalSocket::closeSocket(LocalSocket::listenOn("localhost:50x0", 1)), std::runtime_error);
+        EXPECT_THROW(LocalSocket::closeSocket(LocalSocket::listenOn("localhost:99999999999", 1)), std::runtime_error);
+    }
+}
\ No newline at end of file
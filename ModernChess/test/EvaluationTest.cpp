@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 using namespace ModernChess;
 
 namespace
@@ -11,11 +13,14 @@ namespace
     class ExtendedEvaluation : public Evaluation
     {
     public:
-        explicit ExtendedEvaluation(GameState gameState) : Evaluation(gameState) {}
+        explicit ExtendedEvaluation(SearchContext &searchContext, GameState gameState) :
+                Evaluation(searchContext, gameState)
+        {}
 
         using ModernChess::Evaluation::scoreMove;
         using ModernChess::Evaluation::generateSortedMoves;
         using ModernChess::Evaluation::mvvLva;
+        using ModernChess::Evaluation::capturedFigure;
     };
 
     TEST(EvaluationTest, FindMateInOne)
@@ -36,7 +41,8 @@ namespace
         FenParsing::FenParser fenParser(fenString);
         const GameState gameState = fenParser.parse();
 
-        const EvaluationResult evaluationResult = Evaluation(gameState).getBestMove(5);
+        SearchContext searchContext;
+        const EvaluationResult evaluationResult = Evaluation(searchContext, gameState).getBestMove(5);
         const Move move = evaluationResult.bestMove();
 
         EXPECT_EQ(move.getFrom(), Square::b3);
@@ -47,6 +53,159 @@ namespace
         std::cout << evaluationResult;
     }
 
+    TEST(EvaluationTest, MultiPVFindsMateInOneFirst)
+    {
+        constexpr auto fenString = "k7/2pbn3/2nNp3/3p4/N1rP2P1/PQr1P3/1Bq2P1P/4K2R w K - 0 26";
+        FenParsing::FenParser fenParser(fenString);
+        const GameState gameState = fenParser.parse();
+
+        SearchContext searchContext;
+        const std::vector<EvaluationResult> evaluationResults = Evaluation(searchContext, gameState).getBestMoves(4, 3);
+
+        ASSERT_EQ(evaluationResults.size(), 3);
+        EXPECT_EQ(evaluationResults[0].bestMove().getFrom(), Square::b3);
+        EXPECT_EQ(evaluationResults[0].bestMove().getTo(), Square::b7);
+
+        for (size_t index = 0; index < evaluationResults.size(); ++index)
+        {
+            EXPECT_EQ(evaluationResults[index].multiPv, index + 1);
+
+            for (size_t otherIndex = index + 1; otherIndex < evaluationResults.size(); ++otherIndex)
+            {
+                EXPECT_NE(evaluationResults[index].bestMove(), evaluationResults[otherIndex].bestMove());
+                EXPECT_GE(evaluationResults[index].score, evaluationResults[otherIndex].score);
+            }
+
+            std::cout << evaluationResults[index];
+        }
+    }
+
+    TEST(EvaluationTest, MultiPVWithFewerLegalMovesThanLines)
+    {
+        // white king on h1 has only three moves
+        FenParsing::FenParser fenParser("k7/8/8/8/8/8/8/7K w - - 0 1");
+        const GameState gameState = fenParser.parse();
+
+        SearchContext searchContext;
+        const std::vector<EvaluationResult> evaluationResults = Evaluation(searchContext, gameState).getBestMoves(3, 5);
+
+        EXPECT_EQ(evaluationResults.size(), 3);
+    }
+
+    TEST(EvaluationTest, SearchStatisticsAreConsistent)
+    {
+        FenParsing::FenParser fenParser(TestingPositions::Position2);
+        const GameState gameState = fenParser.parse();
+
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
+        EvaluationResult evaluationResult;
+
+        for (uint8_t depth = 1; depth <= 5; ++depth)
+        {
+            evaluationResult = evaluation.getBestMove(depth);
+        }
+
+        const SearchStatistics statistics = evaluation.statistics();
+
+        if constexpr (not SearchStatisticsEnabled)
+        {
+            EXPECT_EQ(statistics.transpositionTableProbes, 0);
+            return;
+        }
+
+        EXPECT_EQ(statistics.mainNodes + statistics.quiescenceNodes, evaluationResult.numberOfNodes);
+        EXPECT_EQ(statistics.quiescenceNodes, evaluationResult.numberOfQuiescenceNodes);
+        EXPECT_EQ(std::accumulate(statistics.nodesPerDepth.begin(), statistics.nodesPerDepth.end(), uint64_t(0)),
+                  evaluationResult.numberOfNodes);
+        EXPECT_EQ(statistics.nodesPerDepth.size(), 6);
+
+        EXPECT_GT(statistics.transpositionTableProbes, 0);
+        EXPECT_LE(statistics.transpositionTableCutoffs, statistics.transpositionTableHits);
+        EXPECT_LE(statistics.transpositionTableHits, statistics.transpositionTableProbes);
+        EXPECT_GT(statistics.betaCutoffs, 0);
+        EXPECT_LE(statistics.firstMoveBetaCutoffs, statistics.betaCutoffs);
+        EXPECT_LE(statistics.nullMoveCutoffs, statistics.nullMoveAttempts);
+        EXPECT_LE(statistics.lateMoveReductionReSearches, statistics.lateMoveReductions);
+
+        statistics.printAsInfoStrings(std::cout);
+    }
+
+    TEST(EvaluationTest, SearchProgressIsPublished)
+    {
+        FenParsing::FenParser fenParser(TestingPositions::Position2);
+        const GameState gameState = fenParser.parse();
+
+        const auto searchProgress = std::make_shared<SearchProgress>();
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
+        evaluation.setSearchProgress(searchProgress);
+
+        const EvaluationResult evaluationResult = evaluation.getBestMove(4);
+
+        EXPECT_EQ(searchProgress->numberOfNodes, evaluationResult.numberOfNodes);
+        EXPECT_FALSE(searchProgress->currentMove.load().isNullMove());
+        EXPECT_GT(searchProgress->currentMoveNumber, 0);
+    }
+
+    TEST(EvaluationTest, NodeLimitStopsSearchDeterministically)
+    {
+        FenParsing::FenParser fenParser(TestingPositions::Position2);
+        const GameState gameState = fenParser.parse();
+        constexpr uint64_t NodeLimit = 5'000;
+
+        SearchContext firstSearchContext;
+        Evaluation firstEvaluation(firstSearchContext, gameState);
+        firstEvaluation.setNodeLimit(NodeLimit);
+        const EvaluationResult firstResult = firstEvaluation.getBestMove(20);
+
+        EXPECT_TRUE(firstEvaluation.nodeLimitReached());
+        // The limit is checked after every move, so the search stops shortly after the limit
+        EXPECT_GE(firstResult.numberOfNodes, NodeLimit);
+        EXPECT_LT(firstResult.numberOfNodes, NodeLimit + 1'000);
+
+        // same conditions for the second search
+        SearchContext secondSearchContext;
+        Evaluation secondEvaluation(secondSearchContext, gameState);
+        secondEvaluation.setNodeLimit(NodeLimit);
+        const EvaluationResult secondResult = secondEvaluation.getBestMove(20);
+
+        EXPECT_EQ(firstResult.numberOfNodes, secondResult.numberOfNodes);
+        EXPECT_EQ(firstResult.bestMove(), secondResult.bestMove());
+    }
+
+    TEST(EvaluationTest, IterativeDeepeningKeepsLastCompletedIteration)
+    {
+        const GameState gameState = FenParsing::FenParser(TestingPositions::Position2).parse();
+
+        SearchContext completeSearchContext;
+        Evaluation completeEvaluation(completeSearchContext, gameState);
+        const IterativeDeepeningResult completeResult = completeEvaluation.searchIteratively(4);
+
+        EXPECT_TRUE(completeResult.completed);
+        EXPECT_EQ(completeResult.depth, 4);
+        ASSERT_FALSE(completeResult.pv.empty());
+        EXPECT_EQ(completeResult.bestMove(), completeResult.pv.front());
+
+        // The node limit interrupts one of the later iterations
+        SearchContext interruptedSearchContext;
+        Evaluation interruptedEvaluation(interruptedSearchContext, gameState);
+        interruptedEvaluation.setNodeLimit(completeResult.numberOfNodes / 2);
+        const IterativeDeepeningResult interruptedResult = interruptedEvaluation.searchIteratively(4);
+
+        EXPECT_FALSE(interruptedResult.completed);
+        EXPECT_LT(interruptedResult.depth, 4);
+        EXPECT_GE(interruptedResult.numberOfNodes, completeResult.numberOfNodes / 2);
+
+        // The next iteration is not started
+        SearchContext stoppedSearchContext;
+        Evaluation stoppedEvaluation(stoppedSearchContext, gameState);
+        const IterativeDeepeningResult stoppedResult = stoppedEvaluation.searchIteratively(4, {.stopBeforeNextIteration = []{ return true; }});
+
+        EXPECT_FALSE(stoppedResult.completed);
+        EXPECT_EQ(stoppedResult.depth, 1);
+    }
+
     TEST(EvaluationTest, mvvLvaWhiteQueenTakesBlackPawn)
     {
         EXPECT_EQ(ExtendedEvaluation::mvvLva[Figure::WhiteQueen][Figure::BlackPawn], 101);
@@ -91,11 +250,49 @@ namespace
         const GameState gameState = fenParser.parse();
 
         const Move move(Square::e5, Square::f6, Figure::WhitePawn, Figure::None, true, false, true, false);
-        ExtendedEvaluation evaluation(gameState);
+        SearchContext searchContext;
+        ExtendedEvaluation evaluation(searchContext, gameState);
 
         EXPECT_EQ(evaluation.scoreMove(move), 100105);
     }
 
+    TEST(EvaluationTest, capturedFigureOfBlackPawnTakesWhiteKnight)
+    {
+        /*
+         * 8 . . . . ♔ . . .
+         * 7 . . . . . . . .
+         * 6 . . . . . . . .
+         * 5 . . . . ♙ . . .
+         * 4 . . . ♘ . . . .
+         * 3 . . . . . . . .
+         * 2 . . . . . . . .
+         * 1 . . . . ♚ . . .
+         *
+         *   a b c d e f g h
+         */
+        constexpr auto fenString = "4k3/8/8/4p3/3N4/8/8/4K3 b - - 0 1";
+        FenParsing::FenParser fenParser(fenString);
+        const GameState gameState = fenParser.parse();
+
+        const Move move(Square::e5, Square::d4, Figure::BlackPawn, Figure::None, true, false, false, false);
+        SearchContext searchContext;
+        ExtendedEvaluation evaluation(searchContext, gameState);
+
+        EXPECT_EQ(evaluation.capturedFigure(move), Figure::WhiteKnight);
+    }
+
+    TEST(EvaluationTest, quiescenceNodesArePartOfAllNodes)
+    {
+        FenParsing::FenParser fenParser(TestingPositions::Position2);
+        const GameState gameState = fenParser.parse();
+
+        SearchContext searchContext;
+        const EvaluationResult evaluationResult = Evaluation(searchContext, gameState).getBestMove(4);
+
+        EXPECT_GT(evaluationResult.numberOfQuiescenceNodes, 0);
+        EXPECT_LT(evaluationResult.numberOfQuiescenceNodes, evaluationResult.numberOfNodes);
+    }
+
     TEST(EvaluationTest, SortMoves)
     {
         /*
@@ -114,7 +311,8 @@ namespace
         FenParsing::FenParser fenParser(fenString);
         const GameState gameState = fenParser.parse();
 
-        ExtendedEvaluation evaluation(gameState);
+        SearchContext searchContext;
+        ExtendedEvaluation evaluation(searchContext, gameState);
         //evaluation.m_historyMoves[Color::White][Figure::WhiteQueen][Square::b8] = 1000;
         const std::vector<Move> moves = evaluation.generateSortedMoves();
 
@@ -147,7 +345,8 @@ namespace
         FenParsing::FenParser fenParser(fenString);
         const GameState gameState = fenParser.parse();
 
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         const EvaluationResult evalResult = evaluation.getBestMove(8);
 
         EXPECT_EQ(evalResult.bestMove().getFrom(), Square::e7);
@@ -177,7 +376,8 @@ namespace
         FenParsing::FenParser fenParser(fenString);
         const GameState gameState = fenParser.parse();
 
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         const EvaluationResult evalResult = evaluation.getBestMove(6);
 
         EXPECT_EQ(evalResult.bestMove().getFrom(), Square::g5);
@@ -206,7 +406,8 @@ namespace
         FenParsing::FenParser fenParser(fenString);
         const GameState gameState = fenParser.parse();
 
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         const EvaluationResult evalResult = evaluation.getBestMove(6);
 
         std::cout << gameState << std::endl;
@@ -233,7 +434,8 @@ namespace
 
         std::cout << gameState << std::endl;
 
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         const EvaluationResult evalResult = evaluation.getBestMove(6);
 
         EXPECT_EQ(evalResult.bestMove().getFrom(), Square::e1);
@@ -263,7 +465,8 @@ namespace
 
         std::cout << gameState << std::endl;
 
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         const EvaluationResult evalResult = evaluation.getBestMove(4);
 
         EXPECT_EQ(evalResult.bestMove().getFrom(), Square::g5);
@@ -293,7 +496,8 @@ namespace
 
         std::cout << gameState << std::endl;
 
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         // depth 8 - 10 fails with f7e6. Depth 11 evaluates the best move again with f7e7
         const EvaluationResult evalResult = evaluation.getBestMove(6);
 
@@ -324,8 +528,9 @@ namespace
 
         std::cout << gameState << std::endl;
 
-        Evaluation evaluation(gameState);
-        const EvaluationResult evalResult = evaluation.getBestMove(7);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
+        const EvaluationResult evalResult = evaluation.getBestMove(8);
 
         EXPECT_EQ(evalResult.bestMove().getFrom(), Square::h3);
         EXPECT_EQ(evalResult.bestMove().getTo(), Square::h4);
@@ -354,7 +559,8 @@ namespace
 
         std::cout << gameState << std::endl;
 
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         const EvaluationResult evalResult = evaluation.getBestMove(13);
 
         EXPECT_EQ(evalResult.bestMove().getFrom(), Square::f4);
@@ -384,7 +590,8 @@ namespace
 
         std::cout << gameState << std::endl;
 
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         const EvaluationResult evalResult = evaluation.getBestMove(2);
 
         const std::shared_ptr<PrincipalVariationTable> pvTable = evalResult.pvTable;
@@ -426,7 +633,8 @@ namespace
 
         // Can't be actually solve by any engine to my knowledge.
         /*
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         const EvaluationResult evalResult = evaluation.getBestMove(9);
 
 
@@ -453,7 +661,8 @@ namespace
 
         std::cout << gameState << std::endl;
 
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         const EvaluationResult evalResult = evaluation.getBestMove(8);
 
         EXPECT_EQ(evalResult.bestMove().getFrom(), Square::b5);
@@ -483,7 +692,8 @@ namespace
 
         std::cout << gameState << std::endl;
 
-        Evaluation evaluation(gameState);
+        SearchContext searchContext;
+        Evaluation evaluation(searchContext, gameState);
         const EvaluationResult evalResult = evaluation.getBestMove(10);
 
         EXPECT_EQ(evalResult.bestMove().getFrom(), Square::c2);
@@ -0,0 +1,51 @@
+#include "ModernChess/HistoryTables.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace ModernChess;
+
+namespace
+{
+    TEST(HistoryTablesTest, bonusIncreasesEntry)
+    {
+        int16_t entry = 0;
+        HistoryTables::update(entry, 100);
+
+        EXPECT_EQ(entry, 100);
+
+        HistoryTables::update(entry, -300);
+
+        EXPECT_LT(entry, 0);
+    }
+
+    TEST(HistoryTablesTest, gravityKeepsEntriesBounded)
+    {
+        int16_t goodMove = 0;
+        int16_t badMove = 0;
+
+        for (int i = 0; i < 10'000; ++i)
+        {
+            HistoryTables::update(goodMove, 400);
+            HistoryTables::update(badMove, -400);
+        }
+
+        EXPECT_LE(goodMove, HistoryTables::MaxHistoryScore);
+        EXPECT_GT(goodMove, HistoryTables::MaxHistoryScore / 2);
+        EXPECT_GE(badMove, -HistoryTables::MaxHistoryScore);
+        EXPECT_LT(badMove, -HistoryTables::MaxHistoryScore / 2);
+    }
+
+    TEST(HistoryTablesTest, hugeBonusIsClamped)
+    {
+        int16_t entry = 0;
+        HistoryTables::update(entry, std::numeric_limits<int32_t>::max() / 2);
+
+        EXPECT_EQ(entry, HistoryTables::MaxHistoryScore);
+
+        HistoryTables::update(entry, std::numeric_limits<int32_t>::max() / 2);
+
+        EXPECT_EQ(entry, HistoryTables::MaxHistoryScore);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/Match.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace ModernChess;
+
+namespace
+{
+    TEST(MatchTest, EloAndLikelihoodOfSuperiority)
+    {
+        const MatchResult evenResult{.wins = 10, .losses = 10, .draws = 20};
+        EXPECT_DOUBLE_EQ(evenResult.score(), 0.5);
+        EXPECT_NEAR(evenResult.eloDifference(), 0.0, 1e-9);
+        EXPECT_DOUBLE_EQ(evenResult.likelihoodOfSuperiority(), 0.5);
+        EXPECT_GT(evenResult.eloErrorMargin(), 0.0);
+
+        // 75% correspond to 190.8 Elo
+        const MatchResult winningResult{.wins = 60, .losses = 10, .draws = 30};
+        EXPECT_NEAR(winningResult.eloDifference(), 190.8, 0.1);
+        EXPECT_GT(winningResult.likelihoodOfSuperiority(), 0.99);
+
+        const MatchResult losingResult{.wins = 10, .losses = 60, .draws = 30};
+        EXPECT_NEAR(losingResult.eloDifference(), -190.8, 0.1);
+        EXPECT_LT(losingResult.likelihoodOfSuperiority(), 0.01);
+
+        // More games, smaller error margin
+        const MatchResult moreGames{.wins = 100, .losses = 100, .draws = 200};
+        EXPECT_LT(moreGames.eloErrorMargin(), evenResult.eloErrorMargin());
+
+        const MatchResult noGames{};
+        EXPECT_EQ(noGames.eloDifference(), 0.0);
+        EXPECT_EQ(noGames.eloErrorMargin(), 0.0);
+
+        std::ostringstream output;
+        output << winningResult;
+        EXPECT_EQ(output.str(), "+60 -10 =30  Elo 190.8 +/- 62.0  LOS 100.0%");
+    }
+
+    TEST(MatchTest, Sprt)
+    {
+        const Sprt sprt{.elo0 = 0.0, .elo1 = 10.0, .alpha = 0.05, .beta = 0.05};
+        EXPECT_NEAR(sprt.lowerBound(), -2.944, 0.001);
+        EXPECT_NEAR(sprt.upperBound(), 2.944, 0.001);
+
+        EXPECT_EQ(sprt.status(MatchResult{.wins = 3, .losses = 2, .draws = 5}), Sprt::Status::Continue);
+        EXPECT_EQ(sprt.status(MatchResult{.wins = 600, .losses = 400, .draws = 1000}), Sprt::Status::AcceptH1);
+        EXPECT_EQ(sprt.status(MatchResult{.wins = 400, .losses = 600, .draws = 1000}), Sprt::Status::AcceptH0);
+
+        // Only draws tell nothing
+        EXPECT_EQ(MatchResult{.draws = 100}.logLikelihoodRatio(0.0, 10.0), 0.0);
+    }
+
+    TEST(MatchTest, RunPlaysEveryOpeningWithBothColors)
+    {
+        const std::vector<GameState> openings{
+            FenParsing::FenParser("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3").parse(),
+            FenParsing::FenParser("rnbqkb1r/pppppppp/5n2/8/3P4/8/PPP1PPPP/RNBQKBNR w KQkq - 1 2").parse()
+        };
+
+        const EngineConfiguration engine{.nodesPerMove = 200};
+        Match match({.numberOfGames = 4, .concurrency = 2, .maximumNumberOfPlies = 30}, engine, engine, openings);
+
+        std::vector<uint32_t> gameIndexes;
+        const MatchResult matchResult = match.run([&](const SelfPlayGame &game, uint32_t gameIndex, const MatchResult &result) {
+            EXPECT_LE(game.moves.size(), 30);
+            EXPECT_EQ(result.numberOfGames(), gameIndexes.size() + 1);
+            gameIndexes.push_back(gameIndex);
+        });
+
+        EXPECT_EQ(matchResult.numberOfGames(), 4);
+        std::sort(gameIndexes.begin(), gameIndexes.end());
+        EXPECT_EQ(gameIndexes, (std::vector<uint32_t>{0, 1, 2, 3}));
+        // The engines are equal and search a fixed number of nodes, so every opening is won by the same color
+        EXPECT_EQ(matchResult.wins, matchResult.losses);
+    }
+
+    TEST(MatchTest, SprtStopsTheMatch)
+    {
+        // White mates in one, so the first engine wins with white and loses with black
+        const std::vector<GameState> openings{FenParsing::FenParser("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1").parse()};
+        const EngineConfiguration engine{.nodesPerMove = 100};
+
+        Match match({.numberOfGames = 1000, .concurrency = 1, .sprt = Sprt{.elo0 = 0.0, .elo1 = 1000.0}},
+                    engine, engine, openings);
+
+        const MatchResult matchResult = match.run();
+        EXPECT_LT(matchResult.numberOfGames(), 1000);
+        // The started pairs of games are finished
+        EXPECT_EQ(matchResult.numberOfGames() % 2, 0);
+        EXPECT_EQ(matchResult.wins, matchResult.losses);
+
+        EXPECT_THROW(Match(Match::Settings{}, engine, engine, {}), std::invalid_argument);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "TestingPositions.h"
+
+#include "ModernChess/MoveDecoder.h"
+#include "ModernChess/MoveExecution.h"
+#include "ModernChess/PseudoMoveGeneration.h"
+#include "ModernChess/FenParsing.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace ModernChess;
+
+namespace
+{
+    Move decode(const GameState &gameState, std::string_view uciMove)
+    {
+        UCIParser parser(uciMove);
+        return MoveDecoder::decodeMove(gameState, parser.parseMove());
+    }
+
+    void expectDecodedMovesMatchGeneratedMoves(const GameState &gameState)
+    {
+        for (const Move move : PseudoMoveGeneration::generateMoves(gameState))
+        {
+            std::stringstream uciMove;
+            uciMove << move;
+
+            EXPECT_EQ(decode(gameState, uciMove.str()), move) << uciMove.str();
+        }
+    }
+
+    TEST(MoveDecoderTest, DecodedMovesMatchGeneratedMoves)
+    {
+        for (const char *fen : {FenParsing::startPosition,
+                                TestingPositions::Position2,
+                                TestingPositions::Position3,
+                                TestingPositions::Position4,
+                                TestingPositions::Position5,
+                                TestingPositions::Position6})
+        {
+            const GameState gameState = FenParsing::FenParser(fen).parse();
+
+            expectDecodedMovesMatchGeneratedMoves(gameState);
+
+            // The replies cover the moves of the other color, e.g. en passant captures and castling of Black
+            for (const Move move : PseudoMoveGeneration::generateMoves(gameState))
+            {
+                GameState gameStateAfterMove = gameState;
+
+                if (MoveExecution::executeMove(gameStateAfterMove, move, MoveType::AllMoves))
+                {
+                    expectDecodedMovesMatchGeneratedMoves(gameStateAfterMove);
+                }
+            }
+        }
+    }
+
+    TEST(MoveDecoderTest, IllegalMovesAreDecodedAsNullMove)
+    {
+        const GameState startPosition = FenParsing::FenParser(FenParsing::startPosition).parse();
+
+        EXPECT_TRUE(decode(startPosition, "e2e5").isNullMove()); // pawn push too far
+        EXPECT_TRUE(decode(startPosition, "a1a3").isNullMove()); // blocked rook
+        EXPECT_TRUE(decode(startPosition, "e1g1").isNullMove()); // castling through own pieces
+        EXPECT_TRUE(decode(startPosition, "e7e5").isNullMove()); // not the side to move
+        EXPECT_TRUE(decode(startPosition, "b1d2").isNullMove()); // target occupied by own piece
+        EXPECT_TRUE(decode(startPosition, "e3e4").isNullMove()); // empty source square
+        EXPECT_TRUE(decode(startPosition, "e2e4q").isNullMove()); // promotion character without promotion
+
+        const GameState gameState = FenParsing::FenParser(TestingPositions::Position5).parse();
+
+        EXPECT_TRUE(decode(gameState, "d7c8").isNullMove()); // promotion without promotion character
+
+        const Move knightPromotion = decode(gameState, "d7c8n");
+        EXPECT_EQ(knightPromotion.getPromotedPiece(), Figure::WhiteKnight);
+        EXPECT_TRUE(knightPromotion.isCapture());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "TestingPositions.h"
+#include "ModernChess/Evaluation.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/NeuralNetwork.h"
+#include "ModernChess/PseudoMoveGeneration.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace ModernChess;
+
+namespace
+{
+    class ExtendedEvaluation : public Evaluation
+    {
+    public:
+        explicit ExtendedEvaluation(SearchContext &searchContext, GameState gameState) :
+                Evaluation(searchContext, gameState)
+        {}
+
+        using ModernChess::Evaluation::evaluatePosition;
+    };
+
+    const std::array Positions {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        TestingPositions::Position2,
+        TestingPositions::Position3,
+        TestingPositions::Position4,
+        TestingPositions::Position5,
+        TestingPositions::Position6,
+        TestingPositions::Zugzwang5
+    };
+
+    std::string temporaryFilePath()
+    {
+        return (std::filesystem::temp_directory_path() / "modern-chess-test-network.nn").string();
+    }
+
+    TEST(NeuralNetworkTest, DefaultNetworkEvaluatesLikeHandcraftedEvaluation)
+    {
+        SearchContext handcraftedContext(1);
+        SearchContext neuralNetworkContext(1);
+        neuralNetworkContext.setNeuralNetwork(NeuralNetwork::defaultNetwork());
+
+        for (const auto fen : Positions)
+        {
+            const GameState gameState = FenParsing::FenParser(fen).parse();
+
+            EXPECT_EQ(ExtendedEvaluation(neuralNetworkContext, gameState).evaluatePosition(),
+                      ExtendedEvaluation(handcraftedContext, gameState).evaluatePosition()) << fen;
+        }
+
+        // Hence, both evaluations search the same tree
+        const GameState gameState = FenParsing::FenParser(TestingPositions::Position2).parse();
+        const EvaluationResult handcraftedResult = Evaluation(handcraftedContext, gameState).getBestMove(4);
+        const EvaluationResult neuralNetworkResult = Evaluation(neuralNetworkContext, gameState).getBestMove(4);
+
+        EXPECT_EQ(neuralNetworkResult.numberOfNodes, handcraftedResult.numberOfNodes);
+        EXPECT_EQ(neuralNetworkResult.score, handcraftedResult.score);
+        EXPECT_EQ(neuralNetworkResult.bestMove(), handcraftedResult.bestMove());
+    }
+
+    TEST(NeuralNetworkTest, IncrementalUpdatesMatchRefresh)
+    {
+        const std::shared_ptr<const NeuralNetwork> network = NeuralNetwork::defaultNetwork();
+
+        // The positions contain captures, promotions, castling and en passant captures
+        for (const auto fen : Positions)
+        {
+            const GameState gameState = FenParsing::FenParser(fen).parse();
+            Accumulator accumulator;
+            network->refresh(accumulator, gameState.board);
+
+            for (const Move move : PseudoMoveGeneration::generateMoves(gameState))
+            {
+                GameState nextGameState = gameState;
+                Accumulator nextAccumulator = accumulator;
+                nextGameState.accumulator = &nextAccumulator;
+
+                if (not MoveExecution::executeMove(nextGameState, move, MoveType::AllMoves))
+                {
+                    continue;
+                }
+
+                Accumulator refreshedAccumulator;
+                network->refresh(refreshedAccumulator, nextGameState.board);
+
+                EXPECT_EQ(nextAccumulator, refreshedAccumulator) << fen << " " << move;
+            }
+        }
+    }
+
+    TEST(NeuralNetworkTest, SavedNetworkCanBeLoaded)
+    {
+        const std::string path = temporaryFilePath();
+        const std::shared_ptr<const NeuralNetwork> defaultNetwork = NeuralNetwork::defaultNetwork();
+        defaultNetwork->save(path);
+
+        const std::shared_ptr<const NeuralNetwork> loadedNetwork = NeuralNetwork::load(path);
+        std::remove(path.c_str());
+
+        for (const auto fen : Positions)
+        {
+            const GameState gameState = FenParsing::FenParser(fen).parse();
+
+            Accumulator defaultAccumulator;
+            Accumulator loadedAccumulator;
+            defaultNetwork->refresh(defaultAccumulator, gameState.board);
+            loadedNetwork->refresh(loadedAccumulator, gameState.board);
+
+            EXPECT_EQ(defaultAccumulator.values, loadedAccumulator.values);
+            EXPECT_EQ(loadedNetwork->evaluate(loadedAccumulator, gameState.board.sideToMove),
+                      defaultNetwork->evaluate(defaultAccumulator, gameState.board.sideToMove));
+        }
+    }
+
+    TEST(NeuralNetworkTest, InvalidFilesAreRejected)
+    {
+        EXPECT_THROW(static_cast<void>(NeuralNetwork::load(temporaryFilePath() + ".missing")), std::runtime_error);
+
+        const std::string path = temporaryFilePath();
+        std::ofstream(path) << "This is not a network";
+
+        EXPECT_THROW(static_cast<void>(NeuralNetwork::load(path)), std::runtime_error);
+        std::remove(path.c_str());
+    }
+}
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include "TestingPositions.h"
 #include "ModernChess/PerftLib/PerformanceTest.h"
+#include "ModernChess/PerftLib/PerftSuite.h"
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+
 namespace
 {
     using namespace ModernChess::Perft;
@@ -66,4 +69,79 @@ namespace
         EXPECT_EQ(test.executePerformanceTest(4), 3894594);
         EXPECT_EQ(test.executePerformanceTest(5), 164075551);
     }
+
+    TEST(PerftTest, ParallelPerftMatchesSerialPerft)
+    {
+        PerformanceTest test(TestingPositions::Position2);
+
+        for (const int depth : {1, 2, 3})
+        {
+            const uint64_t serialNodes = test.executePerformanceTest(depth);
+            const auto serialDivide = test.divide();
+
+            EXPECT_EQ(test.executeParallelPerformanceTest(depth, 4), serialNodes);
+            EXPECT_EQ(test.divide(), serialDivide);
+        }
+    }
+
+    TEST(PerftTest, BulkCountingAndCacheMatchPlainPerft)
+    {
+        for (const auto fen : {TestingPositions::Position2,
+                               TestingPositions::Position3,
+                               TestingPositions::Position4,
+                               TestingPositions::Position5,
+                               TestingPositions::Position6})
+        {
+            PerformanceTest test(fen);
+            const uint64_t plainNodes = test.executePerformanceTest(4);
+
+            test.setBulkCounting(true);
+            EXPECT_EQ(test.executePerformanceTest(4), plainNodes) << fen;
+
+            test.setCacheSize(16);
+            EXPECT_EQ(test.executePerformanceTest(4), plainNodes) << fen;
+            EXPECT_EQ(test.executeParallelPerformanceTest(4, 4), plainNodes) << fen;
+
+            test.setBulkCounting(false);
+            EXPECT_EQ(test.executePerformanceTest(4), plainNodes) << fen;
+        }
+    }
+
+    TEST(PerftTest, PerftSuiteParsesEpdAndDetectsWrongNodeCounts)
+    {
+        const PerftSuiteEntry entry = PerftSuiteEntry::fromEpd("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - ;D1 14 ;D2 191");
+
+        EXPECT_EQ(entry.fen, TestingPositions::Position3);
+        ASSERT_EQ(entry.expectedNodes.size(), 2);
+        EXPECT_EQ(entry.expectedNodes[1], std::make_pair(2, uint64_t(191)));
+
+        std::istringstream epd("# comment\n"
+                               "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1 ;D1 48 ;D2 2039 ;D3 97862\n"
+                               "\n"
+                               "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10 ;D1 46 ;D2 2080 ;D3 89890\n");
+
+        PerftSuite suite(epd);
+        suite.setMaxDepth(2);
+        suite.setNumberOfThreads(2);
+        suite.setBulkCounting(true);
+
+        const std::vector<PerftSuiteResult> &results = suite.run();
+
+        ASSERT_EQ(results.size(), 4);
+        EXPECT_EQ(results[1].positionIndex, 0);
+        EXPECT_EQ(results[1].nodes, 2039);
+        EXPECT_TRUE(results[1].passed());
+        EXPECT_EQ(results[3].positionIndex, 1);
+        EXPECT_EQ(results[3].nodes, 2079);
+        EXPECT_FALSE(results[3].passed());
+        EXPECT_FALSE(suite.allPassed());
+
+        std::ostringstream json;
+        suite.writeJsonReport(json);
+        EXPECT_NE(json.str().find("\"depth\": 2, \"expected\": 2080, \"nodes\": 2079"), std::string::npos);
+
+        std::ostringstream csv;
+        suite.writeCsvReport(csv);
+        EXPECT_NE(csv.str().find("1,\"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10\",2,2080,2079,"), std::string::npos);
+    }
 }
\ No newline at end of file
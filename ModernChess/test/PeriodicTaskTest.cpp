@@ -0,0 +1,36 @@
+#include "ModernChess/PeriodicTask.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace ModernChess;
+using namespace std::chrono_literals;
+
+namespace {
+    TEST(PeriodicTaskTest, TaskIsExecutedOncePerPeriod)
+    {
+        std::atomic<uint32_t> numberOfExecutions{0};
+
+        {
+            PeriodicTask task(50ms, [&numberOfExecutions] { ++numberOfExecutions; });
+            task.start();
+            std::this_thread::sleep_for(275ms);
+        }
+
+        // Some tolerance for slow machines, but a busy loop would execute the task much more often
+        EXPECT_GE(numberOfExecutions, 3);
+        EXPECT_LE(numberOfExecutions, 6);
+    }
+
+    TEST(PeriodicTaskTest, StoppedTaskIsNotExecuted)
+    {
+        std::atomic<uint32_t> numberOfExecutions{0};
+
+        PeriodicTask task(1h, [&numberOfExecutions] { ++numberOfExecutions; });
+        task.start();
+        task.stop();
+
+        EXPECT_EQ(numberOfExecutions, 0);
+    }
+}
\ No newline at end of file
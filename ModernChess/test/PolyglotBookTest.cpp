@@ -0,0 +1,233 @@
+#include "TestingPositions.h"
+#include "ModernChess/BitBoardOperations.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/MoveDecoder.h"
+#include "ModernChess/PolyglotBook.h"
+#include "ModernChess/PolyglotHasher.h"
+#include "ModernChess/SelfPlay.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+using namespace ModernChess;
+
+namespace
+{
+    std::string temporaryFilePath()
+    {
+        return (std::filesystem::temp_directory_path() / "modern-chess-test-book.bin").string();
+    }
+
+    GameState parse(std::string_view fen)
+    {
+        return FenParsing::FenParser(fen).parse();
+    }
+
+    Move decode(const GameState &gameState, std::string_view uciMove)
+    {
+        return MoveDecoder::decodeMove(gameState, UCIParser(uciMove).parseMove());
+    }
+
+    TEST(PolyglotBookTest, HashHasPolyglotLayout)
+    {
+        const GameState startPosition = parse(FenParsing::startPosition);
+        uint64_t expectedKey = PolyglotHasher::randomKeys[PolyglotHasher::SideKeyOffset];
+
+        for (Figure figure = Figure::WhitePawn; figure <= Figure::BlackKing; ++figure)
+        {
+            for (Square square = Square::a1; square <= Square::h8; ++square)
+            {
+                if (BitBoardOperations::isOccupied(startPosition.board.bitboards[figure], square))
+                {
+                    expectedKey ^= PolyglotHasher::randomKeys[PolyglotHasher::figureKeyIndex(figure, square)];
+                }
+            }
+        }
+
+        for (size_t castlingIndex = 0; castlingIndex < 4; ++castlingIndex)
+        {
+            expectedKey ^= PolyglotHasher::randomKeys[PolyglotHasher::CastlingKeysOffset + castlingIndex];
+        }
+
+        EXPECT_EQ(PolyglotHasher::generateHash(startPosition.board), expectedKey);
+
+        // Black pawn: 0, white pawn: 1, ..., white king: 11
+        EXPECT_EQ(PolyglotHasher::figureKeyIndex(Figure::BlackPawn, Square::a1), 0);
+        EXPECT_EQ(PolyglotHasher::figureKeyIndex(Figure::WhitePawn, Square::b1), 65);
+        EXPECT_EQ(PolyglotHasher::figureKeyIndex(Figure::BlackKing, Square::e8), 10 * 64 + 60);
+        EXPECT_EQ(PolyglotHasher::figureKeyIndex(Figure::WhiteKing, Square::h8), 767);
+    }
+
+    // Positions and keys of the Polyglot specification
+    struct SpecificationKey
+    {
+        std::string_view fen;
+        uint64_t key;
+    };
+
+    constexpr std::array SpecificationKeys {
+        SpecificationKey{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0x463b96181691fc9c},
+        SpecificationKey{"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823c9b50fd114196},
+        SpecificationKey{"rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2", 0x0756b94461c50fb0},
+        SpecificationKey{"rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2", 0x662fafb965db29d4},
+        SpecificationKey{"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22a48b5a8e47ff78},
+        SpecificationKey{"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652a607ca3f242c1},
+        SpecificationKey{"rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00fdd303c946bdd9},
+        SpecificationKey{"rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3c8123ea7b067637},
+        SpecificationKey{"rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5c3f9b829b279560}
+    };
+
+    uint64_t hash(std::string_view fen)
+    {
+        return PolyglotHasher::generateHash(parse(fen).board);
+    }
+
+    TEST(PolyglotBookTest, SpecificationKeys)
+    {
+        for (const auto &[fen, key] : SpecificationKeys)
+        {
+            EXPECT_EQ(hash(fen), key) << fen;
+        }
+    }
+
+    TEST(PolyglotBookTest, EnPassantIsOnlyHashedIfCapturePossible)
+    {
+        // No black pawn can capture on e3
+        EXPECT_EQ(PolyglotHasher::generateHash(parse("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1").board),
+                  PolyglotHasher::generateHash(parse("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1").board));
+
+        // The black pawn on d4 can capture on e3
+        const uint64_t keyWithEnPassant = PolyglotHasher::generateHash(parse("4k3/8/8/8/3pP3/8/8/4K3 b - e3 0 1").board);
+        const uint64_t keyWithoutEnPassant = PolyglotHasher::generateHash(parse("4k3/8/8/8/3pP3/8/8/4K3 b - - 0 1").board);
+        EXPECT_EQ(keyWithEnPassant ^ keyWithoutEnPassant,
+                  PolyglotHasher::randomKeys[PolyglotHasher::EnPassantKeysOffset + 4]);
+    }
+
+    TEST(PolyglotBookTest, EncodeAndDecodeMoves)
+    {
+        const GameState castlingPosition = parse("r3k2r/1P6/8/8/8/8/8/R3K2R w KQkq - 0 1");
+
+        // Castling is encoded as capturing the own rook
+        EXPECT_EQ(PolyglotBook::encodeMove(decode(castlingPosition, "e1g1")), Square::h1 | (Square::e1 << 6));
+        EXPECT_EQ(PolyglotBook::encodeMove(decode(castlingPosition, "e1c1")), Square::a1 | (Square::e1 << 6));
+        // Queen promotion: 4
+        EXPECT_EQ(PolyglotBook::encodeMove(decode(castlingPosition, "b7a8q")), Square::a8 | (Square::b7 << 6) | (4 << 12));
+
+        for (const GameState &gameState : {parse(FenParsing::startPosition), castlingPosition,
+                                           parse("r3k2r/8/8/8/8/8/6p1/R3K2R b KQkq - 0 1")})
+        {
+            for (const Move move : SelfPlay::generateLegalMoves(gameState))
+            {
+                EXPECT_EQ(PolyglotBook::decodeMove(gameState, PolyglotBook::encodeMove(move)), move) << move;
+            }
+        }
+
+        // The rook captures on h1, if the king is not on e1
+        const GameState rookPosition = parse("4k3/8/8/8/8/8/8/4R2r w - - 0 1");
+        EXPECT_EQ(PolyglotBook::decodeMove(rookPosition, Square::h1 | (Square::e1 << 6)), decode(rookPosition, "e1h1"));
+    }
+
+    TEST(PolyglotBookTest, FindEntriesByBinarySearch)
+    {
+        const std::string path = temporaryFilePath();
+        std::vector<PolyglotEntry> entries;
+
+        for (uint64_t key = 1; key <= 100; ++key)
+        {
+            // Three entries per key, so the binary search has to find the first one
+            for (uint16_t move = 0; move < 3; ++move)
+            {
+                entries.push_back(PolyglotEntry{key * 1000, move, uint16_t(key), uint32_t(key + move)});
+            }
+        }
+
+        std::reverse(entries.begin(), entries.end());
+        PolyglotBook::save(path, entries);
+
+        const auto book = PolyglotBook::load(path);
+        EXPECT_EQ(book->numberOfEntries(), entries.size());
+
+        for (size_t index = 1; index < book->numberOfEntries(); ++index)
+        {
+            EXPECT_LE(book->entry(index - 1).key, book->entry(index).key);
+        }
+
+        const std::vector<PolyglotEntry> foundEntries = book->findEntries(42'000);
+        ASSERT_EQ(foundEntries.size(), 3);
+
+        for (const PolyglotEntry &entry : foundEntries)
+        {
+            EXPECT_EQ(entry.key, 42'000);
+            EXPECT_EQ(entry.weight, 42);
+            EXPECT_EQ(entry.learn, 42 + entry.move);
+        }
+
+        EXPECT_TRUE(book->findEntries(0).empty());
+        EXPECT_TRUE(book->findEntries(42'001).empty());
+        EXPECT_TRUE(book->findEntries(1'000'000).empty());
+        EXPECT_EQ(book->findEntries(1'000).size(), 3);
+        EXPECT_EQ(book->findEntries(100'000).size(), 3);
+
+        std::remove(path.c_str());
+    }
+
+    TEST(PolyglotBookTest, ChooseMoveByWeight)
+    {
+        const std::string path = temporaryFilePath();
+        const GameState startPosition = parse(FenParsing::startPosition);
+        const uint64_t key = PolyglotHasher::generateHash(startPosition.board);
+        const Move e2e4 = decode(startPosition, "e2e4");
+        const Move d2d4 = decode(startPosition, "d2d4");
+        const Move b1c3 = decode(startPosition, "b1c3");
+
+        PolyglotBook::save(path, {
+            PolyglotEntry{key, PolyglotBook::encodeMove(e2e4), 3, 0},
+            PolyglotEntry{key, PolyglotBook::encodeMove(d2d4), 1, 0},
+            // Weight 0 and illegal moves are never played
+            PolyglotEntry{key, PolyglotBook::encodeMove(b1c3), 0, 0},
+            PolyglotEntry{key, uint16_t(Square::e5 | (Square::e2 << 6)), 100, 0},
+            PolyglotEntry{key + 1, PolyglotBook::encodeMove(b1c3), 100, 0}
+        });
+
+        const auto book = PolyglotBook::load(path);
+        std::map<bool, uint32_t> numberOfChoices;
+
+        for (uint32_t randomNumber = 0; randomNumber < 400; ++randomNumber)
+        {
+            const Move move = book->chooseMove(startPosition, randomNumber);
+            ASSERT_TRUE(move == e2e4 or move == d2d4) << move;
+            ++numberOfChoices[move == e2e4];
+        }
+
+        EXPECT_EQ(numberOfChoices[true], 300);
+        EXPECT_EQ(numberOfChoices[false], 100);
+        EXPECT_EQ(book->chooseMove(startPosition, 0), e2e4);
+
+        // Not in the book
+        EXPECT_TRUE(book->chooseMove(parse(TestingPositions::Position2), 0).isNullMove());
+
+        std::remove(path.c_str());
+    }
+
+    TEST(PolyglotBookTest, LoadRejectsInvalidFiles)
+    {
+        const std::string path = temporaryFilePath();
+
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << "no book";
+        }
+
+        EXPECT_THROW(static_cast<void>(PolyglotBook::load(path)), std::runtime_error);
+
+        std::remove(path.c_str());
+
+        EXPECT_THROW(static_cast<void>(PolyglotBook::load(path)), std::runtime_error);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "TestingPositions.h"
+#include "ModernChess/Evaluation.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/SearchContext.h"
+
+#include <gtest/gtest.h>
+
+using namespace ModernChess;
+
+namespace
+{
+    TEST(SearchContextTest, EnginesDoNotShareTables)
+    {
+        const GameState gameState = FenParsing::FenParser(TestingPositions::Position2).parse();
+
+        SearchContext firstSearchContext(1);
+        SearchContext secondSearchContext(1);
+
+        static_cast<void>(Evaluation(firstSearchContext, gameState).getBestMove(4));
+
+        EXPECT_GT(firstSearchContext.transpositionTable().hashfull(), 0);
+        EXPECT_EQ(secondSearchContext.transpositionTable().hashfull(), 0);
+
+        // Parsing a position does not clear any table
+        static_cast<void>(FenParsing::FenParser(TestingPositions::Position3).parse());
+        EXPECT_GT(firstSearchContext.transpositionTable().hashfull(), 0);
+
+        firstSearchContext.clear();
+        EXPECT_EQ(firstSearchContext.transpositionTable().hashfull(), 0);
+    }
+
+    TEST(SearchContextTest, SearchesOfOneContextAreReproducible)
+    {
+        const GameState gameState = FenParsing::FenParser(TestingPositions::Position2).parse();
+        SearchContext searchContext(1);
+
+        const EvaluationResult firstResult = Evaluation(searchContext, gameState).getBestMove(4);
+
+        // The history tables are reset by every search, so only the transposition table has to be cleared
+        searchContext.transpositionTable().clear();
+        const EvaluationResult secondResult = Evaluation(searchContext, gameState).getBestMove(4);
+
+        EXPECT_EQ(firstResult.numberOfNodes, secondResult.numberOfNodes);
+        EXPECT_EQ(firstResult.bestMove(), secondResult.bestMove());
+    }
+}
\ No newline at end of file
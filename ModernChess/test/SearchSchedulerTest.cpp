@@ -0,0 +1,119 @@
+#include "TestingPositions.h"
+#include "ModernChess/Evaluation.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/SearchScheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace ModernChess;
+using namespace std::chrono_literals;
+
+namespace
+{
+    TEST(SearchSchedulerTest, InterleavedSearchesHaveTheSameResultsAsUninterruptedOnes)
+    {
+        const std::vector<GameState> gameStates{
+            FenParsing::FenParser(FenParsing::startPosition).parse(),
+            FenParsing::FenParser(TestingPositions::Position2).parse(),
+            FenParsing::FenParser(TestingPositions::Position3).parse(),
+            FenParsing::FenParser(TestingPositions::Position4).parse()
+        };
+        SearchTaskLimits limits;
+        limits.depth = 4;
+
+        // Many tasks per thread and short time slices, so the searches are suspended very often
+        SearchScheduler searchScheduler(2, 64, 3);
+        std::vector<std::future<SearchTaskResult>> futures;
+
+        for (size_t round = 0; round < 4; ++round)
+        {
+            for (const GameState &gameState : gameStates)
+            {
+                futures.push_back(searchScheduler.submit(gameState, limits));
+            }
+        }
+
+        for (size_t index = 0; index < futures.size(); ++index)
+        {
+            const SearchTaskResult result = futures[index].get();
+
+            SearchContext searchContext(SearchScheduler::DefaultHashSizePerTaskInMB);
+            Evaluation evaluation(searchContext, gameStates[index % gameStates.size()]);
+            EvaluationResult expectedResult;
+
+            for (uint8_t depth = 1; depth <= limits.depth; ++depth)
+            {
+                expectedResult = evaluation.getBestMove(depth);
+            }
+
+            EXPECT_TRUE(result.completed);
+            EXPECT_EQ(result.depth, limits.depth);
+            EXPECT_EQ(result.bestMove, expectedResult.bestMove());
+            EXPECT_EQ(result.score, expectedResult.score);
+            EXPECT_EQ(result.numberOfNodes, expectedResult.numberOfNodes);
+        }
+    }
+
+    TEST(SearchSchedulerTest, NodeBudgetIsEnforced)
+    {
+        constexpr uint64_t TimeSlice = 256;
+        SearchScheduler searchScheduler(1, TimeSlice);
+
+        SearchTaskLimits limits;
+        limits.depth = 30;
+        limits.nodes = 10'000;
+
+        const SearchTaskResult result = searchScheduler.submit(FenParsing::FenParser(TestingPositions::Position2).parse(),
+                                                               limits).get();
+
+        EXPECT_FALSE(result.completed);
+        EXPECT_FALSE(result.bestMove.isNullMove());
+        EXPECT_GE(result.numberOfNodes, limits.nodes);
+        // The search is stopped at the first yield after the budget, it unwinds without yielding again
+        EXPECT_LT(result.numberOfNodes, limits.nodes + 2 * TimeSlice);
+    }
+
+    TEST(SearchSchedulerTest, LongSearchesDoNotStarveShortOnes)
+    {
+        SearchScheduler searchScheduler(1);
+        const GameState gameState = FenParsing::FenParser(TestingPositions::Position2).parse();
+
+        SearchTaskLimits longLimits;
+        longLimits.depth = 30;
+        longLimits.time = 2s;
+        std::future<SearchTaskResult> longSearch = searchScheduler.submit(gameState, longLimits);
+
+        SearchTaskLimits shortLimits;
+        shortLimits.depth = 2;
+        const SearchTaskResult shortResult = searchScheduler.submit(gameState, shortLimits).get();
+
+        EXPECT_TRUE(shortResult.completed);
+        // The deadline of the long search has not been reached yet
+        EXPECT_EQ(longSearch.wait_for(0s), std::future_status::timeout);
+
+        const SearchTaskResult longResult = longSearch.get();
+        EXPECT_FALSE(longResult.completed);
+        EXPECT_LT(longResult.latency, 3s);
+    }
+
+    TEST(SearchSchedulerTest, PendingTasksAreStoppedByTheDestructor)
+    {
+        std::future<SearchTaskResult> future;
+
+        {
+            SearchScheduler searchScheduler(1, SearchScheduler::DefaultTimeSliceInNodes, 1);
+            SearchTaskLimits limits;
+            limits.depth = 30;
+
+            const GameState gameState = FenParsing::FenParser(TestingPositions::Position2).parse();
+            static_cast<void>(searchScheduler.submit(gameState, limits));
+            future = searchScheduler.submit(gameState, limits);
+        }
+
+        const SearchTaskResult result = future.get();
+        EXPECT_FALSE(result.completed);
+        EXPECT_TRUE(result.bestMove.isNullMove());
+    }
+}
\ No newline at end of file
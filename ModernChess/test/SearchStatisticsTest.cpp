@@ -0,0 +1,39 @@
+#include "ModernChess/SearchStatistics.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace
+{
+    using namespace ModernChess;
+
+    TEST(SearchStatisticsTest, RatesAndSums)
+    {
+        SearchStatistics statistics;
+        statistics.betaCutoffs = 200;
+        statistics.firstMoveBetaCutoffs = 180;
+        statistics.nodesPerDepth = {0, 20, 60, 300};
+
+        EXPECT_DOUBLE_EQ(statistics.firstMoveCutoffRate(), 90.0);
+        EXPECT_DOUBLE_EQ(statistics.effectiveBranchingFactor(1), 0.0);
+        EXPECT_DOUBLE_EQ(statistics.effectiveBranchingFactor(2), 3.0);
+        EXPECT_DOUBLE_EQ(statistics.effectiveBranchingFactor(3), 5.0);
+        EXPECT_DOUBLE_EQ(statistics.effectiveBranchingFactor(4), 0.0);
+
+        SearchStatistics otherStatistics;
+        otherStatistics.betaCutoffs = 100;
+        otherStatistics.nodesPerDepth = {0, 10, 20, 30, 40};
+
+        statistics += otherStatistics;
+
+        EXPECT_EQ(statistics.betaCutoffs, 300);
+        EXPECT_EQ(statistics.nodesPerDepth, std::vector<uint64_t>({0, 30, 80, 330, 40}));
+
+        std::ostringstream json;
+        statistics.writeJson(json);
+
+        EXPECT_NE(json.str().find("\"beta_cutoffs\": 300"), std::string::npos);
+        EXPECT_NE(json.str().find("\"nodes_per_depth\": [30, 80, 330, 40]"), std::string::npos);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/SelfPlay.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace ModernChess;
+
+namespace
+{
+    const EngineConfiguration FastEngine{.nodesPerMove = 500};
+
+    TEST(SelfPlayTest, GenerateLegalMoves)
+    {
+        EXPECT_EQ(SelfPlay::generateLegalMoves(FenParsing::FenParser(FenParsing::startPosition).parse()).size(), 20);
+
+        // The king is in check and can only escape to the side
+        const GameState gameState = FenParsing::FenParser("4k3/8/8/8/8/8/4r3/4K3 w - - 0 1").parse();
+        EXPECT_EQ(SelfPlay::generateLegalMoves(gameState).size(), 3);
+    }
+
+    TEST(SelfPlayTest, HasInsufficientMaterial)
+    {
+        EXPECT_TRUE(SelfPlay::hasInsufficientMaterial(FenParsing::FenParser("4k3/8/8/8/8/8/8/4K3 w - - 0 1").parse().board));
+        EXPECT_TRUE(SelfPlay::hasInsufficientMaterial(FenParsing::FenParser("4k3/8/8/8/8/8/8/2B1K3 w - - 0 1").parse().board));
+        EXPECT_FALSE(SelfPlay::hasInsufficientMaterial(FenParsing::FenParser("4k3/8/8/8/8/8/8/1NB1K3 w - - 0 1").parse().board));
+        EXPECT_FALSE(SelfPlay::hasInsufficientMaterial(FenParsing::FenParser("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1").parse().board));
+    }
+
+    TEST(SelfPlayTest, WhiteMatesInOne)
+    {
+        const GameState gameState = FenParsing::FenParser("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1").parse();
+        const SelfPlayGame game = SelfPlay::playGame(gameState, FastEngine, FastEngine);
+
+        EXPECT_EQ(game.result, GameResult::WhiteWins);
+        EXPECT_EQ(game.termination, GameTermination::Checkmate);
+        ASSERT_EQ(game.moves.size(), 1);
+    }
+
+    TEST(SelfPlayTest, GameEndsWithTheRules)
+    {
+        // Nobody can make progress without pawns
+        const GameState drawnGameState = FenParsing::FenParser("4k3/8/8/8/8/8/8/2B1K3 b - - 0 1").parse();
+        const SelfPlayGame drawnGame = SelfPlay::playGame(drawnGameState, FastEngine, FastEngine);
+
+        EXPECT_EQ(drawnGame.result, GameResult::Draw);
+        EXPECT_EQ(drawnGame.termination, GameTermination::InsufficientMaterial);
+        EXPECT_TRUE(drawnGame.moves.empty());
+
+        const GameState stalemate = FenParsing::FenParser("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1").parse();
+        EXPECT_EQ(SelfPlay::playGame(stalemate, FastEngine, FastEngine).termination, GameTermination::Stalemate);
+
+        const GameState gameState = FenParsing::FenParser(FenParsing::startPosition).parse();
+        const SelfPlayGame game = SelfPlay::playGame(gameState, FastEngine, FastEngine, 6);
+
+        EXPECT_EQ(game.result, GameResult::Draw);
+        EXPECT_EQ(game.termination, GameTermination::MaximumLength);
+        EXPECT_EQ(game.moves.size(), 6);
+    }
+
+    TEST(SelfPlayTest, BishopsCannotAvoidTheFiftyMoveRule)
+    {
+        // Ten plies before the fifty-move rule. Nobody can win with a bishop, so all moves lead to a draw.
+        const GameState gameState = FenParsing::FenParser("4kb2/8/8/8/8/8/8/2B1K3 w - - 90 1").parse();
+        const SelfPlayGame game = SelfPlay::playGame(gameState, FastEngine, FastEngine);
+
+        EXPECT_EQ(game.result, GameResult::Draw);
+        EXPECT_TRUE(game.termination == GameTermination::FiftyMoveRule or
+                    game.termination == GameTermination::ThreefoldRepetition or
+                    game.termination == GameTermination::InsufficientMaterial);
+        EXPECT_LE(game.moves.size(), 10);
+    }
+
+    TEST(SelfPlayTest, AdjudicateWin)
+    {
+        // White has two queens more, so the game is adjudicated before the mate
+        const GameState gameState = FenParsing::FenParser("4k3/8/8/8/8/8/8/QQ2K3 w - - 0 1").parse();
+        const SelfPlayGame game = SelfPlay::playGame(gameState, FastEngine, FastEngine, SelfPlay::DefaultMaximumNumberOfPlies,
+                                                     Adjudication{.winNumberOfPlies = 4});
+
+        EXPECT_EQ(game.result, GameResult::WhiteWins);
+        EXPECT_TRUE(game.termination == GameTermination::AdjudicatedWin or game.termination == GameTermination::Checkmate);
+        EXPECT_LE(game.moves.size(), 4);
+    }
+
+    TEST(SelfPlayTest, AdjudicateDraw)
+    {
+        // Symmetric pawn endgame without progress
+        const GameState gameState = FenParsing::FenParser("4k3/8/3p4/3P4/8/8/8/4K3 w - - 0 1").parse();
+        const SelfPlayGame game = SelfPlay::playGame(gameState, FastEngine, FastEngine, SelfPlay::DefaultMaximumNumberOfPlies,
+                                                     Adjudication{.drawScore = 100, .drawNumberOfPlies = 4, .drawMinimumNumberOfPlies = 4});
+
+        EXPECT_EQ(game.result, GameResult::Draw);
+        EXPECT_EQ(game.termination, GameTermination::AdjudicatedDraw);
+        EXPECT_EQ(game.moves.size(), 4);
+    }
+
+    TEST(SelfPlayTest, TimeControl)
+    {
+        EXPECT_EQ(SelfPlay::allocateTime(std::chrono::milliseconds(30'000), std::chrono::milliseconds(0)),
+                  std::chrono::milliseconds(1'000));
+        EXPECT_EQ(SelfPlay::allocateTime(std::chrono::milliseconds(30'000), std::chrono::milliseconds(400)),
+                  std::chrono::milliseconds(1'300));
+        // Never more than half of the remaining time
+        EXPECT_EQ(SelfPlay::allocateTime(std::chrono::milliseconds(100), std::chrono::milliseconds(1'000)),
+                  std::chrono::milliseconds(50));
+
+        const EngineConfiguration timedEngine{.nodesPerMove = 100'000,
+                                              .timeControl = {std::chrono::milliseconds(2'000), std::chrono::milliseconds(10)}};
+        const GameState gameState = FenParsing::FenParser(FenParsing::startPosition).parse();
+
+        const auto begin = std::chrono::steady_clock::now();
+        const SelfPlayGame game = SelfPlay::playGame(gameState, timedEngine, timedEngine, 8);
+
+        EXPECT_EQ(game.termination, GameTermination::MaximumLength);
+        EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(4'200));
+    }
+
+    TEST(SelfPlayTest, ReadOpenings)
+    {
+        std::istringstream openingsStream(
+                "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1\n"
+                "\n"
+                "4k3/8/8/8/8/8/4P3/4K3 w - - id \"endgame\";\n");
+
+        const std::vector<GameState> openings = SelfPlay::readOpenings(openingsStream);
+
+        ASSERT_EQ(openings.size(), 2);
+        EXPECT_EQ(openings[0].board.sideToMove, Color::Black);
+        EXPECT_EQ(SelfPlay::generateLegalMoves(openings[1]).size(), 6);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/SpsaTuner.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace ModernChess;
+
+namespace
+{
+    TEST(SpsaTunerTest, ValuesAreRoundedAndClamped)
+    {
+        const SearchParameters defaultParameters;
+        EXPECT_EQ(SpsaTuner::toSearchParameters(SpsaTuner::toValues(defaultParameters)), defaultParameters);
+
+        SpsaTuner::Values values = SpsaTuner::toValues(defaultParameters);
+        values[0] = 3.6;
+        values[3] = 100;
+
+        const SearchParameters searchParameters = SpsaTuner::toSearchParameters(values);
+        EXPECT_EQ(searchParameters.*TunableSearchParameters[0].value, 4);
+        EXPECT_EQ(searchParameters.*TunableSearchParameters[3].value, TunableSearchParameters[3].maximum);
+    }
+
+    TEST(SpsaTunerTest, NeedsOpenings)
+    {
+        EXPECT_THROW(SpsaTuner(SpsaTuner::Settings{}, {}), std::invalid_argument);
+    }
+
+    TEST(SpsaTunerTest, TuneStaysInRange)
+    {
+        const std::vector<GameState> openings{
+            FenParsing::FenParser("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3").parse(),
+            FenParsing::FenParser("rnbqkb1r/pppppppp/5n2/8/3P4/8/PPP1PPPP/RNBQKBNR w KQkq - 1 2").parse()
+        };
+
+        SpsaTuner spsaTuner({.numberOfThreads = 2, .numberOfIterations = 10, .numberOfGamePairsPerIteration = 2,
+                             .nodesPerMove = 200, .maximumNumberOfPlies = 20}, openings);
+
+        std::ostringstream log;
+        const SearchParameters searchParameters = spsaTuner.tune(SearchParameters{}, log);
+
+        for (const TunableSearchParameter &parameter : TunableSearchParameters)
+        {
+            EXPECT_GE(searchParameters.*parameter.value, parameter.minimum) << parameter.name;
+            EXPECT_LE(searchParameters.*parameter.value, parameter.maximum) << parameter.name;
+        }
+
+        EXPECT_NE(log.str().find("iteration 10 NumberOfMovesForFullDepthSearch="), std::string::npos);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "TestingPositions.h"
+#include "ModernChess/Evaluation.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/TexelTuner.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace ModernChess;
+
+namespace
+{
+    class ExtendedEvaluation : public Evaluation
+    {
+    public:
+        explicit ExtendedEvaluation(SearchContext &searchContext, GameState gameState) :
+                Evaluation(searchContext, gameState)
+        {}
+
+        using ModernChess::Evaluation::evaluatePosition;
+    };
+
+    const std::array Positions {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        TestingPositions::Position2,
+        TestingPositions::Position3,
+        TestingPositions::Position4,
+        TestingPositions::Position5,
+        TestingPositions::Position6,
+        TestingPositions::Zugzwang5
+    };
+
+    TEST(TexelTunerTest, ParametersEvaluateLikeEvaluation)
+    {
+        SearchContext searchContext(1);
+        const TexelParameters parameters = TexelParameters::fromEvaluation();
+
+        for (const auto fen : Positions)
+        {
+            const GameState gameState = FenParsing::FenParser(fen).parse();
+            const double sign = (gameState.board.sideToMove == Color::White) ? 1.0 : -1.0;
+
+            EXPECT_EQ(sign * parameters.evaluate(gameState.board),
+                      ExtendedEvaluation(searchContext, gameState).evaluatePosition()) << fen;
+        }
+    }
+
+    TEST(TexelTunerTest, PackedPositionKeepsTheFigures)
+    {
+        for (const auto fen : Positions)
+        {
+            const Board board = FenParsing::FenParser(fen).parse().board;
+            const std::optional<PackedPosition> position = PackedPosition::pack(board, 1);
+
+            ASSERT_TRUE(position.has_value()) << fen;
+            EXPECT_EQ(position->score(), 0.5);
+
+            const Board unpackedBoard = position->unpack();
+            EXPECT_EQ(unpackedBoard.bitboards, board.bitboards) << fen;
+            EXPECT_EQ(unpackedBoard.occupancies, board.occupancies) << fen;
+        }
+
+        EXPECT_EQ(sizeof(PackedPosition), 32);
+    }
+
+    TEST(TexelTunerTest, ParseLine)
+    {
+        const std::string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+        EXPECT_EQ(TexelTuner::parseLine(fen + " [1.0]"), std::pair(fen, uint8_t(2)));
+        EXPECT_EQ(TexelTuner::parseLine(fen + " [0.5]"), std::pair(fen, uint8_t(1)));
+        EXPECT_EQ(TexelTuner::parseLine(fen + " [0]"), std::pair(fen, uint8_t(0)));
+        EXPECT_EQ(TexelTuner::parseLine(fen + " [1-0]"), std::pair(fen, uint8_t(2)));
+        EXPECT_EQ(TexelTuner::parseLine(fen + " [1/2-1/2]"), std::pair(fen, uint8_t(1)));
+        EXPECT_EQ(TexelTuner::parseLine("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - c9 \"0-1\";"),
+                  std::pair(fen, uint8_t(0)));
+
+        EXPECT_FALSE(TexelTuner::parseLine(fen).has_value());
+        EXPECT_FALSE(TexelTuner::parseLine(fen + " [2]").has_value());
+        EXPECT_FALSE(TexelTuner::parseLine("8/8 w [1-0]").has_value());
+    }
+
+    TEST(TexelTunerTest, LoadPositionsResolvesCaptures)
+    {
+        // White wins the queen, so the tuner sees the quiet position after the capture
+        std::istringstream positions(
+                "# comment\n"
+                "4k3/8/8/3q4/4P3/8/8/4K3 w - - 0 1 [1-0]\n"
+                "invalid [1-0]\n"
+                "4k3/8/8/8/8/8/8/4K3 w - - 0 1\n");
+
+        TexelTuner tuner({.numberOfThreads = 2});
+
+        EXPECT_EQ(tuner.loadPositions(positions), 1);
+        EXPECT_EQ(tuner.numberOfPositions(), 1);
+        EXPECT_EQ(tuner.numberOfSkippedLines(), 2);
+
+        std::istringstream quietPositions("4k3/8/8/3q4/4P3/8/8/4K3 w - - 0 1 [1-0]\n");
+        TexelTuner quietTuner({.numberOfThreads = 2, .resolveQuiescence = false});
+        quietTuner.loadPositions(quietPositions);
+
+        // Without the black queen, white is better
+        const TexelParameters parameters = TexelParameters::fromEvaluation();
+        EXPECT_LT(tuner.meanSquaredError(parameters, 1.0), quietTuner.meanSquaredError(parameters, 1.0));
+    }
+
+    TEST(TexelTunerTest, TuningReducesTheError)
+    {
+        // Whoever has more knights wins, so the knight is worth more than the evaluation assumes
+        std::ostringstream lines;
+
+        for (uint32_t repetition = 0; repetition < 20; ++repetition)
+        {
+            lines << "4k3/8/8/8/8/8/8/NN2K3 w - - 0 1 [1.0]\n"
+                  << "nn2k3/8/8/8/8/8/8/4K3 w - - 0 1 [0.0]\n"
+                  << "4k3/pppppppp/8/8/8/8/PPPPPPPP/4K3 w - - 0 1 [0.5]\n";
+        }
+
+        std::istringstream positions(lines.str());
+        TexelTuner tuner({.numberOfThreads = 2, .numberOfEpochs = 50, .learningRate = 5.0});
+        tuner.loadPositions(positions);
+
+        const TexelParameters initialParameters = TexelParameters::fromEvaluation();
+        std::ostringstream log;
+        const TexelParameters tunedParameters = tuner.tune(initialParameters, log);
+        const double scalingConstant = tuner.findScalingConstant(initialParameters);
+
+        EXPECT_LT(tuner.meanSquaredError(tunedParameters, scalingConstant),
+                  tuner.meanSquaredError(initialParameters, scalingConstant));
+        EXPECT_GT(tunedParameters[TexelParameters::materialIndex(Figure::WhiteKnight)],
+                  initialParameters[TexelParameters::materialIndex(Figure::WhiteKnight)]);
+        EXPECT_NE(log.str().find("epoch 50"), std::string::npos);
+    }
+
+    TEST(TexelTunerTest, HeaderContainsTheRoundedParameters)
+    {
+        TexelParameters parameters = TexelParameters::fromEvaluation();
+        // The queen is worth less than a rook, so a rook captures a queen last
+        parameters[TexelParameters::materialIndex(Figure::WhiteQueen)] = 400.4;
+
+        std::ostringstream header;
+        parameters.writeHeader(header);
+
+        EXPECT_NE(header.str().find("        400, // white queen\n"), std::string::npos);
+        EXPECT_NE(header.str().find("        -400, // black queen\n"), std::string::npos);
+        // Rows of the rook and the queen as attacker
+        EXPECT_NE(header.str().find("{101, 201, 301, 501, 401, 601,  101, 201, 301, 501, 401, 601},\n"
+                                    "        {102, 202, 302, 502, 402, 602,  102, 202, 302, 502, 402, 602}"), std::string::npos);
+    }
+}
\ No newline at end of file
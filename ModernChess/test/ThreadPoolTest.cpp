@@ -0,0 +1,130 @@
+#include "ModernChess/ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+using namespace ModernChess;
+
+namespace
+{
+    uint64_t fibonacci(ThreadPool &threadPool, uint32_t number)
+    {
+        if (number < 2)
+        {
+            return number;
+        }
+
+        uint64_t first = 0;
+        TaskGroup taskGroup(threadPool);
+        taskGroup.run([&] { first = fibonacci(threadPool, number - 1); });
+        const uint64_t second = fibonacci(threadPool, number - 2);
+        taskGroup.wait();
+
+        return first + second;
+    }
+
+    TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce)
+    {
+        ThreadPool threadPool(4);
+        std::vector<std::atomic<uint32_t>> visits(1000);
+
+        threadPool.parallelFor(0, visits.size(), [&](size_t index) { ++visits[index]; });
+
+        for (const std::atomic<uint32_t> &numberOfVisits : visits)
+        {
+            EXPECT_EQ(numberOfVisits, 1);
+        }
+
+        // Empty ranges and ranges smaller than the grain size are valid
+        threadPool.parallelFor(5, 5, [&](size_t index) { ++visits[index]; });
+        threadPool.parallelFor(0, 3, [&](size_t index) { ++visits[index]; }, 16);
+        EXPECT_EQ(visits[5], 1);
+        EXPECT_EQ(visits[2], 2);
+    }
+
+    TEST(ThreadPoolTest, NestedTaskGroupsDoNotDeadlock)
+    {
+        // Every worker waits for its children, so a blocking wait would deadlock with only two workers
+        ThreadPool threadPool(2);
+        uint64_t result = 0;
+
+        TaskGroup taskGroup(threadPool);
+        taskGroup.run([&] { result = fibonacci(threadPool, 18); });
+        taskGroup.wait();
+
+        EXPECT_EQ(result, 2584);
+    }
+
+    TEST(ThreadPoolTest, WaitRethrowsTheExceptionOfATask)
+    {
+        ThreadPool threadPool(2);
+        std::atomic<uint32_t> numberOfExecutedTasks{0};
+
+        TaskGroup taskGroup(threadPool);
+        taskGroup.run([] { throw std::runtime_error("task failed"); });
+
+        for (uint32_t taskIndex = 0; taskIndex < 10; ++taskIndex)
+        {
+            taskGroup.run([&] { ++numberOfExecutedTasks; });
+        }
+
+        EXPECT_THROW(taskGroup.wait(), std::runtime_error);
+        EXPECT_EQ(numberOfExecutedTasks, 10);
+
+        // The exception is thrown only once
+        EXPECT_NO_THROW(taskGroup.wait());
+    }
+
+    TEST(ThreadPoolTest, WorkersHaveIndices)
+    {
+        ThreadPool threadPool(4);
+        EXPECT_EQ(threadPool.numberOfThreads(), 4);
+        EXPECT_EQ(threadPool.currentWorkerIndex(), ThreadPool::NoWorker);
+
+        std::mutex mutex;
+        std::set<uint32_t> workerIndices;
+
+        threadPool.parallelFor(0, 64, [&](size_t) {
+            const uint32_t workerIndex = threadPool.currentWorkerIndex();
+            ASSERT_LT(workerIndex, threadPool.numberOfThreads());
+
+            // Keeps the worker busy, so the other workers steal the remaining indices
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+            const std::scoped_lock lock{mutex};
+            workerIndices.insert(workerIndex);
+        });
+
+        EXPECT_GT(workerIndices.size(), 1);
+
+        // A worker of another pool is no worker of this pool
+        ThreadPool otherThreadPool(1);
+        uint32_t workerIndexInOtherPool = 0;
+        TaskGroup taskGroup(otherThreadPool);
+        taskGroup.run([&] { workerIndexInOtherPool = threadPool.currentWorkerIndex(); });
+        taskGroup.wait();
+        EXPECT_EQ(workerIndexInOtherPool, ThreadPool::NoWorker);
+    }
+
+    TEST(ThreadPoolTest, DestructorExecutesSubmittedTasks)
+    {
+        std::atomic<uint32_t> numberOfExecutedTasks{0};
+
+        {
+            ThreadPool threadPool(2, true);
+
+            for (uint32_t taskIndex = 0; taskIndex < 100; ++taskIndex)
+            {
+                threadPool.submit([&] { ++numberOfExecutedTasks; });
+            }
+        }
+
+        EXPECT_EQ(numberOfExecutedTasks, 100);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "ModernChess/TranspositionTable.h"
+
+#include <gtest/gtest.h>
+
+using namespace ModernChess;
+
+namespace {
+    TEST(TranspositionTableTest, HashfullIsSampledInPermille)
+    {
+        TranspositionTable transpositionTable;
+        transpositionTable.clear();
+
+        EXPECT_EQ(transpositionTable.hashfull(), 0);
+
+        // The first entries of the table are sampled
+        for (uint64_t hash = 1; hash <= 500; ++hash)
+        {
+            transpositionTable.addEntry(hash, HashFlag::Exact, 0, 1);
+        }
+
+        EXPECT_EQ(transpositionTable.hashfull(), 500);
+        EXPECT_TRUE(transpositionTable.contains(250));
+
+        // Only the entries of the current search are counted
+        transpositionTable.newSearch();
+        EXPECT_EQ(transpositionTable.hashfull(), 0);
+        EXPECT_TRUE(transpositionTable.contains(250));
+
+        transpositionTable.clear();
+
+        EXPECT_EQ(transpositionTable.hashfull(), 0);
+        EXPECT_FALSE(transpositionTable.contains(250));
+    }
+
+    TEST(TranspositionTableTest, ResizedTableIsEmpty)
+    {
+        TranspositionTable transpositionTable;
+        transpositionTable.addEntry(42, HashFlag::Exact, 10, 3);
+        EXPECT_TRUE(transpositionTable.contains(42));
+
+        transpositionTable.resize(1);
+
+        EXPECT_FALSE(transpositionTable.contains(42));
+        EXPECT_EQ(transpositionTable.hashfull(), 0);
+
+        transpositionTable.addEntry(42, HashFlag::Exact, 10, 3);
+        EXPECT_EQ(transpositionTable.getScore(42, -100, 100, 3), 10);
+    }
+
+    TEST(TranspositionTableTest, FailedResizeKeepsPreviousSize)
+    {
+        TranspositionTable transpositionTable(2);
+
+        // One exbibyte cannot be allocated
+        EXPECT_FALSE(transpositionTable.resize(size_t(1) << 40));
+        EXPECT_EQ(transpositionTable.sizeInMB(), 2);
+
+        transpositionTable.addEntry(42, HashFlag::Exact, 10, 3);
+        EXPECT_EQ(transpositionTable.getScore(42, -100, 100, 3), 10);
+
+        EXPECT_TRUE(transpositionTable.resize(1));
+        EXPECT_EQ(transpositionTable.sizeInMB(), 1);
+    }
+
+    TEST(TranspositionTableTest, ShallowEntriesDoNotReplaceDeepOnes)
+    {
+        // A single bucket, so all positions collide
+        TranspositionTable transpositionTable(0);
+
+        transpositionTable.addEntry(1, HashFlag::Exact, 10, 5);
+        // e.g. entries of the quiescence search
+        transpositionTable.addEntry(2, HashFlag::Exact, 20, 0);
+        transpositionTable.addEntry(3, HashFlag::Exact, 30, 0);
+
+        EXPECT_EQ(transpositionTable.getScore(1, -100, 100, 5), 10);
+        EXPECT_FALSE(transpositionTable.contains(2));
+        EXPECT_EQ(transpositionTable.getScore(3, -100, 100, 0), 30);
+
+        transpositionTable.addEntry(4, HashFlag::Exact, 40, 5);
+
+        EXPECT_FALSE(transpositionTable.contains(1));
+        EXPECT_EQ(transpositionTable.getScore(4, -100, 100, 5), 40);
+        EXPECT_EQ(transpositionTable.getScore(3, -100, 100, 0), 30);
+    }
+
+    TEST(TranspositionTableTest, EntriesOfNewSearchesReplaceDeepOnes)
+    {
+        // A single bucket, so all positions collide
+        TranspositionTable transpositionTable(0);
+
+        transpositionTable.addEntry(1, HashFlag::Exact, 10, 8);
+        transpositionTable.newSearch();
+        transpositionTable.addEntry(2, HashFlag::Exact, 20, 2);
+        transpositionTable.addEntry(3, HashFlag::Exact, 30, 1);
+
+        EXPECT_FALSE(transpositionTable.contains(1));
+        EXPECT_EQ(transpositionTable.getScore(2, -100, 100, 2), 20);
+        EXPECT_EQ(transpositionTable.getScore(3, -100, 100, 1), 30);
+    }
+}
\ No newline at end of file
@@ -1,9 +1,14 @@
 #include "TestingPositions.h"
 #include "ModernChess/UCICommunication.h"
+#include "ModernChess/BatchAnalysis.h"
 #include "ModernChess/FenParsing.h"
+#include "ModernChess/SelfPlay.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
 #include <thread>
 
@@ -18,7 +23,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&]{
             uciCom.startCommunication();
@@ -43,7 +49,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&]{
             uciCom.startCommunication();
@@ -67,7 +74,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&]{
             uciCom.startCommunication();
@@ -94,7 +102,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&]{
             uciCom.startCommunication();
@@ -125,7 +134,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&]{
             uciCom.startCommunication();
@@ -154,7 +164,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&]{
             uciCom.startCommunication();
@@ -174,7 +185,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&]{
             uciCom.startCommunication();
@@ -206,7 +218,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&uciCom]{
             uciCom.startCommunication();
@@ -244,7 +257,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&uciCom]{
             uciCom.startCommunication();
@@ -253,7 +267,7 @@ namespace
         constexpr auto fenString = "r3r1k1/2p1qpPp/p4n1Q/4p1N1/1n1pP1b1/pP1P4/P1P2PP1/2KR1B1R w - - 5 18";
 
         inputStream << "position fen " << fenString << "\n";
-        inputStream << "go depth 6\n" << std::flush;
+        inputStream << "go depth 9\n" << std::flush;
         std::this_thread::sleep_for(2s);
         inputStream << "quit\n" << std::flush;
         communicationThread.join();
@@ -282,7 +296,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&uciCom]{
             uciCom.startCommunication();
@@ -322,7 +337,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&uciCom]{
             uciCom.startCommunication();
@@ -360,21 +376,35 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
+
+        inputStream << "position startpos moves\n";
+        inputStream << "go infinite\n" << std::flush;
 
         std::thread communicationThread([&uciCom]{
             uciCom.startCommunication();
         });
 
-        inputStream << "position startpos moves\n";
-        inputStream << "go infinite\n" << std::flush;
         std::this_thread::sleep_for(3s);
         inputStream << "quit\n" << std::flush;
         communicationThread.join();
 
         const std::string engineOutput{outputStream.str()};
-
-        EXPECT_TRUE(engineOutput.find("bestmove d2d4") != std::string::npos);
+        const size_t bestMovePosition = engineOutput.find("bestmove ");
+        ASSERT_NE(bestMovePosition, std::string::npos);
+
+        // The best move depends on how deep the search gets in the given time, so any legal move is accepted
+        std::istringstream bestMoveStream(engineOutput.substr(bestMovePosition + std::string_view("bestmove ").size()));
+        std::string bestMove;
+        bestMoveStream >> bestMove;
+
+        const std::vector<Move> legalMoves = SelfPlay::generateLegalMoves(FenParsing::FenParser(FenParsing::startPosition).parse());
+        EXPECT_TRUE(std::any_of(legalMoves.begin(), legalMoves.end(), [&bestMove](Move move) {
+            std::ostringstream moveStream;
+            moveStream << move;
+            return moveStream.str() == bestMove;
+        })) << bestMove;
         std::cout << engineOutput << std::endl;
 
         std::cout << uciCom.getGameState() << std::endl;
@@ -398,7 +428,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&uciCom]{
             uciCom.startCommunication();
@@ -436,7 +467,8 @@ namespace
         std::stringstream outputStream;
         std::stringstream errorStream;
 
-        UCICommunication uciCom(inputStream, outputStream, errorStream);
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
 
         std::thread communicationThread([&uciCom]{
             uciCom.startCommunication();
@@ -455,4 +487,152 @@ namespace
 
         std::cout << uciCom.getGameState() << std::endl;
     }
+
+    TEST(UCICommunicationTest, PonderHit)
+    {
+        std::stringstream inputStream;
+        std::stringstream outputStream;
+        std::stringstream errorStream;
+
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
+
+        inputStream << "position startpos moves e2e4 e7e5\n";
+        inputStream << "go ponder movetime 500\n" << std::flush;
+
+        std::thread communicationThread([&uciCom]{
+            uciCom.startCommunication();
+        });
+
+        // pondering has no time limit
+        std::this_thread::sleep_for(1s);
+        inputStream << "ponderhit\n" << std::flush;
+        std::this_thread::sleep_for(2s);
+        inputStream << "quit\n" << std::flush;
+        communicationThread.join();
+
+        const std::string engineOutput{outputStream.str()};
+
+        EXPECT_TRUE(engineOutput.find("bestmove") != std::string::npos);
+        EXPECT_TRUE(engineOutput.find(" ponder ") != std::string::npos);
+        std::cout << engineOutput << std::endl;
+    }
+
+    TEST(UCICommunicationTest, StopPondering)
+    {
+        std::stringstream inputStream;
+        std::stringstream outputStream;
+        std::stringstream errorStream;
+
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
+
+        inputStream << "position startpos\n";
+        inputStream << "go ponder depth 2\n" << std::flush;
+
+        std::thread communicationThread([&uciCom]{
+            uciCom.startCommunication();
+        });
+
+        std::this_thread::sleep_for(1s);
+        inputStream << "stop\n" << std::flush;
+        std::this_thread::sleep_for(1s);
+        inputStream << "quit\n" << std::flush;
+        communicationThread.join();
+
+        const std::string engineOutput{outputStream.str()};
+
+        EXPECT_TRUE(engineOutput.find("bestmove") != std::string::npos);
+        std::cout << engineOutput << std::endl;
+    }
+
+    /**
+     * @brief Input of the engine, which waits for the next line like std::cin instead of reporting the end of the stream,
+     *        so lines can be added while the engine reads.
+     */
+    class BlockingInputBuffer : public std::streambuf
+    {
+    public:
+        void addLine(const std::string &line)
+        {
+            const std::lock_guard lock(m_mutex);
+            m_pendingInput += line + "\n";
+            m_inputAvailable.notify_one();
+        }
+
+    protected:
+        int_type underflow() override
+        {
+            std::unique_lock lock(m_mutex);
+            m_inputAvailable.wait(lock, [this]{ return not m_pendingInput.empty(); });
+            m_currentInput = std::move(m_pendingInput);
+            m_pendingInput.clear();
+            setg(m_currentInput.data(), m_currentInput.data(), m_currentInput.data() + m_currentInput.size());
+
+            return traits_type::to_int_type(*gptr());
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_inputAvailable;
+        std::string m_pendingInput;
+        std::string m_currentInput;
+    };
+
+    TEST(UCICommunicationTest, NodeLimitReportsLastCompletedDepth)
+    {
+        BlockingInputBuffer inputBuffer;
+        std::istream inputStream(&inputBuffer);
+        std::stringstream outputStream;
+        std::stringstream errorStream;
+
+        SearchContext searchContext;
+        UCICommunication uciCom(inputStream, outputStream, errorStream, searchContext);
+
+        std::thread communicationThread([&uciCom]{
+            uciCom.startCommunication();
+        });
+
+        inputBuffer.addLine("position startpos");
+        inputBuffer.addLine("go depth 10 nodes 20000");
+        // the node limit stops the search long before the quit command arrives
+        std::this_thread::sleep_for(2s);
+        inputBuffer.addLine("quit");
+        communicationThread.join();
+
+        const std::string engineOutput{outputStream.str()};
+        std::cout << engineOutput << std::endl;
+
+        // The batch analysis has to find the same move at the same depth for the same limits
+        BatchAnalysisLimits limits;
+        limits.depth = 10;
+        limits.nodes = 20000;
+
+        BatchAnalysis batchAnalysis(1);
+        batchAnalysis.setLimits(limits);
+
+        std::istringstream batchInput(std::string(FenParsing::startPosition) + "\n");
+        std::ostringstream batchOutput;
+        static_cast<void>(batchAnalysis.run(batchInput, batchOutput));
+
+        const std::string batchLine{batchOutput.str()};
+        std::cout << batchLine << std::endl;
+
+        const auto tokenAfter = [](const std::string &text, const std::string &key) {
+            const size_t begin = text.rfind(key);
+
+            if (begin == std::string::npos)
+            {
+                return std::string{};
+            }
+
+            const size_t tokenBegin = begin + key.size();
+            return text.substr(tokenBegin, text.find_first_of(" \n", tokenBegin) - tokenBegin);
+        };
+
+        const std::string batchDepth = tokenAfter(batchLine, " depth ");
+        ASSERT_FALSE(batchDepth.empty());
+        EXPECT_EQ(tokenAfter(engineOutput, "bestmove "), tokenAfter(batchLine, "bestmove "));
+        EXPECT_EQ(tokenAfter(engineOutput, " depth "), batchDepth);
+    }
 }
\ No newline at end of file
@@ -90,4 +90,135 @@ namespace {
         UCIParser parser("movestogo");
         EXPECT_TRUE(parser.uiHasSentMovesToGo());
     }
+
+    TEST(UCIParserTest, sendMultiPVOption)
+    {
+        UCIParser parser("setoption name MultiPV value 3");
+        EXPECT_TRUE(parser.uiHasSentSetOption());
+        EXPECT_TRUE(parser.uiHasSentOptionName());
+        EXPECT_TRUE(parser.uiHasSentMultiPVOption());
+        EXPECT_TRUE(parser.uiHasSentOptionValue());
+        EXPECT_EQ(parser.parseNumber<uint32_t>(), 3);
+    }
+
+    TEST(UCIParserTest, optionNamesAreCaseInsensitiveWholeNames)
+    {
+        UCIParser parser("setoption name multipv value 3");
+        EXPECT_TRUE(parser.uiHasSentSetOption());
+        EXPECT_TRUE(parser.uiHasSentOptionName());
+        EXPECT_TRUE(parser.uiHasSentMultiPVOption());
+        EXPECT_TRUE(parser.uiHasSentOptionValue());
+        EXPECT_EQ(parser.parseNumber<uint32_t>(), 3);
+
+        UCIParser clearParser("setoption name CLEAR HASH");
+        EXPECT_TRUE(clearParser.uiHasSentSetOption());
+        EXPECT_TRUE(clearParser.uiHasSentOptionName());
+        EXPECT_TRUE(clearParser.uiHasSentClearHashOption());
+
+        UCIParser longerNameParser("setoption name Hashfoo value 64");
+        EXPECT_TRUE(longerNameParser.uiHasSentSetOption());
+        EXPECT_TRUE(longerNameParser.uiHasSentOptionName());
+        EXPECT_FALSE(longerNameParser.uiHasSentHashOption());
+    }
+
+    TEST(UCIParserTest, sendGoWithNodes)
+    {
+        UCIParser parser("go nodes 100000");
+        EXPECT_TRUE(parser.uiHasSentGoCommand());
+        EXPECT_TRUE(parser.uiHasSentNodes());
+        EXPECT_EQ(parser.parseNumber<uint64_t>(), 100000);
+    }
+
+    TEST(UCIParserTest, sendDeterministicOption)
+    {
+        UCIParser parser("setoption name Deterministic value true");
+        EXPECT_TRUE(parser.uiHasSentSetOption());
+        EXPECT_TRUE(parser.uiHasSentOptionName());
+        EXPECT_TRUE(parser.uiHasSentDeterministicOption());
+        EXPECT_TRUE(parser.uiHasSentOptionValue());
+        EXPECT_TRUE(parser.uiHasSentTrueValue());
+    }
+
+    TEST(UCIParserTest, sendHashOptions)
+    {
+        UCIParser parser("setoption name Hash value 1024");
+        EXPECT_TRUE(parser.uiHasSentSetOption());
+        EXPECT_TRUE(parser.uiHasSentOptionName());
+        EXPECT_FALSE(parser.uiHasSentClearHashOption());
+        EXPECT_TRUE(parser.uiHasSentHashOption());
+        EXPECT_TRUE(parser.uiHasSentOptionValue());
+        EXPECT_EQ(parser.parseNumber<size_t>(), 1024);
+
+        UCIParser clearParser("setoption name Clear Hash");
+        EXPECT_TRUE(clearParser.uiHasSentSetOption());
+        EXPECT_TRUE(clearParser.uiHasSentOptionName());
+        EXPECT_FALSE(clearParser.uiHasSentHashOption());
+        EXPECT_TRUE(clearParser.uiHasSentClearHashOption());
+    }
+
+    TEST(UCIParserTest, sendThreadsOption)
+    {
+        UCIParser parser("setoption name Threads value 64");
+        EXPECT_TRUE(parser.uiHasSentSetOption());
+        EXPECT_TRUE(parser.uiHasSentOptionName());
+        EXPECT_TRUE(parser.uiHasSentThreadsOption());
+        EXPECT_TRUE(parser.uiHasSentOptionValue());
+        EXPECT_EQ(parser.parseNumber<uint32_t>(), 64);
+    }
+
+    TEST(UCIParserTest, sendBookOptions)
+    {
+        UCIParser parser("setoption name OwnBook value true");
+        EXPECT_TRUE(parser.uiHasSentSetOption());
+        EXPECT_TRUE(parser.uiHasSentOptionName());
+        EXPECT_FALSE(parser.uiHasSentBookFileOption());
+        EXPECT_TRUE(parser.uiHasSentOwnBookOption());
+        EXPECT_TRUE(parser.uiHasSentOptionValue());
+        EXPECT_TRUE(parser.uiHasSentTrueValue());
+
+        UCIParser fileParser("setoption name BookFile value /books/my book.bin");
+        EXPECT_TRUE(fileParser.uiHasSentSetOption());
+        EXPECT_TRUE(fileParser.uiHasSentOptionName());
+        EXPECT_FALSE(fileParser.uiHasSentOwnBookOption());
+        EXPECT_TRUE(fileParser.uiHasSentBookFileOption());
+        EXPECT_TRUE(fileParser.uiHasSentOptionValue());
+        EXPECT_EQ(fileParser.currentStringView(), "/books/my book.bin");
+    }
+
+    TEST(UCIParserTest, sendSearchParameterOption)
+    {
+        UCIParser parser("setoption name NullMovePruningDepthReduction value 3");
+        EXPECT_TRUE(parser.uiHasSentSetOption());
+        EXPECT_TRUE(parser.uiHasSentOptionName());
+
+        const TunableSearchParameter *parameter = parser.uiHasSentSearchParameterOption();
+        ASSERT_NE(parameter, nullptr);
+        EXPECT_EQ(parameter->value, &SearchParameters::nullMovePruningDepthReduction);
+        EXPECT_TRUE(parser.uiHasSentOptionValue());
+        EXPECT_EQ(parser.parseNumber<int32_t>(), 3);
+
+        UCIParser unknownParser("setoption name Threads value 64");
+        EXPECT_TRUE(unknownParser.uiHasSentSetOption());
+        EXPECT_TRUE(unknownParser.uiHasSentOptionName());
+        EXPECT_EQ(unknownParser.uiHasSentSearchParameterOption(), nullptr);
+    }
+
+    TEST(UCIParserTest, sendDebugCommand)
+    {
+        UCIParser parser("debug on");
+        EXPECT_TRUE(parser.uiHasSentDebugCommand());
+        EXPECT_TRUE(parser.uiHasSentOnValue());
+
+        UCIParser offParser("debug off");
+        EXPECT_TRUE(offParser.uiHasSentDebugCommand());
+        EXPECT_FALSE(offParser.uiHasSentOnValue());
+    }
+
+    TEST(UCIParserTest, sendBenchCommand)
+    {
+        UCIParser parser("bench 5");
+        EXPECT_TRUE(parser.uiHasSentBenchCommand());
+        EXPECT_FALSE(parser.isAtEndOfString());
+        EXPECT_EQ(parser.parseNumber<uint32_t>(), 5);
+    }
 }
\ No newline at end of file
@@ -14,12 +14,12 @@ namespace
         const GameState gameState = fenParser.parse();
 
         // Just checking for portability reasons if hashing is on all platforms the same
-        EXPECT_EQ(gameState.gameStateHash, 0xed1ef6942fb0f13e);
+        EXPECT_EQ(gameState.gameStateHash, 0x57561bedaa5346e0);
 
-        EXPECT_EQ(ZobristHasher::pieceKeys[11][63], uint64_t(17590421507200302306UL));
-        EXPECT_EQ(ZobristHasher::castleKeys[0], uint64_t(14599039209436570616UL));
-        EXPECT_EQ(ZobristHasher::castleKeys[15], uint64_t(12093051889040103024UL));
-        EXPECT_EQ(ZobristHasher::sideKey, uint64_t(1772028295636336235UL));
+        EXPECT_EQ(ZobristHasher::pieceKeys[11][63], uint64_t(3452471826952569846UL));
+        EXPECT_EQ(ZobristHasher::castleKeys[0], uint64_t(6428209151850780823UL));
+        EXPECT_EQ(ZobristHasher::castleKeys[15], uint64_t(9348378043848878893UL));
+        EXPECT_EQ(ZobristHasher::sideKey, uint64_t(8552698590318682040UL));
 
         std::cout << gameState;
     }